@@ -0,0 +1,48 @@
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "alloc_counter.h"
+
+#ifdef ALLOC_COUNTER
+static atomic_llong alloc_calls;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+int __real_posix_memalign(void **ptr, size_t alignment, size_t size);
+
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t count, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+int __wrap_posix_memalign(void **ptr, size_t alignment, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    atomic_fetch_add_explicit(&alloc_calls, 1, memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    atomic_fetch_add_explicit(&alloc_calls, 1, memory_order_relaxed);
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    atomic_fetch_add_explicit(&alloc_calls, 1, memory_order_relaxed);
+    return __real_realloc(ptr, size);
+}
+
+int __wrap_posix_memalign(void **ptr, size_t alignment, size_t size) {
+    atomic_fetch_add_explicit(&alloc_calls, 1, memory_order_relaxed);
+    return __real_posix_memalign(ptr, alignment, size);
+}
+
+long long alloc_count(void) {
+    return atomic_load_explicit(&alloc_calls, memory_order_relaxed);
+}
+
+#else
+
+long long alloc_count(void) {
+    return -1;
+}
+
+#endif // ALLOC_COUNTER
@@ -0,0 +1,13 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+// Счетчик обращений к куче. Только в проверочной сборке (make check или
+// make ALLOC_COUNT=1): она определяет ALLOC_COUNTER и компонуется с
+// -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=posix_memalign
+// (переменная ALLOC_WRAP в Makefile), и вызовы этих функций из объектов
+// программы проходят через обертки, увеличивающие счетчик. Разность
+// alloc_count до и после участка - число выделений на нем (во всех потоках).
+// В обычной сборке обертки не подключаются и alloc_count возвращает -1.
+long long alloc_count(void);
+
+#endif // ALLOC_COUNTER_H
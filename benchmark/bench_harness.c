@@ -0,0 +1,345 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench_harness.h"
+#include "../filters/fir_filter.h"
+#include "../filters/dsp_dispatch.h"
+#include "../filters/fft_fir_filter.h"
+#include "../filters/iir_filter.h"
+#include "../filters/lms_filter.h"
+#include "../filters/rls_filter.h"
+#include "../signal_generator/rng.h"
+
+#define BENCH_RLS_MAX_TAPS 64  // классический RLS: O(N^2) на отсчет
+#define BENCH_LATTICE_MAX_TAPS 256 // решетка: около 17 нс на звено, 1024 звена - секунда на прогон
+#define BENCH_ALLPASS_A1 -0.6f // всепропускающая секция IIR: |H| = 1, сигнал
+#define BENCH_ALLPASS_A2 0.2f  // не растет и не затухает до денормалов
+#define BENCH_RLS_LAMBDA 0.99f
+#define BENCH_RLS_DELTA 0.01f
+
+typedef union {
+    fir_filter fir;
+    fft_fir_filter fft;
+    iir_filter iir;
+    lms_filter lms;
+    rls_filter rls;
+} bench_state;
+
+// Операции ядра: выбор ядра делается один раз до замера, в цикле по
+// блокам - только вызов через указатель
+typedef struct {
+    const char* name;
+    int max_taps;              // 0 - без ограничения
+    int (*init)(bench_state* state, const float* coeffs, int taps);
+    void (*process)(bench_state* state, const float* in, const float* desired,
+                    float* out, int n);
+    void (*release)(bench_state* state);
+} bench_kernel_ops;
+
+static int fir_init(bench_state* s, const float* coeffs, int taps) {
+    return fir_filter_init(&s->fir, coeffs, taps);
+}
+
+static void fir_run(bench_state* s, const float* in, const float* desired, float* out, int n) {
+    (void)desired;
+    fir_filter_process_block(&s->fir, in, out, n);
+}
+
+static int fir_generic_init(bench_state* s, const float* coeffs, int taps) {
+    return fir_filter_init_mode(&s->fir, coeffs, taps, FIR_KERNEL_GENERIC);
+}
+
+static void fir_release(bench_state* s) {
+    fir_filter_free(&s->fir);
+}
+
+static int fft_init(bench_state* s, const float* coeffs, int taps) {
+    return fft_fir_filter_init_mode(&s->fft, coeffs, taps, 0, FFT_FIR_FFT);
+}
+
+static void fft_run(bench_state* s, const float* in, const float* desired, float* out, int n) {
+    (void)desired;
+    fft_fir_filter_process_block(&s->fft, in, out, n);
+}
+
+static void fft_release(bench_state* s) {
+    fft_fir_filter_free(&s->fft);
+}
+
+static int iir_init(bench_state* s, const float* coeffs, int taps) {
+    (void)coeffs;
+    int sections = (taps + 1) / 2;
+    float* sos = malloc(sections * 6 * sizeof(float));
+    if (!sos) {
+        return -1;
+    }
+    for (int i = 0; i < sections; i++) {
+        float* row = sos + i * 6;
+        row[0] = BENCH_ALLPASS_A2;
+        row[1] = BENCH_ALLPASS_A1;
+        row[2] = 1.0f;
+        row[3] = 1.0f;
+        row[4] = BENCH_ALLPASS_A1;
+        row[5] = BENCH_ALLPASS_A2;
+    }
+    int status = iir_filter_init_sos(&s->iir, sos, sections);
+    free(sos);
+    return status;
+}
+
+static void iir_run(bench_state* s, const float* in, const float* desired, float* out, int n) {
+    (void)desired;
+    iir_filter_process_block(&s->iir, in, out, n);
+}
+
+static void iir_release(bench_state* s) {
+    iir_filter_free(&s->iir);
+}
+
+static int lms_init(bench_state* s, const float* coeffs, int taps) {
+    (void)coeffs;
+    // mu * N * E[x^2] = 0.25 при равномерном входе на [-0.5, 0.5]
+    return lms_filter_init(&s->lms, taps, 3.0f / taps);
+}
+
+static void lms_run(bench_state* s, const float* in, const float* desired, float* out, int n) {
+    lms_filter_process_block(&s->lms, in, desired, out, n);
+}
+
+static void lms_release(bench_state* s) {
+    lms_filter_free(&s->lms);
+}
+
+static int rls_init(bench_state* s, const float* coeffs, int taps) {
+    (void)coeffs;
+    return rls_filter_init_mode(&s->rls, taps, BENCH_RLS_LAMBDA, BENCH_RLS_DELTA,
+                                RLS_MODE_STANDARD);
+}
+
+static int rls_lattice_init(bench_state* s, const float* coeffs, int taps) {
+    (void)coeffs;
+    return rls_filter_init_mode(&s->rls, taps, BENCH_RLS_LAMBDA, BENCH_RLS_DELTA,
+                                RLS_MODE_LATTICE);
+}
+
+static void rls_run(bench_state* s, const float* in, const float* desired, float* out, int n) {
+    rls_filter_process_block(&s->rls, in, desired, out, n);
+}
+
+static void rls_release(bench_state* s) {
+    rls_filter_free(&s->rls);
+}
+
+static const bench_kernel_ops bench_kernels[BENCH_KERNEL_COUNT] = {
+    {"fir", 0, fir_init, fir_run, fir_release},
+    {"fir_generic", 0, fir_generic_init, fir_run, fir_release},
+    {"fft_fir", 0, fft_init, fft_run, fft_release},
+    {"iir", 0, iir_init, iir_run, iir_release},
+    {"lms", 0, lms_init, lms_run, lms_release},
+    {"rls", BENCH_RLS_MAX_TAPS, rls_init, rls_run, rls_release},
+    {"rls_lattice", BENCH_LATTICE_MAX_TAPS, rls_lattice_init, rls_run, rls_release}
+};
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+double bench_elapsed(uint64_t start) {
+    return (bench_now_ns() - start) * 1e-9;
+}
+
+const char* bench_kernel_name(bench_kernel kernel) {
+    return (kernel >= 0 && kernel < BENCH_KERNEL_COUNT) ? bench_kernels[kernel].name : "?";
+}
+
+int bench_parse_kernels(const char* list, unsigned* mask) {
+    *mask = 0;
+    while (list && *list) {
+        const char* end = strchr(list, ',');
+        size_t len = end ? (size_t)(end - list) : strlen(list);
+        int found = 0;
+        for (int k = 0; k < BENCH_KERNEL_COUNT; k++) {
+            if (strlen(bench_kernels[k].name) == len && strncmp(list, bench_kernels[k].name, len) == 0) {
+                *mask |= 1u << k;
+                found = 1;
+                break;
+            }
+        }
+        if (!found) {
+            return -1;
+        }
+        list = end ? end + 1 : NULL;
+    }
+    return *mask ? 0 : -1;
+}
+
+int bench_parse_list(const char* list, int* values, int max_values) {
+    int count = 0;
+    while (list && *list) {
+        char* end;
+        long value = strtol(list, &end, 10);
+        if (end == list || value <= 0 || value > (1 << 24) || (*end != ',' && *end != '\0') ||
+            count >= max_values) {
+            return -1;
+        }
+        values[count++] = (int)value;
+        list = *end ? end + 1 : NULL;
+    }
+    return count > 0 ? count : -1;
+}
+
+static int bench_compare(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Один прогон: samples отсчетов блоками по block, время в наносекундах
+static double bench_pass(const bench_kernel_ops* ops, bench_state* state, const float* in,
+                         const float* desired, float* out, int samples, int block) {
+    uint64_t start = bench_now_ns();
+    for (int offset = 0; offset < samples; offset += block) {
+        int n = (samples - offset < block) ? samples - offset : block;
+        ops->process(state, in + offset, desired + offset, out + offset, n);
+    }
+    return (double)(bench_now_ns() - start);
+}
+
+static int bench_measure(const bench_config* cfg, bench_kernel kernel, int taps, int block,
+                         const float* coeffs, const float* in, const float* desired, float* out,
+                         double* times, bench_result* result) {
+    const bench_kernel_ops* ops = &bench_kernels[kernel];
+    bench_state state;
+    if (ops->init(&state, coeffs, taps) != 0) {
+        return -2;
+    }
+    for (int r = 0; r < cfg->warmup; r++) {
+        bench_pass(ops, &state, in, desired, out, cfg->samples, block);
+    }
+    for (int r = 0; r < cfg->repetitions; r++) {
+        times[r] = bench_pass(ops, &state, in, desired, out, cfg->samples, block);
+    }
+    ops->release(&state);
+
+    qsort(times, cfg->repetitions, sizeof(double), bench_compare);
+    int n = cfg->repetitions;
+    // Процентиль по ближайшему рангу: ceil(0.99 * n) - 1
+    int p99 = (99 * n + 99) / 100 - 1;
+    double median = (n % 2) ? times[n / 2] : 0.5 * (times[n / 2 - 1] + times[n / 2]);
+
+    result->kernel = kernel;
+    result->taps = taps;
+    result->block = block;
+    result->samples = cfg->samples;
+    result->repetitions = n;
+    result->min_ns = times[0] / cfg->samples;
+    result->median_ns = median / cfg->samples;
+    result->p99_ns = times[p99] / cfg->samples;
+    result->msps = result->median_ns > 0.0 ? 1e3 / result->median_ns : 0.0;
+    return 0;
+}
+
+int bench_run(const bench_config* config, bench_result* results, int max_results) {
+    if (!config || !results || !config->taps || !config->blocks || config->num_taps <= 0 ||
+        config->num_blocks <= 0 || config->samples <= 0 || config->warmup < 0 ||
+        config->repetitions <= 0) {
+        return -1;
+    }
+
+    int max_taps = 0;
+    for (int i = 0; i < config->num_taps; i++) {
+        if (config->taps[i] <= 0) return -1;
+        if (config->taps[i] > max_taps) max_taps = config->taps[i];
+    }
+    for (int i = 0; i < config->num_blocks; i++) {
+        if (config->blocks[i] <= 0) return -1;
+    }
+
+    float* coeffs = malloc(max_taps * sizeof(float));
+    float* in = malloc(config->samples * sizeof(float));
+    float* desired = malloc(config->samples * sizeof(float));
+    float* out = malloc(config->samples * sizeof(float));
+    double* times = malloc(config->repetitions * sizeof(double));
+    if (!coeffs || !in || !desired || !out || !times) {
+        free(coeffs);
+        free(in);
+        free(desired);
+        free(out);
+        free(times);
+        return -2;
+    }
+
+    // Вход - равномерный шум; опорный сигнал адаптивных фильтров - короткий
+    // КИХ от входа с малым шумом, чтобы задача идентификации была корректной
+    rng_state rng;
+    rng_init(&rng, config->seed);
+    for (int i = 0; i < max_taps; i++) coeffs[i] = (rng_uniform(&rng) - 0.5f) / max_taps;
+    for (int i = 0; i < config->samples; i++) in[i] = rng_uniform(&rng) - 0.5f;
+    for (int i = 0; i < config->samples; i++) {
+        float prev = i > 0 ? in[i - 1] : 0.0f;
+        desired[i] = 0.5f * in[i] + 0.25f * prev + 1e-3f * (rng_uniform(&rng) - 0.5f);
+    }
+    // Первое касание страниц не должно попасть в замер
+    memset(out, 0, config->samples * sizeof(float));
+
+    int count = 0;
+    int status = 0;
+    for (int k = 0; k < BENCH_KERNEL_COUNT && status == 0; k++) {
+        if (!(config->kernels & (1u << k))) continue;
+        for (int t = 0; t < config->num_taps && status == 0; t++) {
+            int taps = config->taps[t];
+            if (bench_kernels[k].max_taps && taps > bench_kernels[k].max_taps) continue;
+            for (int b = 0; b < config->num_blocks && count < max_results; b++) {
+                status = bench_measure(config, (bench_kernel)k, taps, config->blocks[b], coeffs,
+                                       in, desired, out, times, &results[count]);
+                if (status != 0) break;
+                count++;
+            }
+        }
+    }
+
+    free(coeffs);
+    free(in);
+    free(desired);
+    free(out);
+    free(times);
+    return status != 0 ? status : count;
+}
+
+int bench_write(const char* path, const bench_result* results, int count) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        return -1;
+    }
+
+    size_t len = strlen(path);
+    int json = len >= 5 && strcmp(path + len - 5, ".json") == 0;
+    if (json) {
+        fprintf(f, "{\n  \"isa\": \"%s\",\n  \"results\": [\n", dsp_isa_name(dsp_dispatch_isa()));
+    } else {
+        fprintf(f, "kernel,taps,block,samples,repetitions,min_ns,median_ns,p99_ns,msps\n");
+    }
+    for (int i = 0; i < count; i++) {
+        const bench_result* r = &results[i];
+        if (json) {
+            fprintf(f, "    {\"kernel\": \"%s\", \"taps\": %d, \"block\": %d, \"samples\": %d, "
+                       "\"repetitions\": %d, \"min_ns\": %.4f, \"median_ns\": %.4f, "
+                       "\"p99_ns\": %.4f, \"msps\": %.3f}%s\n",
+                    bench_kernel_name(r->kernel), r->taps, r->block, r->samples, r->repetitions,
+                    r->min_ns, r->median_ns, r->p99_ns, r->msps, i + 1 < count ? "," : "");
+        } else {
+            fprintf(f, "%s,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.3f\n",
+                    bench_kernel_name(r->kernel), r->taps, r->block, r->samples, r->repetitions,
+                    r->min_ns, r->median_ns, r->p99_ns, r->msps);
+        }
+    }
+    if (json) {
+        fprintf(f, "  ]\n}\n");
+    }
+
+    int status = ferror(f) ? -2 : 0;
+    fclose(f);
+    return status;
+}
@@ -0,0 +1,70 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <stdint.h>
+
+// Замер ядер фильтров по отдельности: без модуляции, демодуляции и BER.
+// Для каждой комбинации (ядро, число отводов, размер блока) фильтр
+// прогревается warmup прогонами, затем repetitions прогонов по samples
+// отсчетов замеряются монотонными часами. Каждый прогон подает вход
+// блоками заданного размера; по прогонам считаются минимум, медиана и
+// 99-й процентиль времени на отсчет.
+
+typedef enum {
+    BENCH_KERNEL_FIR = 0,      // прямая свертка (fir_filter), ядро по длине
+    BENCH_KERNEL_FIR_GENERIC,  // прямая свертка, всегда общее ядро dsp_dot
+    BENCH_KERNEL_FFT_FIR,      // overlap-save (fft_fir_filter)
+    BENCH_KERNEL_IIR,          // каскад биквадов, порядок = число отводов
+    BENCH_KERNEL_LMS,
+    BENCH_KERNEL_RLS,          // классический RLS, O(N^2)
+    BENCH_KERNEL_RLS_LATTICE,  // решетчатый RLS, O(N)
+    BENCH_KERNEL_COUNT
+} bench_kernel;
+
+typedef struct {
+    unsigned kernels;          // маска (1u << bench_kernel)
+    const int* taps;           // сетка чисел отводов
+    int num_taps;
+    const int* blocks;         // сетка размеров блока
+    int num_blocks;
+    int samples;               // отсчетов за один прогон
+    int warmup;                // прогревочных прогонов
+    int repetitions;           // замеряемых прогонов
+    uint64_t seed;
+} bench_config;
+
+typedef struct {
+    bench_kernel kernel;
+    int taps;
+    int block;
+    int samples;
+    int repetitions;
+    double min_ns;             // нс на отсчет
+    double median_ns;
+    double p99_ns;
+    double msps;               // млн отсчетов/сек по медиане
+} bench_result;
+
+// Монотонное время в наносекундах и секунды, прошедшие с момента start
+uint64_t bench_now_ns(void);
+double bench_elapsed(uint64_t start);
+
+// Запуск по всем ядрам маски, числам отводов и размерам блока. Комбинации
+// с числом отводов больше предела ядра (оба варианта RLS) пропускаются.
+// Возвращает число записанных результатов (не больше max_results) или
+// отрицательный код ошибки.
+int bench_run(const bench_config* config, bench_result* results, int max_results);
+
+// Запись результатов: JSON, если путь оканчивается на .json, иначе CSV
+int bench_write(const char* path, const bench_result* results, int count);
+
+const char* bench_kernel_name(bench_kernel kernel);
+
+// Разбор списка ядер через запятую ("fir,iir") в маску
+int bench_parse_kernels(const char* list, unsigned* mask);
+
+// Разбор списка положительных чисел через запятую ("16,64,256").
+// Возвращает число значений или -1 при ошибке.
+int bench_parse_list(const char* list, int* values, int max_values);
+
+#endif // BENCH_HARNESS_H
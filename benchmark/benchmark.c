@@ -1,12 +1,36 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
 #include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include "../coeffs.h"
 #include "../filters/fir_filter.h"
+#include "../filters/fft_fir_filter.h"
+#include "../filters/ddc_filter.h"
 #include "../filters/iir_filter.h"
+#include "../filters/ciir_filter.h"
 #include "../filters/lms_filter.h"
+#include "../filters/fdaf_filter.h"
+#include "../filters/clms_filter.h"
+#include "../filters/crls_filter.h"
 #include "../filters/rls_filter.h"
+#include "../filters/filter_bank.h"
+#include "../filters/oscillator.h"
+#include "../filters/coeff_file.h"
+#include "../filters/filter_design.h"
+#include "../filters/fft.h"
+#include "../filters/fir_q15_filter.h"
+#include "../filters/iir_q15_filter.h"
+#include "../filters/dsp_stats.h"
+#include "../filters/dsp_dispatch.h"
 #include "../signal_generator/signal_generator.h"
+#include "../signal_generator/iq_file.h"
+#include "../pipeline/pipeline.h"
+#include "../pipeline/stage_chain.h"
+#include "ber_sweep.h"
+#include "bench_harness.h"
+#include "alloc_counter.h"
 
 // Конфигурация теста
 #define NUM_BITS 10000
@@ -19,26 +43,171 @@
 #define LMS_LENGTH 64     // Длина LMS фильтра
 #define RLS_LENGTH 64     // Длина RLS фильтра
 #define LMS_MU 0.01f      // Шаг адаптации для LMS
+#define LMS_LONG_LENGTH 2048 // Наибольшая длина сравнения с FDAF
+#define LMS_ID_SAMPLES (1 << 18) // Отсчетов проверки вариантов LMS
+#define LMS_ID_STEP 0.1f  // mu * длина * мощность входа в проверке вариантов
+#define LMS_ID_NOISE 0.01f // СКО шума опорного сигнала в проверке вариантов
+#define LMS_ID_TOLERANCE 1.5 // Допустимая установившаяся ошибка, в долях шума
+#define LMS_ID_MATCH 0.1  // Допустимое относительное расхождение MSE вариантов
 #define RLS_LAMBDA 0.99f  // Фактор забывания для RLS
 #define RLS_DELTA 0.01f   // Параметр регуляризации для RLS
+#define RLS_CHECK_SAMPLES 100000 // Длина отрезка для сравнения вариантов RLS
+#define RLS_MATCH_TOLERANCE 1e-3f // Допустимое расхождение выходов вариантов RLS
+#define IIR_MODES_TOLERANCE 1e-6f // Допуск режимов IIR против поотсчетного
+#define FFT_FIR_TOLERANCE 1e-5f // Допуск overlap-save против прямой свертки
+#define BANK_CHANNELS 16  // Число каналов в банке фильтров
+#define BANK_SAMPLES 65536 // Отсчетов на канал при проверке банка
+#define BANK_TOLERANCE 1e-4f // Допуск банка против поканальной обработки
+#define PIPELINE_SAMPLES 4000000LL // Длина потока для конвейера
+#define PIPELINE_SLOTS 8  // Слотов в кольцевых буферах конвейера
+#define PIPELINE_MAX_BER 0.1 // Порог BER конвейера (угадывание - 0.5)
+#define OSC_CHECK_SAMPLES (1 << 22) // Длина проверки генератора несущей
+#define NOISE_CHECK_SAMPLES (1 << 22) // Длина проверки генератора шума
+#define OSC_TOLERANCE 1e-6 // Допустимая погрешность генератора несущей
+#define NOISE_TOLERANCE 0.02 // Допуск среднего, дисперсии - 1 и эксцесса / 3 - 1
+#define RRC_TOLERANCE 1e-4f // Допуск полифазного модулятора против прямой свертки
+#define RNG_SEED 12345ULL // Seed генератора: запуски повторяемы
+#define PACKED_CHECK_BITS (1 << 24) // Длина проверки упакованных бит
+#define RRC_CHECK_BITS 1000 // Бит проверки формы импульса RRC
+#define RRC_SPECTRUM_FFT 4096 // Размер БПФ оценки спектра (шаг fs / 4096)
+#define DEMAPPER_CHECK_SYMBOLS (1 << 20) // Символов проверки демаппера
+#define DEMAPPER_CHECK_ESN0 6.0f // Es/N0 проверки демаппера, дБ
+#define IQ_PATTERN_BITS NUM_BITS // Циклическая последовательность записей режима iq
+#define ZERO_ALLOC_RUNS 2 // Прогонов проверки работы без кучи
+#define ZERO_ALLOC_BITS 1000 // Бит на прогон (RLS O(N^2) задает время проверки)
+#define SWEEP_EBN0_STOP 12.0f  // Сетка Eb/N0 режима sweep: 0..12 дБ
+#define SWEEP_EBN0_STEP 1.0f
+#define SWEEP_TRIAL_BITS 2000  // Бит в одном испытании
+#define SWEEP_TARGET_ERRORS 200 // Ошибок для остановки точки
+#define SWEEP_MAX_BITS 2000000LL // Предел бит на точку
+#define SWEEP_MAX_POINTS 256
+#define SWEEP_LMS_STEP 0.1f    // mu * длина * мощность входа LMS в режиме sweep
+#define BENCH_SAMPLES 65536    // Отсчетов за один прогон режима bench
+#define BENCH_WARMUP 2         // Прогревочных прогонов
+#define BENCH_REPETITIONS 11   // Замеряемых прогонов (нечетное - медиана без усреднения)
+#define BENCH_MAX_GRID 32      // Предел длины сеток отводов и блоков
+#define BENCH_MAX_RESULTS 1024
+#define BLOCK_SIZE 4096   // Размер блока для блочной обработки
+#define DISPATCH_CHECK_SAMPLES 65536 // Отсчетов проверки ядер по наборам команд
+#define DISPATCH_CHECK_TAPS 256      // Длина свертки в проверке ядер
+#define DISPATCH_TOLERANCE 1e-5      // Допуск относительного отклонения ядер от scalar
+#define DDC_FACTOR 10     // Коэффициент децимации DDC
+#define DDC_CUTOFF 30e6f  // Частота среза ФНЧ DDC (половина полосы 2110-2170 МГц)
+#define COEFF_FILE_DEFAULT "coeffs.bin" // Файл коэффициентов, читаемый при запуске
+#define DESIGN_RESPONSE_POINTS 2048 // Частот сравнения АЧХ синтезированного IIR (0..fs/2)
+#define DESIGN_CACHED_RUNS 1000     // Запросов к кэшу синтеза при замере
+#define DESIGN_FIR_TOLERANCE 1e-7   // Допуск отводов FIR против coeffs.h (.8f)
+#define DESIGN_RESPONSE_TOLERANCE 1e-4 // Допуск АЧХ IIR против coeffs.h
+#define DESIGN_GAIN_TOLERANCE 1e-5  // Допуск относительного отличия усиления IIR
+#define CHAIN_SAMPLES (1 << 21) // Длина сигнала сравнения цепочки стадий (16 МБ)
+#define CHAIN_REPEATS 3   // Прогонов на вариант цепочки (берется лучший)
+
+// Коэффициенты сравнения фильтров: встроенные из coeffs.h либо загруженные
+// из файла (указатели внутрь отображения файла)
+typedef struct {
+    const float* fir;
+    int fir_taps;
+    const float* sos;
+    int iir_sections;
+} filter_coeffs;
+
+static filter_coeffs active_coeffs = {fir_coeff, FIR_NUMTAPS, iir_sos, IIR_SECTIONS};
+static coeff_file active_coeff_file;
+static float designed_fir[FIR_NUMTAPS];        // коэффициенты режима -d
+static float designed_sos[IIR_SECTIONS * 6];
 
 // Прототипы функций
 float calculate_ber(const uint8_t* original, const uint8_t* decoded, int length);
 void run_benchmark(const char* name, complex_float* signal, int length, 
     int filter_delay, const qpsk_params* params,
     uint8_t* original_bits, int num_bits,
-    complex_float* desired_signal); 
+    complex_float* desired_signal, workspace* ws); 
+size_t benchmark_workspace_size(int length, const qpsk_params* params, int num_bits);
+int check_zero_alloc(const complex_float* signal, const complex_float* clean, int length,
+    const qpsk_params* params, const uint8_t* original_bits, int num_bits);
+int load_coefficients(const char* path, int required);
+int iir_demod_delay(const qpsk_params* params);
+int design_coefficients(const qpsk_params* params);
+int select_coefficients(const qpsk_params* params, const char* coeff_path, int design);
+int check_dispatch(void);
+int check_filter_design(const qpsk_params* params);
+int check_coeff_file(const complex_float* signal, int length);
+int check_fir_block_parity(const complex_float* signal, int length);
+void report_fft_crossover(void);
+int check_iir_modes(const complex_float* signal, int length);
+int check_lms_variants(void);
+int check_rls_variants(const complex_float* signal, const complex_float* desired, int length,
+    const qpsk_params* params, const uint8_t* original_bits, int num_bits);
+int check_filter_bank(const complex_float* signal, const complex_float* desired, int length);
+int check_oscillator(void);
+int check_noise_generator(void);
+int check_streaming_demod(const complex_float* signal, int length, const qpsk_params* params);
+int check_packed_bits(const complex_float* signal, int length, const qpsk_params* params);
+int check_rrc_shaping(const qpsk_params* params);
+int check_demapper(void);
+int check_iq_file(const complex_float* signal, int length, const qpsk_params* params,
+    const uint8_t* original_bits, int num_bits);
+int check_fixed_point(const complex_float* signal, int length, const qpsk_params* params,
+    const uint8_t* original_bits, int num_bits);
+int run_pipeline_benchmark(const qpsk_params* params, const uint8_t* pattern, int pattern_bits);
+void run_ddc_benchmark(const complex_float* signal, int length, const qpsk_params* params,
+    const uint8_t* original_bits, int num_bits);
+int run_chain_benchmark(const qpsk_params* params);
+
+int run_ber_sweep(int argc, char** argv);
+int run_kernel_bench(int argc, char** argv);
+int run_iq(int argc, char** argv);
+void print_usage(const char* program);
+
+int main(int argc, char** argv) {
+    // Режимы: без аргументов - проверки и сравнение фильтров,
+    // sweep - кривые BER, bench - замер ядер фильтров, iq - обработка записей
+    if (argc > 1 && strcmp(argv[1], "sweep") == 0) {
+        return run_ber_sweep(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        return run_kernel_bench(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "iq") == 0) {
+        return run_iq(argc - 1, argv + 1);
+    }
+    const char* coeff_path = NULL;
+    const char* stats_path = NULL;
+    int stats_hardware = 0;
+    int design = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "c:ds:Ph")) != -1) {
+        switch (opt) {
+        case 'c': coeff_path = optarg; break;
+        case 'd': design = 1; break;
+        case 's': stats_path = optarg; break;
+        case 'P': stats_hardware = 1; break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind < argc || (design && coeff_path)) {
+        print_usage(argv[0]);
+        return 1;
+    }
 
-int main() {
     // Инициализация параметров модуляции
     qpsk_params params = {
         .f_center = F_CENTER,
         .fs = FS,
         .samples_per_sym = SAMPLES_PER_SYMBOL
     };
+
+    if (select_coefficients(&params, coeff_path, design) != 0) {
+        return 1;
+    }
     
-    // Генерация тестовых данных
-    uint8_t* original_bits = generate_random_bits(NUM_BITS);
+    // Генерация тестовых данных: биты и шум канала из независимых потоков
+    rng_state rng, noise_rng;
+    rng_init(&rng, RNG_SEED);
+    rng_split(&rng, &noise_rng);
+    uint8_t* original_bits = generate_random_bits(NUM_BITS, &rng);
     if (!original_bits) {
         printf("Ошибка генерации битов\n");
         return 1;
@@ -59,35 +228,88 @@ int main() {
     memcpy(clean_signal, tx_signal, tx_length * sizeof(complex_float));
     memcpy(noisy_signal, tx_signal, tx_length * sizeof(complex_float));
     add_noise_and_interference(noisy_signal, tx_length, NOISE_POWER, 
-                              INTERFERENCE_FREQ, INTERFERENCE_POWER, FS);
+                              INTERFERENCE_FREQ, INTERFERENCE_POWER, FS, &noise_rng);
         
+    // Проверки не прерывают замеры, но любая неудачная дает ненулевой код выхода
+    int failed = 0;
+    failed |= check_dispatch();
+    failed |= check_filter_design(&params);
+    failed |= check_coeff_file(noisy_signal, tx_length);
+    failed |= check_fir_block_parity(noisy_signal, tx_length);
+    report_fft_crossover();
+    failed |= check_iir_modes(noisy_signal, tx_length);
+    failed |= check_lms_variants();
+    failed |= check_rls_variants(noisy_signal, clean_signal, tx_length, &params,
+                                 original_bits, NUM_BITS);
+    failed |= check_filter_bank(noisy_signal, clean_signal, tx_length);
+    failed |= check_oscillator();
+    failed |= check_noise_generator();
+    failed |= check_streaming_demod(noisy_signal, tx_length, &params);
+    failed |= check_packed_bits(noisy_signal, tx_length, &params);
+    failed |= check_rrc_shaping(&params);
+    failed |= check_demapper();
+    failed |= check_iq_file(noisy_signal, tx_length, &params, original_bits, NUM_BITS);
+    int status = check_zero_alloc(noisy_signal, clean_signal, tx_length, &params,
+                                  original_bits, NUM_BITS) == 0 ? 0 : 1;
+    failed |= check_fixed_point(noisy_signal, tx_length, &params, original_bits, NUM_BITS);
+    failed |= run_pipeline_benchmark(&params, original_bits, NUM_BITS);
+    failed |= run_chain_benchmark(&params);
+
+    // Одна рабочая область на все прогоны сравнения фильтров
+    workspace ws;
+    if (workspace_init(&ws, benchmark_workspace_size(tx_length, &params, NUM_BITS)) != 0) {
+        printf("Ошибка выделения рабочей области\n");
+        status = 1;
+    }
+
+    // Счетчики этапов считаются только по сравнению фильтров
+    if (dsp_stats_init(stats_hardware) != 0) {
+        printf("Аппаратные счетчики perf_event недоступны, замеряются только такты\n");
+    }
+
     // Запуск тестов для каждого фильтра
     const char* conditions[] = {"Без шума", "С шумом"};
     complex_float* signals[] = {clean_signal, noisy_signal};
     
-    for (int cond = 0; cond < 2; cond++) {
+    for (int cond = 0; status == 0 && cond < 2; cond++) {
         printf("\n===== Условие: %s =====\n", conditions[cond]);
         
         // Для FIR и IIR desired_signal не используется
-        run_benchmark("FIR", signals[cond], tx_length, FIR_NUMTAPS/2, &params, 
-                     original_bits, NUM_BITS, NULL);
-        run_benchmark("IIR", signals[cond], tx_length, IIR_ORDER*10, &params, 
-                     original_bits, NUM_BITS, NULL);
+        run_benchmark("FIR", signals[cond], tx_length, active_coeffs.fir_taps/2, &params, 
+                     original_bits, NUM_BITS, NULL, &ws);
+        run_benchmark("IIR", signals[cond], tx_length, iir_demod_delay(&params), &params, 
+                     original_bits, NUM_BITS, NULL, &ws);
         
-        // Для адаптивных фильтров используем чистый сигнал как reference
-        run_benchmark("LMS", signals[cond], tx_length, LMS_LENGTH/2, &params, 
-                     original_bits, NUM_BITS, clean_signal);
-        run_benchmark("RLS", signals[cond], tx_length, RLS_LENGTH/2, &params, 
-                     original_bits, NUM_BITS, clean_signal);
+        // Для адаптивных фильтров используем чистый сигнал как reference;
+        // выход следует за ним без задержки. Комплексный RLS - только
+        // классический O(N^2): решетка есть лишь у вещественного rls_filter
+        // (сравнение вариантов - в check_rls_variants)
+        run_benchmark("LMS", signals[cond], tx_length, 0, &params, 
+                     original_bits, NUM_BITS, clean_signal, &ws);
+        run_benchmark("RLS", signals[cond], tx_length, 0, &params, 
+                     original_bits, NUM_BITS, clean_signal, &ws);
+
+        run_ddc_benchmark(signals[cond], tx_length, &params, original_bits, NUM_BITS);
     }
+
+    printf("\n[Счетчики этапов] сравнение фильтров\n");
+    dsp_stats_print(stdout);
+    if (stats_path && dsp_stats_write_json(stats_path) != 0) {
+        printf("Ошибка записи %s\n", stats_path);
+        status = 1;
+    }
+    dsp_stats_shutdown();
     
     // Очистка памяти
     free(clean_signal);
     free(noisy_signal);
     free(original_bits);
     free(tx_signal);
+    workspace_free(&ws);
+    coeff_file_close(&active_coeff_file);
     
-    return 0;
+    if (failed) printf("\nСамопроверки: есть ошибки или расхождения\n");
+    return status | failed;
 }
 
 float calculate_ber(const uint8_t* original, const uint8_t* decoded, int length) {
@@ -101,62 +323,80 @@ float calculate_ber(const uint8_t* original, const uint8_t* decoded, int length)
 void run_benchmark(const char* name, complex_float* signal, int length, 
     int filter_delay, const qpsk_params* params,
     uint8_t* original_bits, int num_bits,
-    complex_float* desired_signal) {
+    complex_float* desired_signal, workspace* ws) {
 printf("\n[%s] Тестирование фильтра\n", name);
+// Фильтры, выход и результат демодуляции берутся из рабочей области и
+// возвращаются откатом к метке
+size_t mark = workspace_mark(ws);
+
+// FIR: overlap-save по составляющим I и Q (для 501 отвода это быстрее прямой
+// свертки cfir_filter); остальные фильтры работают с комплексным сигналом
+fft_fir_filter fir_i = {0}, fir_q = {0};
+ciir_filter iir = {0};
+clms_filter lms = {0};
+crls_filter rls = {0};
 
-// Создаем фильтры для I и Q компонент
-fir_filter fir_i = {0}, fir_q = {0};
-iir_filter iir_i = {0}, iir_q = {0};
-lms_filter lms_i = {0}, lms_q = {0};
-rls_filter rls_i = {0}, rls_q = {0};
-
-if (strcmp(name, "FIR") == 0) {
-fir_filter_init(&fir_i, fir_coeff, FIR_NUMTAPS);
-fir_filter_init(&fir_q, fir_coeff, FIR_NUMTAPS);
-} else if (strcmp(name, "IIR") == 0) {
-iir_filter_init(&iir_i, iir_b, IIR_ORDER + 1, iir_a, IIR_ORDER + 1);
-iir_filter_init(&iir_q, iir_b, IIR_ORDER + 1, iir_a, IIR_ORDER + 1);
-} else if (strcmp(name, "LMS") == 0) {
-lms_filter_init(&lms_i, LMS_LENGTH, LMS_MU);
-lms_filter_init(&lms_q, LMS_LENGTH, LMS_MU);
-} else if (strcmp(name, "RLS") == 0) {
-rls_filter_init(&rls_i, RLS_LENGTH, RLS_LAMBDA, RLS_DELTA);
-rls_filter_init(&rls_q, RLS_LENGTH, RLS_LAMBDA, RLS_DELTA);
+int is_fir = strcmp(name, "FIR") == 0;
+int is_iir = strcmp(name, "IIR") == 0;
+int is_lms = strcmp(name, "LMS") == 0;
+int is_rls = strcmp(name, "RLS") == 0;
+
+int status = -1;
+if (is_fir) {
+status = fft_fir_filter_init_ws(&fir_i, active_coeffs.fir, active_coeffs.fir_taps, 0,
+                                FFT_FIR_AUTO, ws);
+if (status == 0) {
+status = fft_fir_filter_init_ws(&fir_q, active_coeffs.fir, active_coeffs.fir_taps, 0,
+                                FFT_FIR_AUTO, ws);
+}
+} else if (is_iir) {
+status = ciir_filter_init_sos_ws(&iir, active_coeffs.sos, active_coeffs.iir_sections, ws);
+} else if (is_lms) {
+status = clms_filter_init_ws(&lms, LMS_LENGTH, LMS_MU, ws);
+} else if (is_rls) {
+status = crls_filter_init_ws(&rls, RLS_LENGTH, RLS_LAMBDA, RLS_DELTA, ws);
 } else {
 printf("Неизвестный тип фильтра\n");
 return;
 }
 
 // Фильтрация сигнала
-complex_float* filtered = malloc(length * sizeof(complex_float));
-
-clock_t start = clock();
-
-for (int i = 0; i < length; i++) {
-float real = signal[i].real;
-float imag = signal[i].imag;
-
-if (strcmp(name, "FIR") == 0) {
-filtered[i].real = fir_filter_process(&fir_i, real);
-filtered[i].imag = fir_filter_process(&fir_q, imag);
-} else if (strcmp(name, "IIR") == 0) {
-filtered[i].real = iir_filter_process(&iir_i, real);
-filtered[i].imag = iir_filter_process(&iir_q, imag);
-} else if (strcmp(name, "LMS") == 0 && desired_signal) {
-filtered[i].real = lms_filter_process(&lms_i, real, desired_signal[i].real);
-filtered[i].imag = lms_filter_process(&lms_q, imag, desired_signal[i].imag);
-} else if (strcmp(name, "RLS") == 0 && desired_signal) {
-filtered[i].real = rls_filter_process(&rls_i, real, desired_signal[i].real);
-filtered[i].imag = rls_filter_process(&rls_q, imag, desired_signal[i].imag);
+complex_float* filtered = workspace_alloc(ws, length * sizeof(complex_float));
+if (status != 0 || !filtered) {
+printf("Ошибка инициализации фильтра\n");
+workspace_release(ws, mark);
+return;
+}
+
+uint64_t start = bench_now_ns();
+
+if (is_fir) {
+float in_i[BLOCK_SIZE], in_q[BLOCK_SIZE], out_i[BLOCK_SIZE], out_q[BLOCK_SIZE];
+for (int offset = 0; offset < length; offset += BLOCK_SIZE) {
+int n = (length - offset < BLOCK_SIZE) ? length - offset : BLOCK_SIZE;
+for (int i = 0; i < n; i++) {
+in_i[i] = signal[offset + i].real;
+in_q[i] = signal[offset + i].imag;
+}
+fft_fir_filter_process_block(&fir_i, in_i, out_i, n);
+fft_fir_filter_process_block(&fir_q, in_q, out_q, n);
+for (int i = 0; i < n; i++) {
+filtered[offset + i].real = out_i[i];
+filtered[offset + i].imag = out_q[i];
+}
+}
+} else if (is_iir) {
+ciir_filter_process_block(&iir, signal, filtered, length);
+} else if (is_lms && desired_signal) {
+clms_filter_process_block(&lms, signal, desired_signal, filtered, length);
+} else if (is_rls && desired_signal) {
+crls_filter_process_block(&rls, signal, desired_signal, filtered, length);
 } else {
 // Если нет reference-сигнала, просто копируем вход
-filtered[i].real = real;
-filtered[i].imag = imag;
-}
+memcpy(filtered, signal, length * sizeof(complex_float));
 }
 
-clock_t end = clock();
-double elapsed = (double)(end - start) / CLOCKS_PER_SEC;
+double elapsed = bench_elapsed(start);
 double samples_per_sec = length / elapsed;
 
 printf("Время обработки: %.4f сек\n", elapsed);
@@ -167,33 +407,2925 @@ int demod_bits_count;
 complex_float* constellation;
 int delay = filter_delay;
 
-uint8_t* decoded_bits = qpsk_demodulate(filtered, length, params, delay, 
+uint8_t* decoded_bits = qpsk_demodulate_ws(filtered, length, params, delay, ws,
                            &demod_bits_count, &constellation);
 
 if (decoded_bits) {
 int compare_length = (num_bits < demod_bits_count) ? num_bits : demod_bits_count;
 float ber = calculate_ber(original_bits, decoded_bits, compare_length);
 printf("BER: %.6f (ошибок: %d из %d бит)\n", ber, (int)(ber * compare_length), compare_length);
-free(decoded_bits);
-free(constellation);
 } else {
 printf("Ошибка демодуляции\n");
 }
 
 // Освобождение ресурсов фильтров
-if (strcmp(name, "FIR") == 0) {
-fir_filter_free(&fir_i);
-fir_filter_free(&fir_q);
-} else if (strcmp(name, "IIR") == 0) {
-iir_filter_free(&iir_i);
-iir_filter_free(&iir_q);
-} else if (strcmp(name, "LMS") == 0) {
-lms_filter_free(&lms_i);
-lms_filter_free(&lms_q);
-} else if (strcmp(name, "RLS") == 0) {
-rls_filter_free(&rls_i);
-rls_filter_free(&rls_q);
-}
-
-free(filtered);
-}
\ No newline at end of file
+if (is_fir) {
+fft_fir_filter_free(&fir_i);
+fft_fir_filter_free(&fir_q);
+} else if (is_iir) {
+ciir_filter_free(&iir);
+} else if (is_lms) {
+clms_filter_free(&lms);
+} else if (is_rls) {
+crls_filter_free(&rls);
+}
+
+workspace_release(ws, mark);
+}
+
+// Рабочая область run_benchmark: наибольший из фильтров, выход фильтра и
+// результат демодуляции
+size_t benchmark_workspace_size(int length, const qpsk_params* params, int num_bits) {
+    size_t filters[] = {
+        2 * fft_fir_filter_workspace_size(active_coeffs.fir_taps, 0, FFT_FIR_AUTO),
+        ciir_filter_workspace_size(active_coeffs.iir_sections),
+        clms_filter_workspace_size(LMS_LENGTH),
+        crls_filter_workspace_size(RLS_LENGTH)
+    };
+    size_t size = 0;
+    for (int i = 0; i < 4; i++) {
+        if (filters[i] > size) size = filters[i];
+    }
+    // Для проверки без кучи дополнительно: модулированный сигнал, копия
+    // канала, буфер фильтра, I и Q для FIR
+    size += qpsk_modulate_workspace_size(num_bits, params);
+    size += 2 * workspace_align(length * sizeof(complex_float));
+    size += 2 * workspace_align(length * sizeof(float));
+    size += qpsk_demodulate_workspace_size(length, params, 0);
+    return size;
+}
+
+static const char* zero_alloc_names[] = {"FIR", "IIR", "LMS", "RLS"};
+
+// Фильтр kind (номер в zero_alloc_names) в рабочей области: in -> out,
+// in и out могут совпадать. Все буферы возвращаются откатом к метке.
+static int zero_alloc_filter(int kind, workspace* ws, const complex_float* in,
+                             const complex_float* desired, complex_float* out, int n) {
+    size_t mark = workspace_mark(ws);
+    int status = -1;
+    switch (kind) {
+    case 0: {
+        fft_fir_filter fir_i, fir_q;
+        float* re = workspace_alloc(ws, n * sizeof(float));
+        float* im = workspace_alloc(ws, n * sizeof(float));
+        if (!re || !im ||
+            fft_fir_filter_init_ws(&fir_i, active_coeffs.fir, active_coeffs.fir_taps, 0,
+                                   FFT_FIR_AUTO, ws) != 0 ||
+            fft_fir_filter_init_ws(&fir_q, active_coeffs.fir, active_coeffs.fir_taps, 0,
+                                   FFT_FIR_AUTO, ws) != 0) {
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            re[i] = in[i].real;
+            im[i] = in[i].imag;
+        }
+        fft_fir_filter_process_block(&fir_i, re, re, n);
+        fft_fir_filter_process_block(&fir_q, im, im, n);
+        for (int i = 0; i < n; i++) {
+            out[i].real = re[i];
+            out[i].imag = im[i];
+        }
+        status = 0;
+        break;
+    }
+    case 1: {
+        ciir_filter iir;
+        if (ciir_filter_init_sos_ws(&iir, active_coeffs.sos, active_coeffs.iir_sections, ws) == 0) {
+            ciir_filter_process_block(&iir, in, out, n);
+            status = 0;
+        }
+        break;
+    }
+    case 2: {
+        clms_filter lms;
+        if (clms_filter_init_ws(&lms, LMS_LENGTH, LMS_MU, ws) == 0) {
+            clms_filter_process_block(&lms, in, desired, out, n);
+            status = 0;
+        }
+        break;
+    }
+    default: {
+        crls_filter rls;
+        if (crls_filter_init_ws(&rls, RLS_LENGTH, RLS_LAMBDA, RLS_DELTA, ws) == 0) {
+            crls_filter_process_block(&rls, in, desired, out, n);
+            status = 0;
+        }
+        break;
+    }
+    }
+    workspace_release(ws, mark);
+    return status;
+}
+
+// Установившийся режим без кучи: модуляция, канал, фильтрация на месте и
+// демодуляция с памятью из одной рабочей области, созданной заранее.
+// ZERO_ALLOC_RUNS прогонов не должны вызвать ни одного выделения (счетчик
+// alloc_count); фильтрация на месте должна совпасть с фильтрацией в
+// отдельный буфер. Проверка идет на первых ZERO_ALLOC_BITS битах. Без
+// счетчика (сборка без make check) число выделений не проверяется.
+// Возвращает 0 или -1 при нарушении.
+int check_zero_alloc(const complex_float* signal, const complex_float* clean, int length,
+                     const qpsk_params* params, const uint8_t* original_bits, int num_bits) {
+    if (num_bits > ZERO_ALLOC_BITS) num_bits = ZERO_ALLOC_BITS;
+    if (length > num_bits / 2 * params->samples_per_sym) {
+        length = num_bits / 2 * params->samples_per_sym;
+    }
+    workspace ws;
+    if (workspace_init(&ws, benchmark_workspace_size(length, params, num_bits)) != 0) {
+        printf("\n[Рабочая область] Ошибка выделения\n");
+        return -1;
+    }
+
+    // Фильтрация в отдельный буфер - эталон для обработки на месте
+    size_t base = workspace_mark(&ws);
+    complex_float* reference = workspace_alloc(&ws, length * sizeof(complex_float));
+    complex_float* work = workspace_alloc(&ws, length * sizeof(complex_float));
+    int in_place_match = reference && work;
+    for (int kind = 0; in_place_match && kind < 4; kind++) {
+        memcpy(work, signal, length * sizeof(complex_float));
+        in_place_match = zero_alloc_filter(kind, &ws, signal, clean, reference, length) == 0 &&
+                         zero_alloc_filter(kind, &ws, work, clean, work, length) == 0 &&
+                         memcmp(reference, work, length * sizeof(complex_float)) == 0;
+    }
+    workspace_release(&ws, base);
+
+    rng_state rng;
+    rng_init(&rng, RNG_SEED);
+    long long errors[4] = {0};
+    long long compared = 0;
+    int failed = 0;
+    long long before = alloc_count();
+    uint64_t start = bench_now_ns();
+    for (int run = 0; run < ZERO_ALLOC_RUNS && !failed; run++) {
+        int tx_length, demod_bits;
+        complex_float* tx = qpsk_modulate_ws(original_bits, num_bits, params, &ws, &tx_length);
+        complex_float* rx = workspace_alloc(&ws, tx_length * sizeof(complex_float));
+        complex_float* filtered = workspace_alloc(&ws, tx_length * sizeof(complex_float));
+        oscillator interference;
+        if (!tx || !rx || !filtered ||
+            oscillator_init(&interference, INTERFERENCE_FREQ, params->fs) != 0) {
+            failed = 1;
+            break;
+        }
+        memcpy(rx, tx, tx_length * sizeof(complex_float));
+        add_noise_and_interference_block(rx, tx_length, NOISE_POWER, INTERFERENCE_POWER,
+                                         &interference, &rng);
+
+        int delays[4] = {active_coeffs.fir_taps / 2, iir_demod_delay(params), 0, 0};
+        for (int kind = 0; kind < 4 && !failed; kind++) {
+            size_t mark = workspace_mark(&ws);
+            complex_float* constellation;
+            memcpy(filtered, rx, tx_length * sizeof(complex_float));
+            failed = zero_alloc_filter(kind, &ws, filtered, tx, filtered, tx_length) != 0;
+            uint8_t* decoded = failed ? NULL :
+                qpsk_demodulate_ws(filtered, tx_length, params, delays[kind], &ws,
+                                   &demod_bits, &constellation);
+            if (!decoded) {
+                failed = 1;
+                break;
+            }
+            int compare = (num_bits < demod_bits) ? num_bits : demod_bits;
+            for (int i = 0; i < compare; i++) {
+                errors[kind] += decoded[i] != original_bits[i];
+            }
+            if (kind == 0) compared += compare;
+            workspace_release(&ws, mark);
+        }
+        workspace_release(&ws, base);
+    }
+    double elapsed = bench_elapsed(start);
+    long long allocations = (before < 0) ? 0 : alloc_count() - before;
+
+    printf("\n[Рабочая область] %d прогонов модуляция -> канал -> фильтр на месте -> "
+           "демодуляция:\n", ZERO_ALLOC_RUNS);
+    if (before < 0) {
+        printf("  выделений в куче: счетчик недоступен (make check)%s",
+               failed ? " (НАРУШЕНИЕ)" : "");
+    } else {
+        printf("  выделений в куче: %lld%s", allocations,
+               allocations == 0 && !failed ? "" : " (НАРУШЕНИЕ)");
+    }
+    printf(", занято %.1f из %.1f КБ, %.3f сек\n", ws.peak / 1024.0, ws.size / 1024.0,
+           elapsed);
+    printf("  фильтрация на месте: %s\n",
+           in_place_match ? "совпадает с фильтрацией в отдельный буфер" : "РАСХОЖДЕНИЕ");
+    for (int kind = 0; kind < 4 && compared > 0; kind++) {
+        printf("  %s: BER %.6f\n", zero_alloc_names[kind], (double)errors[kind] / compared);
+    }
+
+    workspace_free(&ws);
+    return allocations == 0 && !failed && in_place_match ? 0 : -1;
+}
+
+// Задержка демодулятора после IIR активного каскада: целое число отсчетов
+// у групповой задержки на несущей, при котором совпадает и фаза несущей
+// (iir_filter_sos_delay). Общая для всех проверок IIR
+int iir_demod_delay(const qpsk_params* params) {
+    int delay = iir_filter_sos_delay(active_coeffs.sos, active_coeffs.iir_sections,
+                                     params->f_center, params->fs);
+    return delay > 0 ? delay : 0;
+}
+
+// Загрузка коэффициентов FIR и IIR (секции fir и iir_sos). Если файла нет и
+// он не обязателен, остаются встроенные коэффициенты.
+int load_coefficients(const char* path, int required) {
+    int status = coeff_file_open(&active_coeff_file, path);
+    if (status == -1 && !required) {
+        printf("[Коэффициенты] %s не найден, используются встроенные\n", path);
+        return 0;
+    }
+    if (status != 0) {
+        printf("[Коэффициенты] Ошибка чтения %s: %d\n", path, status);
+        return -1;
+    }
+
+    int fir_taps = 0, sos_count = 0;
+    const float* fir = coeff_file_find(&active_coeff_file, "fir", COEFF_REAL, &fir_taps);
+    const float* sos = coeff_file_find(&active_coeff_file, "iir_sos", COEFF_REAL, &sos_count);
+    if (!fir || fir_taps <= 0 || !sos || sos_count <= 0 || sos_count % 6 != 0) {
+        printf("[Коэффициенты] В %s нет секций fir и iir_sos\n", path);
+        coeff_file_close(&active_coeff_file);
+        return -1;
+    }
+    active_coeffs.fir = fir;
+    active_coeffs.fir_taps = fir_taps;
+    active_coeffs.sos = sos;
+    active_coeffs.iir_sections = sos_count / 6;
+    printf("[Коэффициенты] %s: FIR %d отводов, IIR %d секций\n", path, fir_taps,
+           active_coeffs.iir_sections);
+    return 0;
+}
+
+// FIR и IIR той же длины и порядка, что в coeffs.h, по полосе сигнала
+// params: расчет при запуске вместо coeffs.bin / coeffs.h
+int design_coefficients(const qpsk_params* params) {
+    filter_design_spec fir = {FILTER_DESIGN_FIR, FIR_NUMTAPS, {0.0, 0.0, 0.0},
+                              FILTER_DESIGN_KAISER_BETA};
+    filter_design_spec iir = {FILTER_DESIGN_BUTTER, IIR_SECTIONS, {0.0, 0.0, 0.0}, 0.0};
+    if (filter_design_band(params, &fir.band) != 0) {
+        printf("[Коэффициенты] Полоса сигнала выходит за (0, fs/2)\n");
+        return -1;
+    }
+    iir.band = fir.band;
+    uint64_t start = bench_now_ns();
+    if (filter_design_get(&fir, designed_fir, FIR_NUMTAPS) < 0 ||
+        filter_design_get(&iir, designed_sos, IIR_SECTIONS * 6) < 0) {
+        printf("[Коэффициенты] Ошибка синтеза фильтров\n");
+        return -1;
+    }
+    double ms = (bench_now_ns() - start) * 1e-6;
+    active_coeffs.fir = designed_fir;
+    active_coeffs.fir_taps = FIR_NUMTAPS;
+    active_coeffs.sos = designed_sos;
+    active_coeffs.iir_sections = IIR_SECTIONS;
+    printf("[Коэффициенты] Синтез по полосе %.6g-%.6g МГц: FIR %d отводов, IIR %d секций, "
+           "%.3f мс\n", fir.band.f_low / 1e6, fir.band.f_high / 1e6, FIR_NUMTAPS,
+           IIR_SECTIONS, ms);
+    return 0;
+}
+
+// Коэффициенты режима: -d - синтез по полосе params, -c - файл (явно
+// заданный обязателен; файл по умолчанию - только если есть)
+int select_coefficients(const qpsk_params* params, const char* coeff_path, int design) {
+    return design ? design_coefficients(params)
+                  : load_coefficients(coeff_path ? coeff_path : COEFF_FILE_DEFAULT,
+                                      coeff_path != NULL);
+}
+
+// Модуль АЧХ каскада секций на частоте f (доли fs)
+static double sos_magnitude(const float* sos, int sections, double f) {
+    double w = 2.0 * M_PI * f;
+    double c1 = cos(w), s1 = -sin(w), c2 = cos(2.0 * w), s2 = -sin(2.0 * w);
+    double magnitude = 1.0;
+    for (int s = 0; s < sections; s++) {
+        const float* row = &sos[6 * s];
+        double nr = row[0] + row[1] * c1 + row[2] * c2, ni = row[1] * s1 + row[2] * s2;
+        double dr = row[3] + row[4] * c1 + row[5] * c2, di = row[4] * s1 + row[5] * s2;
+        magnitude *= sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+    }
+    return magnitude;
+}
+
+// Синтез на C против сгенерированного coeffs.h (filters_calculation.py):
+// отводы FIR поэлементно, IIR - по АЧХ вместе с усилением (разбиение на
+// секции может отличаться) и усиление первой секции отдельно, с допусками;
+// время синтеза против выдачи из кэша
+int check_filter_design(const qpsk_params* params) {
+    filter_design_spec fir = {FILTER_DESIGN_FIR, FIR_NUMTAPS, {0.0, 0.0, 0.0},
+                              FILTER_DESIGN_KAISER_BETA};
+    filter_design_spec iir = {FILTER_DESIGN_BUTTER, IIR_SECTIONS, {0.0, 0.0, 0.0}, 0.0};
+    float h[FIR_NUMTAPS], sos[IIR_SECTIONS * 6];
+    printf("\n[Синтез фильтров]\n");
+    if (filter_design_band(params, &fir.band) != 0) {
+        printf("  Полоса сигнала выходит за (0, fs/2)\n");
+        return 1;
+    }
+    iir.band = fir.band;
+
+    filter_design_cache_clear();
+    uint64_t start = bench_now_ns();
+    int status = filter_design_get(&fir, h, FIR_NUMTAPS);
+    double fir_us = (bench_now_ns() - start) * 1e-3;
+    start = bench_now_ns();
+    if (status < 0 || filter_design_get(&iir, sos, IIR_SECTIONS * 6) < 0) {
+        printf("  Ошибка синтеза\n");
+        return 1;
+    }
+    double iir_us = (bench_now_ns() - start) * 1e-3;
+    start = bench_now_ns();
+    for (int r = 0; r < DESIGN_CACHED_RUNS; r++) {
+        if (r % 2) {
+            filter_design_get(&iir, sos, IIR_SECTIONS * 6);
+        } else {
+            filter_design_get(&fir, h, FIR_NUMTAPS);
+        }
+    }
+    double cached_us = (bench_now_ns() - start) * 1e-3 / DESIGN_CACHED_RUNS;
+    long long hits, misses;
+    filter_design_cache_stats(&hits, &misses);
+
+    double fir_error = 0.0;
+    for (int i = 0; i < FIR_NUMTAPS; i++) {
+        fir_error = fmax(fir_error, fabs((double)h[i] - fir_coeff[i]));
+    }
+    // iir_sos в coeffs.h записан в формате .10e, то есть точнее float: АЧХ
+    // сравниваются без выравнивания усиления, в полосе пропускания АЧХ ~1
+    double gain_error = fabs((double)sos[0] / iir_sos[0] - 1.0);
+    double iir_error = 0.0;
+    for (int k = 0; k <= DESIGN_RESPONSE_POINTS; k++) {
+        double f = 0.5 * k / DESIGN_RESPONSE_POINTS;
+        iir_error = fmax(iir_error, fabs(sos_magnitude(sos, IIR_SECTIONS, f) -
+                                         sos_magnitude(iir_sos, IIR_SECTIONS, f)));
+    }
+    printf("  Полоса %.6g-%.6g МГц, fs %.6g ГГц\n", fir.band.f_low / 1e6,
+           fir.band.f_high / 1e6, fir.band.fs / 1e9);
+    int fir_ok = fir_error <= DESIGN_FIR_TOLERANCE;
+    int iir_ok = iir_error <= DESIGN_RESPONSE_TOLERANCE && gain_error <= DESIGN_GAIN_TOLERANCE;
+    printf("  FIR %d отводов: %.1f мкс, макс. отличие от coeffs.h %.2e%s\n", FIR_NUMTAPS,
+           fir_us, fir_error, fir_ok ? "" : " (ОШИБКА)");
+    printf("  IIR %d секций: %.1f мкс, макс. отличие АЧХ от coeffs.h %.2e, усиление %.9g "
+           "(в coeffs.h %.9g, отличие %.2e)%s\n", IIR_SECTIONS, iir_us, iir_error, sos[0],
+           iir_sos[0], gain_error, iir_ok ? "" : " (ОШИБКА)");
+    printf("  Из кэша: %.3f мкс на запрос (попаданий %lld, промахов %lld)\n", cached_us,
+           hits, misses);
+    return fir_ok && iir_ok ? 0 : 1;
+}
+
+// Запись встроенных коэффициентов в файл, чтение через отображение и
+// проверка контрольной суммы; затем сравнение специализированного ядра FIR
+// (длина из списка FIR_FIXED_TAPS_LIST) с общим на загруженных коэффициентах
+int check_coeff_file(const complex_float* signal, int length) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/dsp_coeffs_%d.bin", (int)getpid());
+    coeff_section sections[] = {
+        {"fir", COEFF_REAL, FIR_NUMTAPS, fir_coeff},
+        {"iir_sos", COEFF_REAL, IIR_SECTIONS * 6, iir_sos},
+        {"lms_weights", COEFF_COMPLEX, LMS_NTAPS, (const float*)lms_weights}
+    };
+    if (coeff_file_write(path, sections, 3) != 0) {
+        printf("\n[Коэффициенты] Ошибка записи %s\n", path);
+        return 1;
+    }
+
+    coeff_file file;
+    int status = coeff_file_open(&file, path);
+    int fir_taps = 0, lms_taps = 0;
+    const float* fir = status == 0 ? coeff_file_find(&file, "fir", COEFF_REAL, &fir_taps) : NULL;
+    const float* lms = status == 0 ? coeff_file_find(&file, "lms_weights", COEFF_COMPLEX, &lms_taps) : NULL;
+    int same = fir && lms && fir_taps == FIR_NUMTAPS && lms_taps == LMS_NTAPS &&
+               memcmp(fir, fir_coeff, sizeof(fir_coeff)) == 0 &&
+               memcmp(lms, lms_weights, sizeof(lms_weights)) == 0;
+    printf("\n[Коэффициенты] Файл %zu байт, чтение: %s\n", file.size,
+           status != 0 ? "ошибка" : same ? "совпадает со встроенными" : "РАСХОЖДЕНИЕ");
+
+    // Порча одного байта данных должна обнаруживаться по CRC
+    int failed = !same;
+    FILE* f = fopen(path, "r+b");
+    failed |= !f;
+    if (f) {
+        fseek(f, -1, SEEK_END);
+        int c = fgetc(f);
+        fseek(f, -1, SEEK_END);
+        fputc(c ^ 0x01, f);
+        fclose(f);
+        coeff_file corrupted;
+        int corrupted_status = coeff_file_open(&corrupted, path);
+        printf("[Коэффициенты] Испорченный файл: код %d (%s)\n", corrupted_status,
+               corrupted_status == -5 ? "ошибка CRC обнаружена" : "НЕ ОБНАРУЖЕНО");
+        failed |= corrupted_status != -5;
+        if (corrupted_status == 0) coeff_file_close(&corrupted);
+    }
+
+    if (same) {
+        fir_filter fixed, generic;
+        if (fir_filter_init(&fixed, fir, fir_taps) == 0 &&
+            fir_filter_init_mode(&generic, fir, fir_taps, FIR_KERNEL_GENERIC) == 0) {
+            float in[BLOCK_SIZE], out_fixed[BLOCK_SIZE], out_generic[BLOCK_SIZE];
+            int mismatches = 0;
+            for (int offset = 0; offset < length; offset += BLOCK_SIZE) {
+                int n = (length - offset < BLOCK_SIZE) ? length - offset : BLOCK_SIZE;
+                for (int i = 0; i < n; i++) in[i] = signal[offset + i].real;
+                fir_filter_process_block(&fixed, in, out_fixed, n);
+                fir_filter_process_block(&generic, in, out_generic, n);
+                mismatches += memcmp(out_fixed, out_generic, n * sizeof(float)) != 0;
+            }
+            printf("[Коэффициенты] FIR %d отводов: ядро %s, расхождений с общим: %d\n",
+                   fir_taps, fixed.block ? "фиксированной длины" : "общее", mismatches);
+            failed |= mismatches != 0;
+            fir_filter_free(&fixed);
+            fir_filter_free(&generic);
+        } else {
+            failed = 1;
+        }
+    }
+
+    if (status == 0) coeff_file_close(&file);
+    unlink(path);
+    return failed;
+}
+
+// Сравнение блочной и поотсчетной обработки FIR фильтра. Блоки нарочно
+// берутся разной длины, чтобы проверить перенос состояния между вызовами.
+// Блочная обработка должна совпадать с поотсчетной побитово (fir_filter.h),
+// overlap-save - с точностью FFT_FIR_TOLERANCE.
+int check_fir_block_parity(const complex_float* signal, int length) {
+    fir_filter fir_sample = {0}, fir_block = {0};
+    fft_fir_filter fir_fft = {0}, fir_buffered = {0};
+    // Выход прямой свертки целиком: с ним сравнивается запаздывающий выход
+    // буферизованного overlap-save
+    float* direct = malloc((size_t)length * sizeof(float));
+    if (!direct || fir_filter_init(&fir_sample, fir_coeff, FIR_NUMTAPS) != 0 ||
+        fir_filter_init(&fir_block, fir_coeff, FIR_NUMTAPS) != 0 ||
+        fft_fir_filter_init_mode(&fir_fft, fir_coeff, FIR_NUMTAPS, 0, FFT_FIR_FFT) != 0 ||
+        fft_fir_filter_init_mode(&fir_buffered, fir_coeff, FIR_NUMTAPS, 0, FFT_FIR_FFT) != 0) {
+        printf("Ошибка инициализации FIR фильтра\n");
+        fir_filter_free(&fir_sample);
+        fir_filter_free(&fir_block);
+        fft_fir_filter_free(&fir_fft);
+        fft_fir_filter_free(&fir_buffered);
+        free(direct);
+        return 1;
+    }
+    fft_fir_filter_set_buffered(&fir_buffered, 1);
+    int latency = fft_fir_filter_latency(&fir_buffered);
+
+    float in[BLOCK_SIZE], out[BLOCK_SIZE], out_fft[BLOCK_SIZE], out_buffered[BLOCK_SIZE];
+    float max_diff = 0.0f, max_diff_fft = 0.0f, max_diff_buffered = 0.0f;
+    int offset = 0;
+    for (int chunk = 1; offset < length; chunk = chunk * 3 % (BLOCK_SIZE - 1) + 1) {
+        int n = (length - offset < chunk) ? length - offset : chunk;
+        for (int i = 0; i < n; i++) {
+            in[i] = signal[offset + i].real;
+        }
+        fir_filter_process_block(&fir_block, in, out, n);
+        fft_fir_filter_process_block(&fir_fft, in, out_fft, n);
+        fft_fir_filter_process_block(&fir_buffered, in, out_buffered, n);
+        for (int i = 0; i < n; i++) {
+            float diff = fabsf(out[i] - fir_filter_process(&fir_sample, in[i]));
+            if (diff > max_diff) max_diff = diff;
+            diff = fabsf(out[i] - out_fft[i]);
+            if (diff > max_diff_fft) max_diff_fft = diff;
+            direct[offset + i] = out[i];
+            float expected = (offset + i >= latency) ? direct[offset + i - latency] : 0.0f;
+            diff = fabsf(out_buffered[i] - expected);
+            if (diff > max_diff_buffered) max_diff_buffered = diff;
+        }
+        offset += n;
+    }
+
+    int fft_ok = max_diff_fft <= FFT_FIR_TOLERANCE && max_diff_buffered <= FFT_FIR_TOLERANCE;
+    printf("\n[FIR] Блочная обработка: макс. отклонение от поотсчетной %.3g%s\n", max_diff,
+           max_diff == 0.0f ? "" : " (РАСХОЖДЕНИЕ)");
+    printf("[FIR] Overlap-save БПФ: макс. отклонение от прямой свертки %.3g\n", max_diff_fft);
+    printf("[FIR] Overlap-save с буферизацией (задержка %d): макс. отклонение %.3g%s\n",
+           latency, max_diff_buffered, fft_ok ? "" : " (РАСХОЖДЕНИЕ)");
+
+    fir_filter_free(&fir_sample);
+    fir_filter_free(&fir_block);
+    fft_fir_filter_free(&fir_fft);
+    fft_fir_filter_free(&fir_buffered);
+    free(direct);
+    return max_diff == 0.0f && fft_ok ? 0 : 1;
+}
+
+// Сравнение режимов каскада SOS: поотсчетный, блочный и чередующийся
+// (I и Q как два канала) против комплексного ciir_filter
+int check_iir_modes(const complex_float* signal, int length) {
+    iir_filter iir_sample = {0}, iir_block = {0}, iir_multi = {0};
+    ciir_filter iir_complex = {0};
+    if (iir_filter_init_sos(&iir_sample, iir_sos, IIR_SECTIONS) != 0 ||
+        iir_filter_init_sos(&iir_block, iir_sos, IIR_SECTIONS) != 0 ||
+        iir_filter_init_sos(&iir_multi, iir_sos, IIR_SECTIONS) != 0 ||
+        iir_filter_set_channels(&iir_multi, 2) != 0 ||
+        ciir_filter_init_sos(&iir_complex, iir_sos, IIR_SECTIONS) != 0) {
+        printf("Ошибка инициализации IIR фильтра\n");
+        iir_filter_free(&iir_sample);
+        iir_filter_free(&iir_block);
+        iir_filter_free(&iir_multi);
+        return 1;
+    }
+
+    float in[BLOCK_SIZE], out[BLOCK_SIZE], frames[2 * BLOCK_SIZE];
+    complex_float out_complex[BLOCK_SIZE];
+    float max_diff_block = 0.0f, max_diff_multi = 0.0f;
+    for (int offset = 0; offset < length; offset += BLOCK_SIZE) {
+        int n = (length - offset < BLOCK_SIZE) ? length - offset : BLOCK_SIZE;
+        for (int i = 0; i < n; i++) {
+            in[i] = signal[offset + i].real;
+            frames[2 * i] = signal[offset + i].real;
+            frames[2 * i + 1] = signal[offset + i].imag;
+        }
+        iir_filter_process_block(&iir_block, in, out, n);
+        iir_filter_process_interleaved(&iir_multi, frames, frames, n);
+        ciir_filter_process_block(&iir_complex, signal + offset, out_complex, n);
+        for (int i = 0; i < n; i++) {
+            float diff = fabsf(out[i] - iir_filter_process(&iir_sample, in[i]));
+            if (diff > max_diff_block) max_diff_block = diff;
+            diff = fmaxf(fabsf(frames[2 * i] - out_complex[i].real),
+                         fabsf(frames[2 * i + 1] - out_complex[i].imag));
+            if (diff > max_diff_multi) max_diff_multi = diff;
+        }
+    }
+
+    int failed = max_diff_block > IIR_MODES_TOLERANCE || max_diff_multi > IIR_MODES_TOLERANCE;
+    printf("\n[IIR] Блочная обработка: макс. отклонение от поотсчетной %.3g%s\n", max_diff_block,
+           max_diff_block <= IIR_MODES_TOLERANCE ? "" : " (РАСХОЖДЕНИЕ)");
+    printf("[IIR] Чередующиеся каналы I/Q: макс. отклонение от ciir_filter %.3g%s\n",
+           max_diff_multi, max_diff_multi <= IIR_MODES_TOLERANCE ? "" : " (РАСХОЖДЕНИЕ)");
+
+    iir_filter_free(&iir_sample);
+    iir_filter_free(&iir_block);
+    iir_filter_free(&iir_multi);
+    ciir_filter_free(&iir_complex);
+    return failed;
+}
+
+// Поотсчетный LMS, блочный LMS и FDAF на идентификации неизвестного КИХ
+// (белый гауссов вход единичной мощности, опорный сигнал - выход КИХ плюс
+// шум): при одном mu установившаяся ошибка должна совпадать, а блочный LMS
+// и FDAF с одинаковым блоком - совпадать друг с другом. На сигнале QPSK
+// поотсчетный LMS отслеживает несущую внутри символа, и блочные варианты
+// с весами, замороженными на блок, с ним не сравнимы. Длины до
+// LMS_LONG_LENGTH: на длинных фильтрах FDAF (O(log N) на отсчет) обгоняет
+// варианты с O(N) на отсчет.
+int check_lms_variants(void) {
+    const char* names[] = {"поотсчетный LMS", "блочный LMS", "FDAF"};
+    const int lengths[] = {LMS_LENGTH, 512, LMS_LONG_LENGTH};
+    const int num_lengths = (int)(sizeof(lengths) / sizeof(lengths[0]));
+    const int n = LMS_ID_SAMPLES;
+    float* in = malloc(n * sizeof(float));
+    float* ref = malloc(n * sizeof(float));
+    float* out = malloc(n * sizeof(float));
+    float* noise = malloc(n * sizeof(float));
+    float* plant = malloc(LMS_LONG_LENGTH * sizeof(float));
+    if (!in || !ref || !out || !noise || !plant) {
+        free(in);
+        free(ref);
+        free(out);
+        free(noise);
+        free(plant);
+        return 1;
+    }
+    int failed = 0;
+    rng_state rng;
+    rng_init(&rng, RNG_SEED + 3);
+    rng_normal_block(&rng, in, n, 1.0f);
+    rng_normal_block(&rng, noise, n, LMS_ID_NOISE);
+
+    for (int l = 0; l < num_lengths; l++) {
+        int length = lengths[l];
+        // Неизвестный КИХ с единичной энергией: выход той же мощности, что вход
+        for (int i = 0; i < length; i++) plant[i] = rng_uniform(&rng) - 0.5f;
+        double energy = 0.0;
+        for (int i = 0; i < length; i++) energy += plant[i] * plant[i];
+        for (int i = 0; i < length; i++) plant[i] = (float)(plant[i] / sqrt(energy));
+        for (int t = 0; t < n; t++) {
+            double acc = 0.0;
+            for (int i = 0; i < length && i <= t; i++) acc += plant[i] * in[t - i];
+            ref[t] = (float)acc + noise[t];
+        }
+
+        // mu * length * P = LMS_ID_STEP при мощности входа P = 1
+        float mu = LMS_ID_STEP / length;
+        double floor = (double)LMS_ID_NOISE * LMS_ID_NOISE;
+        double mse[3] = {0.0, 0.0, 0.0};
+        printf("\n[LMS] Идентификация КИХ: длина %d, mu = %g, шум %.1e:\n", length, mu, floor);
+        for (int variant = 0; variant < 3; variant++) {
+            lms_filter lms;
+            fdaf_filter fdaf;
+            // Блок блочного LMS равен блоку FDAF: тогда алгоритмы совпадают
+            int ok = fdaf_filter_init(&fdaf, length, mu) == 0;
+            int block = fdaf.block_size;
+            if (ok && variant < 2) {
+                fdaf_filter_free(&fdaf);
+                ok = lms_filter_init_block(&lms, length, mu, variant == 0 ? 1 : block) == 0;
+            }
+            if (!ok) {
+                printf("  Ошибка инициализации: %s\n", names[variant]);
+                failed = 1;
+                continue;
+            }
+
+            uint64_t start = bench_now_ns();
+            for (int offset = 0; offset < n; offset += BLOCK_SIZE) {
+                int m = (n - offset < BLOCK_SIZE) ? n - offset : BLOCK_SIZE;
+                if (variant == 2) {
+                    fdaf_filter_process_block(&fdaf, in + offset, ref + offset, out + offset, m);
+                } else {
+                    lms_filter_process_block(&lms, in + offset, ref + offset, out + offset, m);
+                }
+            }
+            double elapsed = bench_elapsed(start);
+
+            // Установившаяся ошибка - по последней четверти
+            int tail = n / 4;
+            for (int t = n - tail; t < n; t++) {
+                double e = ref[t] - out[t];
+                mse[variant] += e * e;
+            }
+            mse[variant] /= tail;
+            printf("  %-16s: %.2f млн отсчетов/сек, MSE %.3e (%.2f от шума)\n", names[variant],
+                   n / elapsed / 1e6, mse[variant], mse[variant] / floor);
+            if (variant == 2) {
+                fdaf_filter_free(&fdaf);
+            } else {
+                lms_filter_free(&lms);
+            }
+        }
+
+        // Сходимость до уровня шума с рассогласованием и совпадение вариантов
+        int converged = mse[0] < LMS_ID_TOLERANCE * floor;
+        int same = fabs(mse[1] / mse[0] - 1.0) < LMS_ID_MATCH &&
+                   fabs(mse[2] / mse[1] - 1.0) < LMS_ID_MATCH;
+        printf("  %s\n", converged && same ? "OK: установившаяся ошибка совпадает"
+                                          : "ОШИБКА: варианты расходятся или не сошлись");
+        failed |= !(converged && same);
+    }
+
+    free(in);
+    free(ref);
+    free(out);
+    free(noise);
+    free(plant);
+    return failed;
+}
+
+// Сравнение классического RLS O(N^2) и решетчатого O(N) на начальном
+// отрезке сигнала: скорость, MSE на последних 10% и BER по I/Q
+int check_rls_variants(const complex_float* signal, const complex_float* desired, int length,
+    const qpsk_params* params, const uint8_t* original_bits, int num_bits) {
+    const char* names[] = {"RLS O(N^2)", "решетчатый RLS"};
+    if (length > RLS_CHECK_SAMPLES) {
+        length = RLS_CHECK_SAMPLES;
+    }
+    float* in = malloc(2 * length * sizeof(float));
+    float* ref = malloc(2 * length * sizeof(float));
+    float* out = malloc(2 * 2 * length * sizeof(float));
+    complex_float* filtered = malloc(length * sizeof(complex_float));
+    if (!in || !ref || !out || !filtered) {
+        free(in);
+        free(ref);
+        free(out);
+        free(filtered);
+        return 1;
+    }
+    for (int i = 0; i < length; i++) {
+        in[i] = signal[i].real;
+        in[length + i] = signal[i].imag;
+        ref[i] = desired[i].real;
+        ref[length + i] = desired[i].imag;
+    }
+
+    printf("\n[RLS] Сравнение вариантов (длина %d, lambda = %g, %d отсчетов):\n",
+           RLS_LENGTH, RLS_LAMBDA, length);
+    int failed = 0;
+    for (int variant = 0; variant < 2; variant++) {
+        rls_mode mode = variant == 0 ? RLS_MODE_STANDARD : RLS_MODE_LATTICE;
+        float* y = out + variant * 2 * length;
+        rls_filter rls[2];
+        if (rls_filter_init_mode(&rls[0], RLS_LENGTH, RLS_LAMBDA, RLS_DELTA, mode) != 0 ||
+            rls_filter_init_mode(&rls[1], RLS_LENGTH, RLS_LAMBDA, RLS_DELTA, mode) != 0) {
+            printf("  Ошибка инициализации: %s\n", names[variant]);
+            failed = 1;
+            continue;
+        }
+
+        uint64_t start = bench_now_ns();
+        for (int c = 0; c < 2; c++) {
+            rls_filter_process_block(&rls[c], in + c * length, ref + c * length,
+                                     y + c * length, length);
+        }
+        double elapsed = bench_elapsed(start);
+
+        double mse = 0.0;
+        int tail = length / 10;
+        for (int i = length - tail; i < length; i++) {
+            double er = ref[i] - y[i], ei = ref[length + i] - y[length + i];
+            mse += er * er + ei * ei;
+        }
+        for (int i = 0; i < length; i++) {
+            filtered[i].real = y[i];
+            filtered[i].imag = y[length + i];
+        }
+
+        int demod_bits_count;
+        complex_float* constellation;
+        uint8_t* decoded_bits = qpsk_demodulate(filtered, length, params, 0,
+                                                &demod_bits_count, &constellation);
+        float ber = -1.0f;
+        if (decoded_bits) {
+            int compare_length = (num_bits < demod_bits_count) ? num_bits : demod_bits_count;
+            ber = calculate_ber(original_bits, decoded_bits, compare_length);
+            free(decoded_bits);
+            free(constellation);
+        }
+
+        printf("  %-16s: %.2f млн отсчетов/сек, MSE %.3e, BER %.6f, сбросов %d\n",
+               names[variant], length / elapsed / 1e6, mse / tail, ber,
+               rls[0].rescues + rls[1].rescues);
+
+        rls_filter_free(&rls[0]);
+        rls_filter_free(&rls[1]);
+    }
+
+    float max_diff = 0.0f;
+    for (int i = length - length / 10; i < length; i++) {
+        float diff = fmaxf(fabsf(out[i] - out[2 * length + i]),
+                           fabsf(out[length + i] - out[3 * length + i]));
+        if (diff > max_diff) max_diff = diff;
+    }
+    printf("  Макс. расхождение выходов на последних 10%%: %.3g%s\n", max_diff,
+           max_diff <= RLS_MATCH_TOLERANCE ? "" : " (РАСХОЖДЕНИЕ)");
+
+    free(in);
+    free(ref);
+    free(out);
+    free(filtered);
+    return failed || !(max_diff <= RLS_MATCH_TOLERANCE);
+}
+
+// Банк BANK_CHANNELS каналов против поканальной обработки отдельными
+// фильтрами: время и максимальное расхождение выходов
+int check_filter_bank(const complex_float* signal, const complex_float* desired, int length) {
+    const char* names[] = {"FIR", "IIR", "LMS"};
+    int n = (length < BANK_SAMPLES) ? length : BANK_SAMPLES;
+    int K = BANK_CHANNELS;
+    float* data = malloc((size_t)4 * K * n * sizeof(float));
+    if (!data) {
+        return 1;
+    }
+    float* ref_data = data + (size_t)K * n;
+    float* out_bank = data + (size_t)2 * K * n;
+    float* out_single = data + (size_t)3 * K * n;
+    const float* in[BANK_CHANNELS];
+    const float* ref[BANK_CHANNELS];
+    float* yb[BANK_CHANNELS];
+    float* ys[BANK_CHANNELS];
+    // Каналы - разные участки I и Q составляющих сигнала
+    for (int c = 0; c < K; c++) {
+        for (int i = 0; i < n; i++) {
+            int at = (i + c * 997) % length;
+            data[(size_t)c * n + i] = (c & 1) ? signal[at].imag : signal[at].real;
+            ref_data[(size_t)c * n + i] = (c & 1) ? desired[at].imag : desired[at].real;
+        }
+        in[c] = data + (size_t)c * n;
+        ref[c] = ref_data + (size_t)c * n;
+        yb[c] = out_bank + (size_t)c * n;
+        ys[c] = out_single + (size_t)c * n;
+    }
+
+    printf("\n[Банк фильтров] %d каналов по %d отсчетов:\n", K, n);
+    int failed = 0;
+    for (int type = FILTER_BANK_FIR; type <= FILTER_BANK_LMS; type++) {
+        filter_bank bank;
+        int status;
+        if (type == FILTER_BANK_FIR) {
+            status = filter_bank_init_fir(&bank, K, fir_coeff, FIR_NUMTAPS);
+        } else if (type == FILTER_BANK_IIR) {
+            status = filter_bank_init_iir_sos(&bank, K, iir_sos, IIR_SECTIONS);
+        } else {
+            status = filter_bank_init_lms(&bank, K, LMS_LENGTH, LMS_MU);
+        }
+        if (status != 0) {
+            printf("  Ошибка инициализации банка %s\n", names[type]);
+            failed = 1;
+            continue;
+        }
+
+        uint64_t start = bench_now_ns();
+        status = filter_bank_process_adaptive(&bank, in, ref, yb, n);
+        double bank_time = bench_elapsed(start);
+        if (type == FILTER_BANK_LMS && filter_bank_process(&bank, in, yb, n) != -1) {
+            status = -1;
+        }
+        filter_bank_free(&bank);
+        if (status != 0) {
+            printf("  Ошибка обработки банком %s\n", names[type]);
+            failed = 1;
+            continue;
+        }
+
+        start = bench_now_ns();
+        for (int c = 0; c < K; c++) {
+            if (type == FILTER_BANK_FIR) {
+                fir_filter fir;
+                if (fir_filter_init(&fir, fir_coeff, FIR_NUMTAPS) != 0) break;
+                fir_filter_process_block(&fir, in[c], ys[c], n);
+                fir_filter_free(&fir);
+            } else if (type == FILTER_BANK_IIR) {
+                iir_filter iir;
+                if (iir_filter_init_sos(&iir, iir_sos, IIR_SECTIONS) != 0) break;
+                iir_filter_process_block(&iir, in[c], ys[c], n);
+                iir_filter_free(&iir);
+            } else {
+                lms_filter lms;
+                if (lms_filter_init(&lms, LMS_LENGTH, LMS_MU) != 0) break;
+                lms_filter_process_block(&lms, in[c], ref[c], ys[c], n);
+                lms_filter_free(&lms);
+            }
+        }
+        double single_time = bench_elapsed(start);
+
+        float max_diff = 0.0f;
+        for (size_t i = 0; i < (size_t)K * n; i++) {
+            float diff = fabsf(out_bank[i] - out_single[i]);
+            if (diff > max_diff) max_diff = diff;
+        }
+        printf("  %s: банк %.2f, поканально %.2f млн отсчетов/сек, макс. расхождение %.3g%s\n",
+               names[type], (double)K * n / bank_time / 1e6,
+               (double)K * n / single_time / 1e6, max_diff,
+               max_diff <= BANK_TOLERANCE ? "" : " (РАСХОЖДЕНИЕ)");
+        failed |= !(max_diff <= BANK_TOLERANCE);
+    }
+
+    free(data);
+    return failed;
+}
+
+// Генератор несущей: погрешность относительно cos/sin в double от точной
+// фазы аккумулятора и скорость против поотсчетных cosf/sinf
+int check_oscillator(void) {
+    int n = OSC_CHECK_SAMPLES;
+    complex_float* out = malloc(n * sizeof(complex_float));
+    oscillator osc;
+    if (!out || oscillator_init(&osc, F_CENTER, FS) != 0) {
+        printf("Ошибка инициализации генератора\n");
+        free(out);
+        return 1;
+    }
+    uint32_t step = osc.step;
+    memset(out, 0, n * sizeof(complex_float));
+
+    uint64_t start = bench_now_ns();
+    for (int offset = 0; offset < n; offset += BLOCK_SIZE) {
+        int m = (n - offset < BLOCK_SIZE) ? n - offset : BLOCK_SIZE;
+        oscillator_generate(&osc, out + offset, m);
+    }
+    double osc_time = bench_elapsed(start);
+
+    double max_err = 0.0;
+    for (int i = 0; i < n; i++) {
+        double angle = 2 * M_PI * ((uint32_t)(step * (uint32_t)i) / 4294967296.0);
+        double err = hypot(out[i].real - cos(angle), out[i].imag - sin(angle));
+        if (err > max_err) max_err = err;
+    }
+
+    // Прежний способ: cosf/sinf от фазы с плавающей точкой
+    float phase = 0.0f;
+    float phase_inc = 2 * M_PI * F_CENTER / FS;
+    start = bench_now_ns();
+    for (int i = 0; i < n; i++) {
+        out[i].real = cosf(phase);
+        out[i].imag = sinf(phase);
+        phase += phase_inc;
+        if (phase > 2 * M_PI) phase -= 2 * M_PI;
+    }
+    double trig_time = bench_elapsed(start);
+    double drift = 0.0;
+    {
+        double exact = fmod(2 * M_PI * ((double)F_CENTER / FS) * n, 2 * M_PI);
+        drift = fabs(remainder(phase - exact, 2 * M_PI));
+    }
+
+    double f_quant = (double)step / 4294967296.0 * FS;
+    printf("\n[Генератор] %d отсчетов, частота %.0f Гц (ошибка квантования %.3f Гц):\n",
+           n, (double)F_CENTER, fabs(f_quant - F_CENTER));
+    printf("  Фазор с аккумулятором: %.2f млн отсчетов/сек, макс. погрешность %.3g%s\n",
+           n / osc_time / 1e6, max_err, max_err <= OSC_TOLERANCE ? "" : " (ОШИБКА)");
+    printf("  cosf/sinf: %.2f млн отсчетов/сек, уход фазы к концу %.3g рад\n",
+           n / trig_time / 1e6, drift);
+
+    free(out);
+    return max_err <= OSC_TOLERANCE ? 0 : 1;
+}
+
+// Генератор нормального шума: моменты распределения, доля выбросов за 3
+// сигмы (теоретически 0.0027) и скорость против прежней суммы 12 rand()
+int check_noise_generator(void) {
+    int n = NOISE_CHECK_SAMPLES;
+    float* noise = malloc(n * sizeof(float));
+    if (!noise) {
+        return 1;
+    }
+    memset(noise, 0, n * sizeof(float));
+    rng_state rng;
+    rng_init(&rng, RNG_SEED);
+
+    uint64_t start = bench_now_ns();
+    for (int offset = 0; offset < n; offset += BLOCK_SIZE) {
+        int m = (n - offset < BLOCK_SIZE) ? n - offset : BLOCK_SIZE;
+        rng_normal_block(&rng, noise + offset, m, 1.0f);
+    }
+    double normal_time = bench_elapsed(start);
+
+    double mean = 0.0, var = 0.0, kurt = 0.0;
+    int outliers = 0;
+    for (int i = 0; i < n; i++) {
+        mean += noise[i];
+    }
+    mean /= n;
+    for (int i = 0; i < n; i++) {
+        double d = noise[i] - mean;
+        var += d * d;
+        kurt += d * d * d * d;
+        outliers += fabs(d) > 3.0;
+    }
+    var /= n;
+    kurt = kurt / n / (var * var);
+
+    // Прежний способ: сумма 12 равномерных rand()
+    start = bench_now_ns();
+    for (int i = 0; i < n; i++) {
+        float sum = 0.0f;
+        for (int j = 0; j < 12; j++) {
+            sum += (float)rand() / RAND_MAX - 0.5f;
+        }
+        noise[i] = sum;
+    }
+    double rand_time = bench_elapsed(start);
+
+    int ok = fabs(mean) <= NOISE_TOLERANCE && fabs(var - 1.0) <= NOISE_TOLERANCE &&
+             fabs(kurt / 3.0 - 1.0) <= NOISE_TOLERANCE;
+    printf("\n[Шум] %d нормальных отсчетов: среднее %.2e, дисперсия %.4f, эксцесс %.3f, "
+           "за 3 сигмы %.5f%s\n", n, mean, var, kurt, (double)outliers / n,
+           ok ? "" : " (ОШИБКА)");
+    printf("  Бокс - Мюллер (xoshiro256**): %.2f млн отсчетов/сек, 12 x rand(): %.2f\n",
+           n / normal_time / 1e6, n / rand_time / 1e6);
+
+    free(noise);
+    return ok ? 0 : 1;
+}
+
+// Относительное отклонение от эталона: max|a - ref| / max|ref|
+static double dispatch_deviation(const float* a, const float* ref, int n) {
+    double diff = 0.0, peak = 0.0;
+    for (int i = 0; i < n; i++) {
+        double d = fabs((double)a[i] - ref[i]);
+        if (d > diff) diff = d;
+        if (fabs(ref[i]) > peak) peak = fabs(ref[i]);
+    }
+    return peak > 0.0 ? diff / peak : diff;
+}
+
+// Ядра всех наборов команд, доступных процессору, против скалярных на одних
+// данных: свертки, LMS, биквады и генератор - в пределах округления,
+// решения демаппера, LLR и ядра Q15 - побитово. Скорость - свертка
+// DISPATCH_CHECK_TAPS отводов (float и Q15) и перенос частоты
+int check_dispatch(void) {
+    const char* env = getenv(DSP_ISA_ENV);
+    int status = dsp_dispatch_init();
+    printf("\n[Диспетчер] Процессор: %s, выбрано: %s", dsp_isa_name(dsp_dispatch_detect()),
+           dsp_isa_name(dsp_dispatch_isa()));
+    if (status == -1) {
+        printf(" (DSP_ISA=%s не распознан)", env);
+    } else if (status == -2) {
+        printf(" (DSP_ISA=%s не поддерживается процессором)", env);
+    }
+    printf("\n");
+
+    int n = DISPATCH_CHECK_SAMPLES;
+    int taps = DISPATCH_CHECK_TAPS;
+    complex_float* x = malloc((n + taps) * sizeof(complex_float));
+    complex_float* ref = malloc(n * sizeof(complex_float));
+    complex_float* out = malloc(n * sizeof(complex_float));
+    float* h = malloc(2 * taps * sizeof(float));
+    float* w_ref = malloc(2 * taps * sizeof(float));
+    float* w = malloc(2 * taps * sizeof(float));
+    int16_t* x_q = malloc(2 * (n + taps) * sizeof(int16_t));
+    int16_t* h_q = malloc(taps * sizeof(int16_t));
+    int32_t* ref_q = malloc(n * sizeof(int32_t));
+    int32_t* out_q = malloc(n * sizeof(int32_t));
+    if (!x || !ref || !out || !h || !w_ref || !w || !x_q || !h_q || !ref_q || !out_q) {
+        printf("Ошибка выделения памяти\n");
+        free(x);
+        free(ref);
+        free(out);
+        free(h);
+        free(w_ref);
+        free(w);
+        free(x_q);
+        free(h_q);
+        free(ref_q);
+        free(out_q);
+        return 1;
+    }
+    rng_state rng;
+    rng_init(&rng, RNG_SEED);
+    for (int i = 0; i < n + taps; i++) {
+        x[i].real = rng_uniform(&rng) - 0.5f;
+        x[i].imag = rng_uniform(&rng) - 0.5f;
+    }
+    for (int i = 0; i < 2 * taps; i++) {
+        h[i] = (rng_uniform(&rng) - 0.5f) / taps;
+    }
+    // Q15: вход на половине шкалы, коэффициенты с суммой модулей меньше 1
+    fixed_float_to_q15((const float*)x, x_q, 2 * (n + taps), 1.0f, FIXED_ROUND_NEAREST);
+    fixed_quantize16(h, h_q, taps, 17, FIXED_ROUND_NEAREST, NULL);
+    iir_q15_filter iir_q;
+    if (iir_q15_filter_init_sos(&iir_q, active_coeffs.sos, active_coeffs.iir_sections,
+                                FIXED_ROUND_CONVERGENT) != 0) {
+        iir_q.coeffs = NULL;
+    }
+    // Две секции с полюсами внутри единичного круга
+    const float sos[10] = {0.2f, 0.4f, 0.2f, -0.6f, 0.2f, 0.3f, 0.0f, -0.3f, -0.9f, 0.5f};
+    float state[8];
+    const float* xf = (const float*)x;
+    const dsp_kernels* scalar = dsp_dispatch_table(DSP_ISA_SCALAR);
+    int failed = !iir_q.coeffs;
+
+    for (int isa = 0; isa < DSP_ISA_COUNT; isa++) {
+        const dsp_kernels* k = dsp_dispatch_table((dsp_isa)isa);
+        if (!k) {
+            printf("  %-7s не поддерживается\n", dsp_isa_name((dsp_isa)isa));
+            continue;
+        }
+        double dev = 0.0, d;
+        int exact = 1;
+
+        // Свертки: по окну на отсчет
+        for (int i = 0; i < n; i++) {
+            ref[i].real = scalar->dot(h, &xf[i], taps);
+            out[i].real = k->dot(h, &xf[i], taps);
+            scalar->dot_real_complex(h, &xf[2 * i], taps / 2, &ref[i].imag);
+            k->dot_real_complex(h, &xf[2 * i], taps / 2, &out[i].imag);
+        }
+        d = dispatch_deviation((const float*)out, (const float*)ref, 2 * n);
+        if (d > dev) dev = d;
+
+        // Комплексный LMS: выход и обновление весов
+        memset(w_ref, 0, 2 * taps * sizeof(float));
+        memset(w, 0, 2 * taps * sizeof(float));
+        for (int i = 0; i < n / 16; i++) {
+            float y_ref[2], y[2];
+            scalar->cdot_conj(w_ref, &xf[2 * i], taps, y_ref);
+            k->cdot_conj(w, &xf[2 * i], taps, y);
+            scalar->caxpy(w_ref, &xf[2 * i], taps, 0.01f * (x[i].real - y_ref[0]),
+                          -0.01f * (x[i].imag - y_ref[1]));
+            k->caxpy(w, &xf[2 * i], taps, 0.01f * (x[i].real - y[0]), -0.01f * (x[i].imag - y[1]));
+            scalar->axpy(w_ref, &xf[2 * i], 2 * taps, 1e-4f);
+            k->axpy(w, &xf[2 * i], 2 * taps, 1e-4f);
+        }
+        d = dispatch_deviation(w, w_ref, 2 * taps);
+        if (d > dev) dev = d;
+
+        // Биквады: вещественный каскад по составляющим и комплексный
+        memcpy(ref, x, n * sizeof(complex_float));
+        memcpy(out, x, n * sizeof(complex_float));
+        memset(state, 0, sizeof(state));
+        scalar->biquad(sos, state, 2, (float*)ref, 2 * n);
+        memset(state, 0, sizeof(state));
+        k->biquad(sos, state, 2, (float*)out, 2 * n);
+        d = dispatch_deviation((const float*)out, (const float*)ref, 2 * n);
+        if (d > dev) dev = d;
+        memset(state, 0, sizeof(state));
+        scalar->cbiquad(sos, state, 2, ref, n);
+        memset(state, 0, sizeof(state));
+        k->cbiquad(sos, state, 2, out, n);
+        d = dispatch_deviation((const float*)out, (const float*)ref, 2 * n);
+        if (d > dev) dev = d;
+
+        // Перенос частоты
+        oscillator osc_ref, osc;
+        oscillator_init(&osc_ref, F_CENTER, FS);
+        oscillator_init(&osc, F_CENTER, FS);
+        scalar->oscillator(&osc_ref, x, ref, n, -1);
+        k->oscillator(&osc, x, out, n, -1);
+        d = dispatch_deviation((const float*)out, (const float*)ref, 2 * n);
+        if (d > dev) dev = d;
+
+        // Демаппер: слова решений и LLR
+        for (int i = 0; i + 32 <= n; i += 32) {
+            exact &= scalar->demap_word(&x[i]) == k->demap_word(&x[i]);
+        }
+        scalar->demap_llr(x, n - 3, 2.5f, (float*)ref);
+        k->demap_llr(x, n - 3, 2.5f, (float*)out);
+        exact &= memcmp(ref, out, 2 * (n - 3) * sizeof(float)) == 0;
+
+        // Q15: свертки по окну и блоком, каскад секций iir_q15_filter
+        for (int i = 0; i < n; i++) {
+            ref_q[i] = scalar->dot_q15(h_q, &x_q[i], taps);
+        }
+        k->fir_q15(h_q, x_q, taps, out_q, n);
+        exact &= memcmp(ref_q, out_q, n * sizeof(int32_t)) == 0;
+        exact &= k->dot_q15(h_q, x_q, taps - 3) == scalar->dot_q15(h_q, x_q, taps - 3);
+        if (iir_q.coeffs) {
+            for (int i = 0; i < n; i++) {
+                ref_q[i] = out_q[i] = (int32_t)x_q[i] * (1 << (16 - IIR_Q15_GUARD_BITS));
+            }
+            int sections = iir_q.num_sections;
+            memset(iir_q.state, 0, 4 * sections * sizeof(int32_t));
+            long long sat_ref = scalar->biquad_q15(iir_q.coeffs, iir_q.state, sections, ref_q, n,
+                                                   FIXED_ROUND_CONVERGENT);
+            memset(iir_q.state, 0, 4 * sections * sizeof(int32_t));
+            long long sat = k->biquad_q15(iir_q.coeffs, iir_q.state, sections, out_q, n,
+                                          FIXED_ROUND_CONVERGENT);
+            exact &= sat == sat_ref && memcmp(ref_q, out_q, n * sizeof(int32_t)) == 0;
+        }
+
+        // Скорость
+        uint64_t start = bench_now_ns();
+        for (int i = 0; i < n; i++) {
+            out[i].real = k->dot(h, &xf[i], taps);
+        }
+        double dot_time = bench_elapsed(start);
+        start = bench_now_ns();
+        k->fir_q15(h_q, x_q, taps, out_q, n);
+        double dot_q15_time = bench_elapsed(start);
+        oscillator_init(&osc, F_CENTER, FS);
+        start = bench_now_ns();
+        for (int offset = 0; offset < n; offset += BLOCK_SIZE / 4) {
+            k->oscillator(&osc, x + offset, out + offset, BLOCK_SIZE / 4, -1);
+        }
+        double mix_time = bench_elapsed(start);
+
+        printf("  %-7s отклонение от scalar %.2e%s, демаппер и Q15 %s; свертка %d отводов "
+               "%.1f (Q15 %.1f) млн отсчетов/сек, перенос %.1f млн отсчетов/сек\n",
+               dsp_isa_name((dsp_isa)isa), dev, dev <= DISPATCH_TOLERANCE ? "" : " (РАСХОЖДЕНИЕ)",
+               exact ? "совпадают" : "РАСХОЖДЕНИЕ", taps,
+               n / dot_time / 1e6, n / dot_q15_time / 1e6, n / mix_time / 1e6);
+        failed |= !exact || !(dev <= DISPATCH_TOLERANCE);
+    }
+
+    if (iir_q.coeffs) {
+        iir_q15_filter_free(&iir_q);
+    }
+    free(x);
+    free(ref);
+    free(out);
+    free(h);
+    free(w_ref);
+    free(w);
+    free(x_q);
+    free(h_q);
+    free(ref_q);
+    free(out_q);
+    return failed;
+}
+
+// Потоковый демодулятор блоками разной длины против qpsk_demodulate
+// для всего сигнала: результат должен совпадать побитно
+int check_streaming_demod(const complex_float* signal, int length, const qpsk_params* params) {
+    int delay = FIR_NUMTAPS / 2;
+    int num_bits;
+    complex_float* constellation;
+    uint8_t* bits = qpsk_demodulate(signal, length, params, delay, &num_bits, &constellation);
+    uint8_t* stream_bits = malloc(num_bits + 2 * QPSK_DEMOD_FLUSH_MAX);
+    complex_float* stream_points = malloc((num_bits / 2 + QPSK_DEMOD_FLUSH_MAX) * sizeof(complex_float));
+    qpsk_demodulator dem;
+    if (!bits || !stream_bits || !stream_points ||
+        qpsk_demodulator_init(&dem, params, delay) != 0) {
+        printf("Ошибка инициализации потокового демодулятора\n");
+        free(bits);
+        free(stream_bits);
+        free(stream_points);
+        return 1;
+    }
+
+    int symbols = 0;
+    int offset = 0;
+    for (int chunk = 1; offset < length; chunk = chunk * 7 % (BLOCK_SIZE - 1) + 1) {
+        int n = (length - offset < chunk) ? length - offset : chunk;
+        symbols += qpsk_demodulator_push(&dem, signal + offset, n, stream_bits + 2 * symbols,
+                                         stream_points + symbols);
+        offset += n;
+    }
+    symbols += qpsk_demodulator_flush(&dem, stream_bits + 2 * symbols, stream_points + symbols);
+    qpsk_demodulator_free(&dem);
+
+    int match = 2 * symbols == num_bits &&
+                memcmp(bits, stream_bits, num_bits) == 0 &&
+                memcmp(constellation, stream_points, symbols * sizeof(complex_float)) == 0;
+    printf("\n[Демодулятор] Потоковая обработка блоками: %s (%d символов)\n",
+           match ? "совпадает с qpsk_demodulate" : "РАСХОЖДЕНИЕ", symbols);
+
+    free(bits);
+    free(constellation);
+    free(stream_bits);
+    free(stream_points);
+    return match ? 0 : 1;
+}
+
+// Упакованные биты против побайтовых: генерация, модуляция, решения
+// демодулятора и подсчет ошибок должны совпадать; сравнивается скорость
+int check_packed_bits(const complex_float* signal, int length, const qpsk_params* params) {
+    long long n = PACKED_CHECK_BITS;
+    int mod_bits = NUM_BITS;
+    int delay = FIR_NUMTAPS / 2;
+    int num_bits = 0, tx_length = 0;
+    complex_float* constellation = NULL;
+    uint8_t* bits = malloc(n);
+    uint8_t* other = malloc(n);
+    uint64_t* words = malloc(packed_words(n) * sizeof(uint64_t));
+    uint64_t* other_words = malloc(packed_words(n) * sizeof(uint64_t));
+    complex_float* tx_packed = malloc((size_t)mod_bits / 2 * params->samples_per_sym *
+                                      sizeof(complex_float));
+    complex_float* points = malloc((length / params->samples_per_sym + 1 + QPSK_DEMOD_FLUSH_MAX) *
+                                   sizeof(complex_float));
+    oscillator carrier;
+    qpsk_demodulator dem;
+    if (!bits || !other || !words || !other_words || !tx_packed || !points) {
+        printf("Ошибка выделения памяти для упакованных бит\n");
+        free(bits);
+        free(other);
+        free(words);
+        free(other_words);
+        free(tx_packed);
+        free(points);
+        return 1;
+    }
+
+    // Генерация: одно состояние - одни и те же биты
+    rng_state rng;
+    rng_init(&rng, RNG_SEED);
+    uint64_t start = bench_now_ns();
+    rng_bits(&rng, bits, (int)n);
+    double byte_gen = bench_elapsed(start);
+    rng_init(&rng, RNG_SEED);
+    start = bench_now_ns();
+    rng_bits_packed(&rng, words, n);
+    double packed_gen = bench_elapsed(start);
+    packed_unpack(words, n, other);
+    int gen_match = memcmp(bits, other, n) == 0;
+
+    // Подсчет ошибок: вторая последовательность - первая с ошибками, сравнение
+    // со сдвигом, чтобы проверить и невыровненный путь
+    rng_init(&rng, RNG_SEED + 1);
+    for (long long i = 0; i < n; i++) {
+        other[i] = bits[i] ^ ((rng_next(&rng) & 63) == 0);
+    }
+    packed_pack(other, n, other_words);
+    long long shift = 3;
+    start = bench_now_ns();
+    long long byte_errors = 0;
+    for (long long i = 0; i < n - shift; i++) {
+        byte_errors += bits[i + shift] != other[i];
+    }
+    double byte_count = bench_elapsed(start);
+    start = bench_now_ns();
+    long long packed_errors = packed_count_errors(words, shift, other_words, 0, n - shift);
+    double packed_count = bench_elapsed(start);
+    long long aligned_errors = packed_count_errors(words, 0, other_words, 0, n);
+    long long aligned_check = 0;
+    for (long long i = 0; i < n; i++) {
+        aligned_check += bits[i] != other[i];
+    }
+
+    // Модуляция: таблица по упакованному полю против побайтовой
+    start = bench_now_ns();
+    complex_float* tx = qpsk_modulate(bits, mod_bits, params, &tx_length);
+    double byte_mod = bench_elapsed(start);
+    start = bench_now_ns();
+    int mod_ok = tx && oscillator_init(&carrier, params->f_center, params->fs) == 0;
+    if (mod_ok) {
+        qpsk_modulate_packed_block(words, 0, mod_bits, params, &carrier, tx_packed);
+    }
+    double packed_mod = bench_elapsed(start);
+    int mod_match = mod_ok && memcmp(tx, tx_packed, tx_length * sizeof(complex_float)) == 0;
+
+    // Решения демодулятора: упакованные против qpsk_demodulate
+    uint8_t* decoded = qpsk_demodulate(signal, length, params, delay, &num_bits, &constellation);
+    int demod_match = decoded && qpsk_demodulator_init(&dem, params, delay) == 0;
+    if (demod_match) {
+        int symbols = qpsk_demodulator_push_packed(&dem, signal, length, other_words, 0, points);
+        symbols += qpsk_demodulator_flush_packed(&dem, other_words, 2LL * symbols,
+                                                 points + symbols);
+        qpsk_demodulator_free(&dem);
+        packed_unpack(other_words, 2LL * symbols, other);
+        demod_match = 2 * symbols == num_bits && memcmp(decoded, other, num_bits) == 0;
+    }
+
+    printf("\n[Упакованные биты] %lld бит, по 64 в слове\n", n);
+    printf("  генерация: %s, %.1f против %.1f млн бит/сек (x%.1f)\n",
+           gen_match ? "совпадает с rng_bits" : "РАСХОЖДЕНИЕ",
+           n / packed_gen / 1e6, n / byte_gen / 1e6, byte_gen / packed_gen);
+    printf("  подсчет ошибок (XOR + popcount): %s, %.0f против %.0f млн бит/сек (x%.1f)\n",
+           packed_errors == byte_errors && aligned_errors == aligned_check
+               ? "совпадает" : "РАСХОЖДЕНИЕ",
+           (n - shift) / packed_count / 1e6, (n - shift) / byte_count / 1e6,
+           byte_count / packed_count);
+    printf("  модуляция по таблице: %s, %.1f против %.1f млн отсчетов/сек\n",
+           mod_match ? "совпадает" : "РАСХОЖДЕНИЕ",
+           tx_length / packed_mod / 1e6, tx_length / byte_mod / 1e6);
+    printf("  решения демодулятора: %s\n", demod_match ? "совпадают" : "РАСХОЖДЕНИЕ");
+    int failed = !gen_match || packed_errors != byte_errors || aligned_errors != aligned_check ||
+                 !mod_match || !demod_match;
+
+    free(bits);
+    free(other);
+    free(words);
+    free(other_words);
+    free(tx_packed);
+    free(points);
+    free(tx);
+    free(decoded);
+    free(constellation);
+    return failed;
+}
+
+// Полоса, в которой лежит 99% мощности сигнала (Гц): спектр усредняется
+// по отрезкам RRC_SPECTRUM_FFT отсчетов с окном Ханна, по 0.5% мощности
+// отсекается с каждого края
+static double occupied_bandwidth(const complex_float* signal, int length, float fs) {
+    int n = RRC_SPECTRUM_FFT;
+    fft_plan plan;
+    float* data = malloc(2 * n * sizeof(float));
+    double* power = calloc(n, sizeof(double));
+    if (!data || !power || fft_plan_init(&plan, n) != 0) {
+        free(data);
+        free(power);
+        return -1.0;
+    }
+
+    for (int offset = 0; offset + n <= length; offset += n) {
+        for (int i = 0; i < n; i++) {
+            float w = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / n);
+            data[2 * i] = signal[offset + i].real * w;
+            data[2 * i + 1] = signal[offset + i].imag * w;
+        }
+        fft_complex(&plan, data, 0);
+        for (int k = 0; k < n; k++) {
+            power[k] += (double)data[2 * k] * data[2 * k] + (double)data[2 * k + 1] * data[2 * k + 1];
+        }
+    }
+
+    double total = 0.0;
+    for (int k = 0; k < n; k++) {
+        total += power[k];
+    }
+    double sum = 0.0;
+    int low = 0, high = n - 1;
+    for (int k = 0; k < n; k++) {
+        sum += power[k];
+        if (sum < 0.005 * total) low = k + 1;
+        if (sum <= 0.995 * total) high = k + 1;
+    }
+    fft_plan_free(&plan);
+    free(data);
+    free(power);
+    return (double)(high - low + 1) * fs / n;
+}
+
+// Форма импульса RRC: полифазный модулятор против прямой свертки сигнала
+// с нулями между символами, занимаемая полоса против прямоугольного
+// импульса и точность согласованного фильтра без шума (EVM)
+int check_rrc_shaping(const qpsk_params* params) {
+    qpsk_params rrc = *params;
+    rrc.pulse = QPSK_PULSE_RRC;
+    rrc.rolloff = RRC_DEFAULT_ROLLOFF;
+    rrc.span = RRC_DEFAULT_SPAN;
+    int sps = rrc.samples_per_sym;
+    int num_symbols = RRC_CHECK_BITS / 2;
+    int length = rrc_pulse_length(sps, rrc.span, rrc.rolloff);
+    int tx_length = 0, rect_length = 0, num_bits = 0;
+    complex_float* constellation = NULL;
+
+    rng_state rng;
+    rng_init(&rng, RNG_SEED);
+    uint8_t* bits = generate_random_bits(RRC_CHECK_BITS, &rng);
+    float* taps = malloc(length * sizeof(float));
+    complex_float* direct = calloc((num_symbols + rrc.span) * (size_t)sps, sizeof(complex_float));
+    complex_float* stuffed = calloc((num_symbols + rrc.span) * (size_t)sps, sizeof(complex_float));
+    if (!bits || !taps || !direct || !stuffed || rrc_pulse_design(taps, sps, rrc.span, rrc.rolloff) != 0) {
+        printf("Ошибка инициализации проверки RRC\n");
+        free(bits);
+        free(taps);
+        free(direct);
+        free(stuffed);
+        return 1;
+    }
+
+    uint64_t start = bench_now_ns();
+    complex_float* tx = qpsk_modulate(bits, RRC_CHECK_BITS, &rrc, &tx_length);
+    double poly_time = bench_elapsed(start);
+    complex_float* rect = qpsk_modulate(bits, RRC_CHECK_BITS, params, &rect_length);
+
+    // Прямая свертка: символы через sps - 1 нулей, каждый отсчет - по всем
+    // length отводам импульса
+    float a = (float)(1.0 / M_SQRT2);
+    for (int i = 0; i < num_symbols; i++) {
+        // Gray: второй бит - знак I, первый - знак Q
+        stuffed[i * sps].real = bits[2 * i + 1] ? -a : a;
+        stuffed[i * sps].imag = bits[2 * i] ? -a : a;
+    }
+    oscillator carrier;
+    start = bench_now_ns();
+    for (int j = 0; j < tx_length; j++) {
+        complex_float acc = {0.0f, 0.0f};
+        for (int k = 0; k < length && k <= j; k++) {
+            acc.real += taps[k] * stuffed[j - k].real;
+            acc.imag += taps[k] * stuffed[j - k].imag;
+        }
+        direct[j] = acc;
+    }
+    if (oscillator_init(&carrier, rrc.f_center, rrc.fs) == 0) {
+        oscillator_mix(&carrier, direct, direct, tx_length);
+    }
+    double direct_time = bench_elapsed(start);
+
+    float max_error = 0.0f;
+    for (int j = 0; tx && j < tx_length; j++) {
+        float e = fmaxf(fabsf(tx[j].real - direct[j].real), fabsf(tx[j].imag - direct[j].imag));
+        if (e > max_error) max_error = e;
+    }
+
+    // Согласованный фильтр без шума: отклонение от переданных символов
+    start = bench_now_ns();
+    uint8_t* decoded = tx ? qpsk_demodulate(tx, tx_length, &rrc, 0, &num_bits, &constellation)
+                          : NULL;
+    double demod_time = bench_elapsed(start);
+    double error_power = 0.0, ref_power = 0.0;
+    for (int i = 0; decoded && i < num_bits / 2; i++) {
+        float dr = constellation[i].real - stuffed[i * sps].real;
+        float di = constellation[i].imag - stuffed[i * sps].imag;
+        error_power += (double)dr * dr + (double)di * di;
+        ref_power += 1.0;
+    }
+
+    printf("\n[RRC] Скругление %.2f, %d символов импульса (%d отводов, %d на фазу)\n",
+           rrc.rolloff, rrc.span, length, rrc.span + 1);
+    int failed = !tx || !rect || !decoded || !(max_error < RRC_TOLERANCE);
+    if (!tx || !rect || !decoded) {
+        printf("  Ошибка модуляции или демодуляции\n");
+    } else {
+        printf("  полифазный модулятор: %s (макс. ошибка %.2e), %.1f против %.1f млн отсчетов/сек (x%.1f)\n",
+               max_error < RRC_TOLERANCE ? "совпадает с прямой сверткой" : "РАСХОЖДЕНИЕ", max_error,
+               tx_length / poly_time / 1e6, tx_length / direct_time / 1e6, direct_time / poly_time);
+        printf("  полоса 99%% мощности: RRC %.1f МГц, прямоугольный %.1f МГц "
+               "(символьная скорость %.1f МГц)\n",
+               occupied_bandwidth(tx, tx_length, rrc.fs) / 1e6,
+               occupied_bandwidth(rect, rect_length, params->fs) / 1e6, rrc.fs / sps / 1e6);
+        printf("  согласованный фильтр: %d символов из %d, EVM %.3f%% (%.1f дБ), %.1f млн отсчетов/сек\n",
+               num_bits / 2, num_symbols, 100.0 * sqrt(error_power / ref_power),
+               10.0 * log10(error_power / ref_power + 1e-30), tx_length / demod_time / 1e6);
+    }
+
+    free(bits);
+    free(taps);
+    free(direct);
+    free(stuffed);
+    free(tx);
+    free(rect);
+    free(decoded);
+    free(constellation);
+    return failed;
+}
+
+// Решающее устройство по углу (квадранту) для сравнения с проверкой знаков
+static unsigned angle_slicer(complex_float s) {
+    float angle = atan2f(s.imag, s.real);
+    if (angle >= 0.0f && angle < (float)M_PI_2) {
+        return 0;  // (+,+)
+    } else if (angle >= (float)M_PI_2) {
+        return 2;  // (-,+)
+    } else if (angle < -(float)M_PI_2) {
+        return 3;  // (-,-)
+    }
+    return 1;      // (+,-)
+}
+
+// Демаппер на символах с белым шумом известной дисперсии: решения по знаку
+// против решений по углу, BER против теории, оценка шума M2M4 и LLR
+int check_demapper(void) {
+    int n = DEMAPPER_CHECK_SYMBOLS;
+    float noise_var = powf(10.0f, -DEMAPPER_CHECK_ESN0 / 10.0f);
+    float a = (float)(1.0 / M_SQRT2);
+    rng_state rng;
+    rng_init(&rng, RNG_SEED);
+    uint8_t* bits = generate_random_bits(2 * n, &rng);
+    uint8_t* hard = malloc(2 * (size_t)n);
+    uint8_t* angle = malloc(2 * (size_t)n);
+    uint64_t* words = malloc(packed_words(2LL * n) * sizeof(uint64_t));
+    float* llr = malloc(2 * (size_t)n * sizeof(float));
+    complex_float* symbols = malloc(n * sizeof(complex_float));
+    if (!bits || !hard || !angle || !words || !llr || !symbols) {
+        printf("Ошибка выделения памяти для проверки демаппера\n");
+        free(bits);
+        free(hard);
+        free(angle);
+        free(words);
+        free(llr);
+        free(symbols);
+        return 1;
+    }
+    for (int i = 0; i < n; i++) {
+        symbols[i].real = bits[2 * i + 1] ? -a : a;
+        symbols[i].imag = bits[2 * i] ? -a : a;
+    }
+    add_awgn(symbols, n, noise_var / 2.0f, &rng);
+
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < n; i++) {
+        unsigned pair = angle_slicer(symbols[i]);
+        angle[2 * i] = pair & 1;
+        angle[2 * i + 1] = pair >> 1;
+    }
+    double angle_time = bench_elapsed(start);
+    start = bench_now_ns();
+    qpsk_demapper_hard(symbols, n, hard);
+    double hard_time = bench_elapsed(start);
+    start = bench_now_ns();
+    qpsk_demapper_hard_packed(symbols, n, words, 0);
+    double packed_time = bench_elapsed(start);
+
+    qpsk_channel_estimate est;
+    start = bench_now_ns();
+    qpsk_demapper_estimate(symbols, n, &est);
+    qpsk_demapper_llr(symbols, n, &est, llr);
+    double llr_time = bench_elapsed(start);
+
+    long long errors = 0;
+    int packed_match = 1, llr_match = 1;
+    for (long long i = 0; i < 2LL * n; i++) {
+        errors += hard[i] != bits[i];
+        packed_match &= packed_get(words, i) == hard[i];
+        llr_match &= (llr[i] < 0.0f) == hard[i];
+    }
+    // Eb/N0 = Es/N0 / 2, BER = Q(sqrt(2 Eb/N0))
+    double theory = 0.5 * erfc(sqrt(pow(10.0, DEMAPPER_CHECK_ESN0 / 10.0) / 2.0));
+
+    int angle_match = memcmp(hard, angle, 2 * (size_t)n) == 0;
+    printf("\n[Демаппер] %d символов, Es/N0 %.1f дБ\n", n, DEMAPPER_CHECK_ESN0);
+    printf("  решения по знаку: %s, упакованные: %s\n",
+           angle_match ? "совпадают с решениями по углу" : "РАСХОЖДЕНИЕ",
+           packed_match ? "совпадают" : "РАСХОЖДЕНИЕ");
+    printf("  скорость: %.0f (байты), %.0f (слова) против %.0f млн символов/сек по atan2f\n",
+           n / hard_time / 1e6, n / packed_time / 1e6, n / angle_time / 1e6);
+    printf("  BER %.4e, теория %.4e\n", (double)errors / (2.0 * n), theory);
+    printf("  оценка M2M4: амплитуда %.4f (%.4f), шум %.4f (%.4f)\n",
+           est.amplitude, a, est.noise_var, noise_var);
+    printf("  LLR: знаки %s жестким решениям, %.0f млн символов/сек с оценкой\n",
+           llr_match ? "соответствуют" : "НЕ СООТВЕТСТВУЮТ", n / llr_time / 1e6);
+
+    free(bits);
+    free(hard);
+    free(angle);
+    free(words);
+    free(llr);
+    free(symbols);
+    return angle_match && packed_match && llr_match ? 0 : 1;
+}
+
+void print_usage(const char* program) {
+    printf("Использование:\n"
+           "  %s [-c coeffs.bin | -d] [-s счетчики.json] [-P]  проверки и сравнение фильтров\n"
+           "  %s sweep [-o файл.csv|файл.json] [-f none,fir,iir,lms,rls] [-j потоков]\n"
+           "        [-p rect|rrc] [-a скругление RRC] [-c coeffs.bin | -d]\n"
+           "  %s bench [-o файл.csv|файл.json] [-k ядра] [-t отводы] [-b блоки]\n"
+           "        [-n отсчетов] [-w прогревов] [-r повторов]\n"
+           "  %s iq -i запись [-o выход] [-f none|fir|iir] [-s отсчетов на символ]\n"
+           "        [-c coeffs.bin | -d]\n"
+           "  %s iq -g отсчетов -o запись  синтетическая запись QPSK с шумом\n"
+           "  записи: .cf32 (float32) или .ci16 (int16), параметры в <запись>.hdr;\n"
+           "  -s: счетчики этапов в JSON (замеры встраиваются при make STATS=1),\n"
+           "  -P: аппаратные счетчики perf_event (промахи кэша и ветвлений);\n"
+           "  DSP_ISA=scalar|sse4|avx2|avx512 - набор команд ядер (по умолчанию\n"
+           "  лучший из поддерживаемых процессором);\n"
+           "  ядра bench: fir, fir_generic, fft_fir, iir, lms, rls, rls_lattice;\n"
+           "  отводы и блоки - списки через запятую, например -t 16,64,256;\n"
+           "  без -c читается " COEFF_FILE_DEFAULT ", если он есть, иначе\n"
+           "  используются коэффициенты, встроенные при сборке;\n"
+           "  -d: FIR и IIR синтезируются при запуске по полосе сигнала (filter_design);\n"
+           "  -c и -d действуют и в режимах sweep и iq\n",
+           program, program, program, program, program);
+}
+
+// Фильтры coeffs.h в фиксированной точке (Q15, накопление int32/int64)
+// против float по составляющим I и Q: SNR и наибольшая ошибка выхода
+// относительно float, скорость, BER и его потеря против float при трех
+// режимах округления. Ошибка квантования коэффициентов выводится только для
+// FIR: коэффициенты IIR в Q30/Q31 представляют float точно, и ошибка его
+// отклика - это округление в арифметике каскада
+int check_fixed_point(const complex_float* signal, int length, const qpsk_params* params,
+    const uint8_t* original_bits, int num_bits) {
+    const char* kinds[2] = {"FIR", "IIR"};
+    const char* roundings[3] = {"ближайшее", "отбрасывание", "к четному"};
+    int delays[2] = {active_coeffs.fir_taps / 2, iir_demod_delay(params)};
+    float float_ber[2] = {-1.0f, -1.0f};
+    float* in = malloc(2 * length * sizeof(float));
+    float* ref = malloc(2 * length * sizeof(float));
+    float* out = malloc(2 * length * sizeof(float));
+    int16_t* in_q = malloc(2 * length * sizeof(int16_t));
+    int16_t* out_q = malloc(2 * length * sizeof(int16_t));
+    complex_float* filtered = malloc(length * sizeof(complex_float));
+    if (!in || !ref || !out || !in_q || !out_q || !filtered) {
+        free(in);
+        free(ref);
+        free(out);
+        free(in_q);
+        free(out_q);
+        free(filtered);
+        return 1;
+    }
+
+    // Масштаб: пик входа на уровне -6 дБ от полной шкалы Q15
+    float peak = 0.0f;
+    for (int i = 0; i < length; i++) {
+        in[i] = signal[i].real;
+        in[length + i] = signal[i].imag;
+        if (fabsf(in[i]) > peak) peak = fabsf(in[i]);
+        if (fabsf(in[length + i]) > peak) peak = fabsf(in[length + i]);
+    }
+    float scale = 0.5f / peak;
+    fixed_float_to_q15(in, in_q, 2 * length, scale, FIXED_ROUND_NEAREST);
+
+    printf("\n[Q15] Фиксированная точка против float (вход %.3f на полную шкалу):\n", 1.0f / scale);
+
+    // Блочная и поотсчетная обработка Q15 должны совпадать точно
+    int failed = 1;
+    fir_q15_filter fir_block, fir_sample;
+    iir_q15_filter iir_block, iir_sample;
+    if (fir_q15_filter_init(&fir_block, active_coeffs.fir, active_coeffs.fir_taps, FIXED_ROUND_NEAREST) == 0 &&
+        fir_q15_filter_init(&fir_sample, active_coeffs.fir, active_coeffs.fir_taps, FIXED_ROUND_NEAREST) == 0 &&
+        iir_q15_filter_init_sos(&iir_block, active_coeffs.sos, active_coeffs.iir_sections, FIXED_ROUND_NEAREST) == 0 &&
+        iir_q15_filter_init_sos(&iir_sample, active_coeffs.sos, active_coeffs.iir_sections, FIXED_ROUND_NEAREST) == 0) {
+        int fir_mismatch = 0, iir_mismatch = 0;
+        // Блоки нечетной длины, чтобы границы порций не совпадали с FIR_Q15_CHUNK
+        for (int offset = 0; offset < length; offset += 1000) {
+            int n = (length - offset < 1000) ? length - offset : 1000;
+            fir_q15_filter_process_block(&fir_block, in_q + offset, out_q, n);
+            iir_q15_filter_process_block(&iir_block, in_q + offset, out_q + length, n);
+            for (int i = 0; i < n; i++) {
+                fir_mismatch += out_q[i] != fir_q15_filter_process(&fir_sample, in_q[offset + i]);
+                iir_mismatch += out_q[length + i] != iir_q15_filter_process(&iir_sample, in_q[offset + i]);
+            }
+        }
+        printf("  Блочная обработка против поотсчетной: расхождений FIR %d, IIR %d\n",
+               fir_mismatch, iir_mismatch);
+        failed = fir_mismatch != 0 || iir_mismatch != 0;
+        fir_q15_filter_free(&fir_block);
+        fir_q15_filter_free(&fir_sample);
+        iir_q15_filter_free(&iir_block);
+        iir_q15_filter_free(&iir_sample);
+    }
+    for (int kind = 0; kind < 2; kind++) {
+        // variant 0 - float (опорный выход), 1..3 - Q15 с режимами округления
+        for (int variant = 0; variant < 4; variant++) {
+            fixed_rounding rounding = (fixed_rounding)(variant > 0 ? variant - 1 : 0);
+            fir_filter fir[2];
+            iir_filter iir[2];
+            fir_q15_filter fir_q[2];
+            iir_q15_filter iir_q[2];
+            int status = 0;
+            for (int c = 0; c < 2; c++) {
+                if (kind == 0 && variant == 0) {
+                    status |= fir_filter_init(&fir[c], active_coeffs.fir, active_coeffs.fir_taps);
+                } else if (kind == 0) {
+                    status |= fir_q15_filter_init(&fir_q[c], active_coeffs.fir,
+                                                  active_coeffs.fir_taps, rounding);
+                } else if (variant == 0) {
+                    status |= iir_filter_init_sos(&iir[c], active_coeffs.sos,
+                                                  active_coeffs.iir_sections);
+                } else {
+                    status |= iir_q15_filter_init_sos(&iir_q[c], active_coeffs.sos,
+                                                      active_coeffs.iir_sections, rounding);
+                }
+            }
+            if (status != 0) {
+                printf("  %s: ошибка инициализации\n", kinds[kind]);
+                failed = 1;
+                continue;
+            }
+
+            uint64_t start = bench_now_ns();
+            for (int c = 0; c < 2; c++) {
+                for (int offset = 0; offset < length; offset += BLOCK_SIZE) {
+                    int n = (length - offset < BLOCK_SIZE) ? length - offset : BLOCK_SIZE;
+                    int at = c * length + offset;
+                    if (kind == 0 && variant == 0) {
+                        fir_filter_process_block(&fir[c], in + at, ref + at, n);
+                    } else if (kind == 0) {
+                        fir_q15_filter_process_block(&fir_q[c], in_q + at, out_q + at, n);
+                    } else if (variant == 0) {
+                        iir_filter_process_block(&iir[c], in + at, ref + at, n);
+                    } else {
+                        iir_q15_filter_process_block(&iir_q[c], in_q + at, out_q + at, n);
+                    }
+                }
+            }
+            double elapsed = bench_elapsed(start);
+
+            float coeff_error = 0.0f;
+            long long saturations = 0;
+            int frac_bits = 0;
+            for (int c = 0; c < 2; c++) {
+                if (kind == 0 && variant == 0) {
+                    fir_filter_free(&fir[c]);
+                } else if (kind == 0) {
+                    coeff_error = fir_q[c].coeff_error;
+                    frac_bits = fir_q[c].frac_bits;
+                    saturations += fir_q[c].saturations;
+                    fir_q15_filter_free(&fir_q[c]);
+                } else if (variant == 0) {
+                    iir_filter_free(&iir[c]);
+                } else {
+                    saturations += iir_q[c].saturations;
+                    iir_q15_filter_free(&iir_q[c]);
+                }
+            }
+
+            const float* result = ref;
+            double snr = 0.0, max_error = 0.0;
+            if (variant > 0) {
+                fixed_q15_to_float(out_q, out, 2 * length, scale);
+                double sig = 0.0, err = 0.0;
+                for (int i = 0; i < 2 * length; i++) {
+                    double e = (double)out[i] - ref[i];
+                    sig += (double)ref[i] * ref[i];
+                    err += e * e;
+                    if (fabs(e) > max_error) max_error = fabs(e);
+                }
+                snr = err > 0.0 ? 10.0 * log10(sig / err) : INFINITY;
+                result = out;
+            }
+            for (int i = 0; i < length; i++) {
+                filtered[i].real = result[i];
+                filtered[i].imag = result[length + i];
+            }
+
+            int demod_bits_count;
+            complex_float* constellation;
+            uint8_t* decoded_bits = qpsk_demodulate(filtered, length, params, delays[kind],
+                                                    &demod_bits_count, &constellation);
+            float ber = -1.0f;
+            if (decoded_bits) {
+                int compare_length = (num_bits < demod_bits_count) ? num_bits : demod_bits_count;
+                ber = calculate_ber(original_bits, decoded_bits, compare_length);
+                free(decoded_bits);
+                free(constellation);
+            }
+
+            if (variant == 0) {
+                float_ber[kind] = ber;
+                printf("  %s float: %.2f млн отсчетов/сек, BER %.6f\n", kinds[kind],
+                       2.0 * length / elapsed / 1e6, ber);
+            } else {
+                // Ошибка выхода - в единицах младшего разряда Q15 на входной шкале
+                printf("  %s Q15 (%s): %.2f млн отсчетов/сек, BER %.6f (потеря %+.6f), "
+                       "SNR %.1f дБ, ошибка выхода до %.1f МЗР", kinds[kind],
+                       roundings[variant - 1], 2.0 * length / elapsed / 1e6, ber,
+                       ber - float_ber[kind], snr, max_error * 32768.0 * scale);
+                if (kind == 0) printf(", ошибка коэф. %.2e (Q%d)", coeff_error, frac_bits);
+                printf(", насыщений %lld\n", saturations);
+            }
+        }
+    }
+
+    free(in);
+    free(ref);
+    free(out);
+    free(in_q);
+    free(out_q);
+    free(filtered);
+    return failed;
+}
+
+// Кривые BER(Eb/N0) для выбранных фильтров с записью в CSV/JSON
+int run_ber_sweep(int argc, char** argv) {
+    const char* path = "ber_sweep.csv";
+    const char* filters = "none,fir,iir,lms";
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus > 0 ? (int)cpus : 1;
+    const char* pulse = "rect";
+    float rolloff = RRC_DEFAULT_ROLLOFF;
+    const char* coeff_path = NULL;
+    int design = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:f:j:p:a:c:dh")) != -1) {
+        switch (opt) {
+        case 'o': path = optarg; break;
+        case 'f': filters = optarg; break;
+        case 'j': threads = atoi(optarg); break;
+        case 'p': pulse = optarg; break;
+        case 'a': rolloff = (float)atof(optarg); break;
+        case 'c': coeff_path = optarg; break;
+        case 'd': design = 1; break;
+        default:
+            print_usage("dsp_benchmark");
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (design && coeff_path) {
+        print_usage("dsp_benchmark");
+        return 1;
+    }
+    if (threads <= 0) {
+        printf("Неверное число потоков\n");
+        return 1;
+    }
+    if (strcmp(pulse, "rect") != 0 && strcmp(pulse, "rrc") != 0) {
+        printf("Неизвестная форма импульса: %s\n", pulse);
+        return 1;
+    }
+    if (rrc_pulse_length(SAMPLES_PER_SYMBOL, RRC_DEFAULT_SPAN, rolloff) < 0) {
+        printf("Неверный коэффициент скругления: %g\n", rolloff);
+        return 1;
+    }
+    sweep_config config = {
+        .params = {
+            .f_center = F_CENTER,
+            .fs = FS,
+            .samples_per_sym = SAMPLES_PER_SYMBOL,
+            .pulse = strcmp(pulse, "rrc") == 0 ? QPSK_PULSE_RRC : QPSK_PULSE_RECT,
+            .rolloff = rolloff,
+            .span = RRC_DEFAULT_SPAN
+        },
+        .ebn0_start = 0.0f,
+        .ebn0_stop = SWEEP_EBN0_STOP,
+        .ebn0_step = SWEEP_EBN0_STEP,
+        .bits_per_trial = SWEEP_TRIAL_BITS,
+        .target_errors = SWEEP_TARGET_ERRORS,
+        .target_rel_ci = 0.0,
+        .max_bits = SWEEP_MAX_BITS,
+        .threads = threads,
+        .seed = RNG_SEED,
+        .interference_freq = INTERFERENCE_FREQ,
+        .interference_power = 0.0f,
+        .lms_length = LMS_LENGTH,
+        .lms_mu = SWEEP_LMS_STEP,
+        .rls_length = RLS_LENGTH,
+        .rls_lambda = RLS_LAMBDA,
+        .rls_delta = RLS_DELTA
+    };
+    if (ber_sweep_parse_filters(filters, &config.filters) != 0) {
+        printf("Неизвестный фильтр в списке: %s\n", filters);
+        return 1;
+    }
+    if (select_coefficients(&config.params, coeff_path, design) != 0) {
+        return 1;
+    }
+    config.fir = active_coeffs.fir;
+    config.fir_taps = active_coeffs.fir_taps;
+    config.sos = active_coeffs.sos;
+    config.iir_sections = active_coeffs.iir_sections;
+
+    sweep_point points[SWEEP_MAX_POINTS];
+    int count = ber_sweep_run(&config, points, SWEEP_MAX_POINTS);
+    coeff_file_close(&active_coeff_file);
+    if (count < 0) {
+        printf("Ошибка расчета кривых BER: %d\n", count);
+        return 1;
+    }
+    for (int i = 0; i < count; i++) {
+        printf("%-5s Eb/N0 %5.1f дБ: BER %.3e [%.3e, %.3e], %lld бит, %.2f сек\n",
+               ber_sweep_filter_name(points[i].filter), points[i].ebn0_db,
+               points[i].bits ? (double)points[i].errors / points[i].bits : 0.0,
+               points[i].ci_low, points[i].ci_high, points[i].bits, points[i].seconds);
+    }
+    int stuck = ber_sweep_find_stuck(points, count);
+    if (stuck >= 0) {
+        printf("ОШИБКА: %s на Eb/N0 %.1f дБ дает BER не ниже %.2f - решения случайны "
+               "(задержка фильтра или расходимость), %s не записан\n",
+               ber_sweep_filter_name(points[stuck].filter), points[stuck].ebn0_db,
+               SWEEP_STUCK_BER, path);
+        return 1;
+    }
+    if (ber_sweep_write(path, points, count) != 0) {
+        printf("Ошибка записи %s\n", path);
+        return 1;
+    }
+    printf("Результаты записаны в %s\n", path);
+    return 0;
+}
+
+// Замер ядер фильтров по сетке отводов и размеров блока с записью в CSV/JSON
+int run_kernel_bench(int argc, char** argv) {
+    const char* path = "bench_results.csv";
+    const char* kernels = "fir,fir_generic,fft_fir,iir,lms,rls,rls_lattice";
+    const char* taps_list = "16,64,256,1024";
+    const char* blocks_list = "64,256,4096";
+    bench_config config = {
+        .samples = BENCH_SAMPLES,
+        .warmup = BENCH_WARMUP,
+        .repetitions = BENCH_REPETITIONS,
+        .seed = RNG_SEED
+    };
+    int opt;
+    while ((opt = getopt(argc, argv, "o:k:t:b:n:w:r:h")) != -1) {
+        switch (opt) {
+        case 'o': path = optarg; break;
+        case 'k': kernels = optarg; break;
+        case 't': taps_list = optarg; break;
+        case 'b': blocks_list = optarg; break;
+        case 'n': config.samples = atoi(optarg); break;
+        case 'w': config.warmup = atoi(optarg); break;
+        case 'r': config.repetitions = atoi(optarg); break;
+        default:
+            print_usage("dsp_benchmark");
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    int taps[BENCH_MAX_GRID], blocks[BENCH_MAX_GRID];
+    config.num_taps = bench_parse_list(taps_list, taps, BENCH_MAX_GRID);
+    config.num_blocks = bench_parse_list(blocks_list, blocks, BENCH_MAX_GRID);
+    config.taps = taps;
+    config.blocks = blocks;
+    if (bench_parse_kernels(kernels, &config.kernels) != 0 || config.num_taps < 0 ||
+        config.num_blocks < 0) {
+        printf("Неверный список ядер, отводов или блоков\n");
+        return 1;
+    }
+
+    bench_result* results = malloc(BENCH_MAX_RESULTS * sizeof(bench_result));
+    if (!results) {
+        return 1;
+    }
+    int count = bench_run(&config, results, BENCH_MAX_RESULTS);
+    if (count < 0) {
+        printf("Ошибка замера ядер: %d\n", count);
+        free(results);
+        return 1;
+    }
+
+    printf("Набор команд ядер: %s\n", dsp_isa_name(dsp_dispatch_isa()));
+    printf("%-12s %6s %6s %10s %10s %10s %10s\n", "ядро", "отводы", "блок",
+           "мин нс", "медиана нс", "p99 нс", "млн отс/с");
+    for (int i = 0; i < count; i++) {
+        printf("%-12s %6d %6d %10.3f %10.3f %10.3f %10.2f\n",
+               bench_kernel_name(results[i].kernel), results[i].taps, results[i].block,
+               results[i].min_ns, results[i].median_ns, results[i].p99_ns, results[i].msps);
+    }
+    int status = bench_write(path, results, count);
+    free(results);
+    if (status != 0) {
+        printf("Ошибка записи %s\n", path);
+        return 1;
+    }
+    printf("Результаты записаны в %s\n", path);
+    return 0;
+}
+
+static void pipeline_ciir(void* state, const complex_float* in, complex_float* out, int n) {
+    ciir_filter_process_block((ciir_filter*)state, in, out, n);
+}
+
+// Ошибки решений num_bits относительно циклической последовательности,
+// как pipeline_count_errors
+static long long pipeline_serial_count(const uint64_t* decided, int num_bits,
+                                       const uint64_t* pattern, int pattern_bits,
+                                       long long* bit_pos) {
+    long long errors = 0;
+    for (int done = 0; done < num_bits; ) {
+        int part = num_bits - done;
+        if (*bit_pos + part > pattern_bits) {
+            part = (int)(pattern_bits - *bit_pos);
+        }
+        errors += packed_count_errors(decided, done, pattern, *bit_pos, part);
+        *bit_pos += part;
+        if (*bit_pos == pattern_bits) *bit_pos = 0;
+        done += part;
+    }
+    return errors;
+}
+
+// Та же цепочка, что у pipeline_run, в одном потоке и теми же блоками:
+// эталон для проверки конвейера (решения должны совпасть бит в бит).
+// Состояние config->filter_state - начальное. 0 или -2
+static int pipeline_serial_errors(const pipeline_config* config, long long* bit_errors,
+                                  long long* bits) {
+    const qpsk_params* params = &config->params;
+    int sps = params->samples_per_sym;
+    int chunk_symbols = config->chunk_samples / sps;
+    int max_symbols = chunk_symbols + 1;
+    if (max_symbols < QPSK_DEMOD_FLUSH_MAX) max_symbols = QPSK_DEMOD_FLUSH_MAX;
+    long long total_symbols = config->num_samples / sps;
+
+    uint64_t* pattern = malloc(packed_words(config->pattern_bits) * sizeof(uint64_t));
+    uint64_t* decided = malloc(packed_words(2LL * max_symbols) * sizeof(uint64_t));
+    complex_float* block = malloc(2 * (size_t)chunk_symbols * sps * sizeof(complex_float));
+    complex_float* constellation = malloc(max_symbols * sizeof(complex_float));
+    qpsk_modulator mod;
+    qpsk_demodulator dem;
+    oscillator interference;
+    rng_state rng;
+    int mod_ok = 0, dem_ok = 0;
+
+    if (pattern && decided && block && constellation &&
+        oscillator_init(&interference, config->interference_freq, params->fs) == 0) {
+        mod_ok = qpsk_modulator_init(&mod, params) == 0;
+        dem_ok = qpsk_demodulator_init(&dem, params, config->filter_delay) == 0;
+    }
+    int status = (mod_ok && dem_ok) ? 0 : -2;
+    if (status == 0) {
+        complex_float* filtered = block + (size_t)chunk_symbols * sps;
+        long long tx_pos = 0, rx_pos = 0;
+        packed_pack(config->pattern, config->pattern_bits, pattern);
+        rng_init(&rng, config->seed);
+        *bit_errors = 0;
+        *bits = 0;
+
+        for (long long sym = 0; sym < total_symbols; ) {
+            int symbols = (total_symbols - sym < chunk_symbols) ? (int)(total_symbols - sym)
+                                                                : chunk_symbols;
+            for (int done = 0; done < symbols; ) {
+                int part = symbols - done;
+                if (tx_pos + 2LL * part > config->pattern_bits) {
+                    part = (int)((config->pattern_bits - tx_pos) / 2);
+                }
+                qpsk_modulator_process_packed(&mod, pattern, tx_pos, 2 * part,
+                                              &block[(size_t)done * sps]);
+                tx_pos += 2LL * part;
+                if (tx_pos == config->pattern_bits) tx_pos = 0;
+                done += part;
+            }
+            int n = symbols * sps;
+            add_noise_and_interference_block(block, n, config->noise_power,
+                                             config->interference_power, &interference, &rng);
+            config->filter(config->filter_state, block, filtered, n);
+            int decoded = qpsk_demodulator_push_packed(&dem, filtered, n, decided, 0,
+                                                       constellation);
+            *bit_errors += pipeline_serial_count(decided, 2 * decoded, pattern,
+                                                 config->pattern_bits, &rx_pos);
+            *bits += 2LL * decoded;
+            sym += symbols;
+        }
+        int decoded = qpsk_demodulator_flush_packed(&dem, decided, 0, constellation);
+        *bit_errors += pipeline_serial_count(decided, 2 * decoded, pattern, config->pattern_bits,
+                                             &rx_pos);
+        *bits += 2LL * decoded;
+    }
+
+    if (mod_ok) qpsk_modulator_free(&mod);
+    if (dem_ok) qpsk_demodulator_free(&dem);
+    free(pattern);
+    free(decided);
+    free(block);
+    free(constellation);
+    return status;
+}
+
+// Потоковый конвейер генератор -> канал -> IIR -> демодулятор на отдельных
+// потоках: длинный поток при памяти в несколько блоков. Решения сверяются
+// с той же цепочкой в одном потоке
+int run_pipeline_benchmark(const qpsk_params* params, const uint8_t* pattern, int pattern_bits) {
+    const char* stages[PIPELINE_STAGES] = {"источник", "канал", "фильтр", "демодулятор"};
+    ciir_filter iir;
+    if (ciir_filter_init_sos(&iir, active_coeffs.sos, active_coeffs.iir_sections) != 0) {
+        printf("Ошибка инициализации IIR фильтра\n");
+        return 1;
+    }
+
+    pipeline_config config = {
+        .params = *params,
+        .pattern = pattern,
+        .pattern_bits = pattern_bits & ~1,
+        .num_samples = PIPELINE_SAMPLES,
+        .chunk_samples = BLOCK_SIZE,
+        .ring_slots = PIPELINE_SLOTS,
+        .noise_power = NOISE_POWER,
+        .seed = RNG_SEED + 1,
+        .interference_freq = INTERFERENCE_FREQ,
+        .interference_power = INTERFERENCE_POWER,
+        .filter = pipeline_ciir,
+        .filter_state = &iir,
+        .filter_delay = iir_demod_delay(params)
+    };
+    pipeline_stats stats;
+    long long serial_errors = 0, serial_bits = 0;
+    int status = pipeline_run(&config, &stats);
+    ciir_filter_free(&iir);
+    if (status == 0) {
+        // Эталону - фильтр с начальным состоянием
+        if (ciir_filter_init_sos(&iir, active_coeffs.sos, active_coeffs.iir_sections) != 0) {
+            status = -2;
+        } else {
+            status = pipeline_serial_errors(&config, &serial_errors, &serial_bits);
+            ciir_filter_free(&iir);
+        }
+    }
+    if (status != 0) {
+        printf("\n[Конвейер] Ошибка %d\n", status);
+        return 1;
+    }
+
+    printf("\n[Конвейер] %lld отсчетов, блок %d, %d слотов на буфер:\n",
+           stats.samples, BLOCK_SIZE, PIPELINE_SLOTS);
+    printf("  Время: %.4f сек, %.2f млн отсчетов/сек\n", stats.seconds,
+           stats.samples / stats.seconds / 1e6);
+    printf("  BER: %.6f (ошибок: %lld из %lld бит)\n",
+           stats.bits ? (double)stats.bit_errors / stats.bits : 0.0, stats.bit_errors, stats.bits);
+    printf("  Ожидания стадий:");
+    for (int i = 0; i < PIPELINE_STAGES; i++) {
+        printf(" %s %lld%s", stages[i], stats.stalls[i], i + 1 < PIPELINE_STAGES ? "," : "\n");
+    }
+    double ber = stats.bits ? (double)stats.bit_errors / stats.bits : 1.0;
+    int ok = stats.bit_errors == serial_errors && stats.bits == serial_bits &&
+             ber < PIPELINE_MAX_BER;
+    printf("  %s (в одном потоке: %lld ошибок из %lld бит)\n",
+           ok ? "OK: совпадает с одним потоком"
+              : "ОШИБКА: расходится с одним потоком или BER у 0.5",
+           serial_errors, serial_bits);
+    return ok ? 0 : 1;
+}
+
+// Точка перехода прямой свертки и overlap-save через измерительный стенд
+// (прогрев, медиана повторов): прямая свертка - общим ядром dsp_dot, так
+// как специализированные ядра есть не для всех длин. Точка перехода -
+// наименьшее число отводов сетки, начиная с которого БПФ быстрее на всех
+// следующих точках
+void report_fft_crossover(void) {
+    const int taps[] = {16, 32, 64, 128, 256, 384, 512, 768, 1024, 1536, 2048};
+    const int num_taps = (int)(sizeof(taps) / sizeof(taps[0]));
+    const int blocks[] = {BLOCK_SIZE};
+    bench_config config = {
+        .kernels = (1u << BENCH_KERNEL_FIR_GENERIC) | (1u << BENCH_KERNEL_FFT_FIR),
+        .taps = taps,
+        .num_taps = num_taps,
+        .blocks = blocks,
+        .num_blocks = 1,
+        .samples = BENCH_SAMPLES,
+        .warmup = BENCH_WARMUP,
+        .repetitions = BENCH_REPETITIONS,
+        .seed = RNG_SEED
+    };
+    bench_result results[2 * (sizeof(taps) / sizeof(taps[0]))];
+    int count = bench_run(&config, results, 2 * num_taps);
+    if (count != 2 * num_taps) {
+        printf("\n[FIR] Ошибка замера прямой свертки и overlap-save: %d\n", count);
+        return;
+    }
+
+    // Результаты идут по ядрам: сначала прямая свертка, затем БПФ
+    printf("\n[FIR] Прямая свертка и overlap-save (медиана, нс/отсчет, блоки по %d):\n",
+           BLOCK_SIZE);
+    int crossover = 0;
+    for (int t = 0; t < num_taps; t++) {
+        double direct = results[t].median_ns, fft = results[num_taps + t].median_ns;
+        printf("  %5d отводов: прямая %8.2f, БПФ %8.2f\n", taps[t], direct, fft);
+        if (fft >= direct) {
+            crossover = 0;
+        } else if (!crossover) {
+            crossover = taps[t];
+        }
+    }
+    if (crossover) {
+        printf("  БПФ быстрее начиная с %d отводов (FFT_FIR_CROSSOVER_TAPS = %d%s)\n",
+               crossover, FFT_FIR_CROSSOVER_TAPS,
+               crossover == FFT_FIR_CROSSOVER_TAPS ? "" : ", для этой машины можно задать "
+                                                          "-DFFT_FIR_CROSSOVER_TAPS");
+    } else {
+        printf("  БПФ не быстрее прямой свертки до %d отводов\n", taps[num_taps - 1]);
+    }
+}
+
+// Перенос в базовую полосу, ФНЧ и децимация одним каскадом DDC; демодулятор
+// получает в DDC_FACTOR раз меньше отсчетов на символ
+void run_ddc_benchmark(const complex_float* signal, int length, const qpsk_params* params,
+    const uint8_t* original_bits, int num_bits) {
+    printf("\n[DDC] Тестирование фильтра (децимация в %d раз)\n", DDC_FACTOR);
+
+    float lowpass[FIR_NUMTAPS];
+    ddc_filter_design_lowpass(lowpass, FIR_NUMTAPS, DDC_CUTOFF, params->fs);
+
+    ddc_filter ddc;
+    if (ddc_filter_init(&ddc, lowpass, FIR_NUMTAPS, DDC_FACTOR,
+                        params->f_center, params->fs) != 0) {
+        printf("Ошибка инициализации DDC\n");
+        return;
+    }
+    qpsk_params demod_params;
+    if (ddc_filter_demod_params(&ddc, params, &demod_params) != 0) {
+        printf("Отсчетов на символ %d не делится на децимацию %d\n", params->samples_per_sym,
+               DDC_FACTOR);
+        ddc_filter_free(&ddc);
+        return;
+    }
+
+    complex_float* decimated = malloc((length / DDC_FACTOR + 1) * sizeof(complex_float));
+    if (!decimated) {
+        ddc_filter_free(&ddc);
+        return;
+    }
+
+    uint64_t start = bench_now_ns();
+    int decimated_length = 0;
+    for (int offset = 0; offset < length; offset += BLOCK_SIZE) {
+        int n = (length - offset < BLOCK_SIZE) ? length - offset : BLOCK_SIZE;
+        decimated_length += ddc_filter_process_block(&ddc, signal + offset, n,
+                                                     decimated + decimated_length);
+    }
+    double elapsed = bench_elapsed(start);
+
+    printf("Время обработки: %.4f сек\n", elapsed);
+    printf("Скорость обработки: %.2f млн входных отсчетов/сек\n", length / elapsed / 1e6);
+
+    int demod_bits_count;
+    complex_float* constellation;
+    uint8_t* decoded_bits = qpsk_demodulate(decimated, decimated_length, &demod_params,
+                                            ddc_filter_delay(&ddc), &demod_bits_count,
+                                            &constellation);
+    if (decoded_bits) {
+        int compare_length = (num_bits < demod_bits_count) ? num_bits : demod_bits_count;
+        float ber = calculate_ber(original_bits, decoded_bits, compare_length);
+        printf("BER: %.6f (ошибок: %d из %d бит)\n", ber, (int)(ber * compare_length), compare_length);
+        free(decoded_bits);
+        free(constellation);
+    } else {
+        printf("Ошибка демодуляции\n");
+    }
+
+    free(decimated);
+    ddc_filter_free(&ddc);
+}
+
+// Фильтр потока записи: FIR по составляющим I и Q, комплексный IIR или без фильтра
+typedef enum {
+    IQ_FILTER_NONE = 0,
+    IQ_FILTER_FIR,
+    IQ_FILTER_IIR
+} iq_filter;
+
+typedef struct {
+    long long samples;
+    long long symbols;
+    long long bit_errors;
+    double seconds;
+} iq_stream_stats;
+
+// Ошибки n решений относительно циклической последовательности pattern,
+// *pos - позиция в ней
+static long long iq_count_errors(const uint64_t* decoded, long long n, const uint64_t* pattern,
+                                 int pattern_bits, long long* pos) {
+    long long errors = 0;
+    for (long long done = 0; done < n; ) {
+        long long part = n - done;
+        if (part > pattern_bits - *pos) part = pattern_bits - *pos;
+        errors += packed_count_errors(decoded, done, pattern, *pos, part);
+        *pos = (*pos + part) % pattern_bits;
+        done += part;
+    }
+    return errors;
+}
+
+// Запись reader блоками по BLOCK_SIZE отсчетов через фильтр с
+// коэффициентами coeffs и потоковый демодулятор; выход фильтра пишется в
+// writer (NULL - не пишется). Память не зависит от длины записи.
+// 0 или отрицательный код ошибки
+static int iq_stream(iq_reader* reader, iq_writer* writer, iq_filter filter,
+                     const filter_coeffs* coeffs, const qpsk_params* params,
+                     const uint64_t* pattern, int pattern_bits, iq_stream_stats* stats) {
+    fft_fir_filter fir_i = {0}, fir_q = {0};
+    ciir_filter iir = {0};
+    qpsk_demodulator dem;
+    // Задержка IIR - по частоте несущей записи, поэтому не iir_demod_delay
+    int delay = (filter == IQ_FILTER_FIR) ? coeffs->fir_taps / 2 :
+                (filter == IQ_FILTER_IIR) ? iir_filter_sos_delay(coeffs->sos, coeffs->iir_sections,
+                                                                 params->f_center, params->fs)
+                                          : 0;
+    int max_symbols = BLOCK_SIZE / params->samples_per_sym + 1 + QPSK_DEMOD_FLUSH_MAX;
+    complex_float* block = malloc(BLOCK_SIZE * sizeof(complex_float));
+    complex_float* points = malloc(max_symbols * sizeof(complex_float));
+    uint64_t* decoded = malloc(packed_words(2LL * max_symbols) * sizeof(uint64_t));
+    float* split = malloc(2 * BLOCK_SIZE * sizeof(float));
+    memset(stats, 0, sizeof(*stats));
+
+    int status = (block && points && decoded && split) ? 0 : -2;
+    if (status == 0 && delay < 0) {
+        status = -1;
+    }
+    if (status == 0 && filter == IQ_FILTER_FIR) {
+        status = fft_fir_filter_init(&fir_i, coeffs->fir, coeffs->fir_taps, 0);
+        if (status == 0) {
+            status = fft_fir_filter_init(&fir_q, coeffs->fir, coeffs->fir_taps, 0);
+        }
+    } else if (status == 0 && filter == IQ_FILTER_IIR) {
+        status = ciir_filter_init_sos(&iir, coeffs->sos, coeffs->iir_sections);
+    }
+    if (status == 0) {
+        status = qpsk_demodulator_init(&dem, params, delay);
+    }
+
+    long long bit_pos = 0;
+    int n;
+    uint64_t start = bench_now_ns();
+    while (status == 0 && (n = iq_reader_read(reader, block, BLOCK_SIZE)) > 0) {
+        if (filter == IQ_FILTER_FIR) {
+            float *re = split, *im = split + BLOCK_SIZE;
+            for (int i = 0; i < n; i++) {
+                re[i] = block[i].real;
+                im[i] = block[i].imag;
+            }
+            fft_fir_filter_process_block(&fir_i, re, re, n);
+            fft_fir_filter_process_block(&fir_q, im, im, n);
+            for (int i = 0; i < n; i++) {
+                block[i].real = re[i];
+                block[i].imag = im[i];
+            }
+        } else if (filter == IQ_FILTER_IIR) {
+            ciir_filter_process_block(&iir, block, block, n);
+        }
+        if (writer && iq_writer_write(writer, block, n) != 0) {
+            status = -4;
+        }
+        int symbols = qpsk_demodulator_push_packed(&dem, block, n, decoded, 0, points);
+        stats->bit_errors += iq_count_errors(decoded, 2LL * symbols, pattern, pattern_bits,
+                                             &bit_pos);
+        stats->symbols += symbols;
+        stats->samples += n;
+    }
+    if (status == 0) {
+        int symbols = qpsk_demodulator_flush_packed(&dem, decoded, 0, points);
+        stats->bit_errors += iq_count_errors(decoded, 2LL * symbols, pattern, pattern_bits,
+                                             &bit_pos);
+        stats->symbols += symbols;
+        qpsk_demodulator_free(&dem);
+    }
+    stats->seconds = bench_elapsed(start);
+
+    fft_fir_filter_free(&fir_i);
+    fft_fir_filter_free(&fir_q);
+    ciir_filter_free(&iir);
+    free(block);
+    free(points);
+    free(decoded);
+    free(split);
+    return status;
+}
+
+// Формат записи по расширению: .ci16 или cf32 для остальных
+static iq_format iq_path_format(const char* path) {
+    const char* ext = strrchr(path, '.');
+    return (ext && strcmp(ext, ".ci16") == 0) ? IQ_CI16 : IQ_CF32;
+}
+
+static void iq_remove(const char* path) {
+    char header[1024];
+    snprintf(header, sizeof(header), "%s%s", path, IQ_HEADER_SUFFIX);
+    unlink(path);
+    unlink(header);
+}
+
+// Записи cf32/ci16: запись и чтение через отображение без потерь (ci16 -
+// в пределах шага квантования), обработка записи блоками совпадает с
+// обработкой сигнала в памяти
+int check_iq_file(const complex_float* signal, int length, const qpsk_params* params,
+    const uint8_t* original_bits, int num_bits) {
+    const char* dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    char paths[3][256];
+    snprintf(paths[0], sizeof(paths[0]), "%s/dsp_iq_%d.cf32", dir, (int)getpid());
+    snprintf(paths[1], sizeof(paths[1]), "%s/dsp_iq_%d.ci16", dir, (int)getpid());
+    snprintf(paths[2], sizeof(paths[2]), "%s/dsp_iq_%d_fir.cf32", dir, (int)getpid());
+    complex_float* back = malloc(length * sizeof(complex_float));
+    complex_float* filtered = malloc(length * sizeof(complex_float));
+    float* split = malloc(2 * length * sizeof(float));
+    uint64_t* pattern = malloc(packed_words(num_bits) * sizeof(uint64_t));
+    if (!back || !filtered || !split || !pattern) {
+        printf("Ошибка выделения памяти для проверки записей IQ\n");
+        free(back);
+        free(filtered);
+        free(split);
+        free(pattern);
+        return 1;
+    }
+    packed_pack(original_bits, num_bits, pattern);
+
+    // Запись в обоих форматах блоками и чтение обратно
+    int written = 1;
+    long long saturated = 0;
+    for (int k = 0; k < 2; k++) {
+        iq_info info = {(iq_format)k, params->fs, params->f_center, IQ_CI16_SCALE};
+        iq_writer writer;
+        written &= iq_writer_open(&writer, paths[k], &info) == 0;
+        for (int offset = 0; written && offset < length; offset += BLOCK_SIZE) {
+            int n = (length - offset < BLOCK_SIZE) ? length - offset : BLOCK_SIZE;
+            written &= iq_writer_write(&writer, signal + offset, n) == 0;
+        }
+        saturated += writer.saturated;
+        written &= iq_writer_close(&writer) == 0;
+    }
+    int cf32_match = 0;
+    float ci16_error = -1.0f;
+    for (int k = 0; written && k < 2; k++) {
+        iq_reader reader;
+        if (iq_reader_open(&reader, paths[k]) != 0) {
+            continue;
+        }
+        int n = (reader.samples == length) ? iq_reader_read(&reader, back, length) : 0;
+        if (n == length && reader.info.fs == params->fs && k == IQ_CF32) {
+            cf32_match = memcmp(back, signal, length * sizeof(complex_float)) == 0;
+        } else if (n == length && k == IQ_CI16) {
+            ci16_error = 0.0f;
+            for (int i = 0; i < length; i++) {
+                ci16_error = fmaxf(ci16_error, fmaxf(fabsf(back[i].real - signal[i].real),
+                                                     fabsf(back[i].imag - signal[i].imag)));
+            }
+        }
+        iq_reader_close(&reader);
+    }
+
+    // Опорный результат: FIR и демодуляция сигнала в памяти целиком
+    fft_fir_filter fir_i = {0}, fir_q = {0};
+    long long ref_errors = -1;
+    int ref_symbols = -1;
+    if (fft_fir_filter_init(&fir_i, active_coeffs.fir, active_coeffs.fir_taps, 0) == 0 &&
+        fft_fir_filter_init(&fir_q, active_coeffs.fir, active_coeffs.fir_taps, 0) == 0) {
+        float *re = split, *im = split + length;
+        for (int i = 0; i < length; i++) {
+            re[i] = signal[i].real;
+            im[i] = signal[i].imag;
+        }
+        fft_fir_filter_process_block(&fir_i, re, re, length);
+        fft_fir_filter_process_block(&fir_q, im, im, length);
+        for (int i = 0; i < length; i++) {
+            filtered[i].real = re[i];
+            filtered[i].imag = im[i];
+        }
+        int demod_bits;
+        complex_float* constellation;
+        uint8_t* decoded = qpsk_demodulate(filtered, length, params, active_coeffs.fir_taps / 2,
+                                           &demod_bits, &constellation);
+        if (decoded) {
+            ref_symbols = demod_bits / 2;
+            ref_errors = 0;
+            for (int i = 0; i < demod_bits && i < num_bits; i++) {
+                ref_errors += decoded[i] != original_bits[i];
+            }
+            free(decoded);
+            free(constellation);
+        }
+    }
+    fft_fir_filter_free(&fir_i);
+    fft_fir_filter_free(&fir_q);
+
+    // Та же обработка записи блоками с записью выхода фильтра
+    iq_stream_stats stats;
+    iq_reader reader;
+    iq_writer writer;
+    iq_info out_info = {IQ_CF32, params->fs, params->f_center, IQ_CI16_SCALE};
+    int stream_ok = written && iq_reader_open(&reader, paths[0]) == 0;
+    if (stream_ok) {
+        stream_ok = iq_writer_open(&writer, paths[2], &out_info) == 0;
+        if (stream_ok) {
+            stream_ok = iq_stream(&reader, &writer, IQ_FILTER_FIR, &active_coeffs, params,
+                                  pattern, num_bits, &stats) == 0;
+            stream_ok &= iq_writer_close(&writer) == 0;
+        }
+        iq_reader_close(&reader);
+    }
+    float out_error = -1.0f;
+    if (stream_ok && iq_reader_open(&reader, paths[2]) == 0) {
+        if (iq_reader_read(&reader, back, length) == length) {
+            out_error = 0.0f;
+            for (int i = 0; i < length; i++) {
+                out_error = fmaxf(out_error, fmaxf(fabsf(back[i].real - filtered[i].real),
+                                                   fabsf(back[i].imag - filtered[i].imag)));
+            }
+        }
+        iq_reader_close(&reader);
+    }
+
+    printf("\n[Записи IQ] %d отсчетов, блоки по %d\n", length, BLOCK_SIZE);
+    // ci16 - не больше половины шага квантования
+    int failed = !cf32_match || ci16_error < 0.0f ||
+                 ci16_error > 0.5 / (32768.0 * IQ_CI16_SCALE) + 1e-7;
+    printf("  cf32: %s, ci16: макс. ошибка %.2e (шаг %.2e), насыщений %lld\n",
+           cf32_match ? "совпадает" : "РАСХОЖДЕНИЕ", ci16_error,
+           1.0 / (32768.0 * IQ_CI16_SCALE), saturated);
+    if (stream_ok && ref_symbols >= 0) {
+        int match = stats.symbols == ref_symbols && stats.bit_errors == ref_errors;
+        failed |= !match;
+        printf("  FIR + демодулятор по блокам записи: %s (%lld символов, %lld ошибок), "
+               "выход фильтра: макс. отличие %.2e\n",
+               match ? "совпадает с обработкой в памяти" : "РАСХОЖДЕНИЕ",
+               stats.symbols, stats.bit_errors, out_error);
+        printf("  скорость: %.1f млн отсчетов/сек (%.0f МБ/с cf32)\n",
+               stats.samples / stats.seconds / 1e6,
+               stats.samples * sizeof(complex_float) / stats.seconds / 1e6);
+    } else {
+        printf("  Ошибка обработки записи\n");
+        failed = 1;
+    }
+
+    for (int k = 0; k < 3; k++) {
+        iq_remove(paths[k]);
+    }
+    free(back);
+    free(filtered);
+    free(split);
+    free(pattern);
+    return failed;
+}
+
+// Синтетическая запись: QPSK по циклической последовательности с шумом и
+// помехой, как в проверках, блоками по BLOCK_SIZE
+static int iq_generate(const char* path, long long samples) {
+    qpsk_params params = {
+        .f_center = F_CENTER,
+        .fs = FS,
+        .samples_per_sym = SAMPLES_PER_SYMBOL
+    };
+    iq_info info = {iq_path_format(path), FS, F_CENTER, IQ_CI16_SCALE};
+    int sps = params.samples_per_sym;
+    int chunk_symbols = BLOCK_SIZE / sps;
+    long long total_symbols = samples / sps;
+    rng_state rng, noise_rng;
+    rng_init(&rng, RNG_SEED);
+    rng_split(&rng, &noise_rng);
+    uint64_t* pattern = generate_random_bits_packed(IQ_PATTERN_BITS, &rng);
+    complex_float* block = malloc((size_t)chunk_symbols * sps * sizeof(complex_float));
+    qpsk_modulator mod;
+    oscillator interference;
+    iq_writer writer;
+    if (!pattern || !block || qpsk_modulator_init(&mod, &params) != 0) {
+        free(pattern);
+        free(block);
+        return -2;
+    }
+    int status = oscillator_init(&interference, INTERFERENCE_FREQ, FS) == 0 ? 0 : -1;
+    if (status == 0) {
+        status = iq_writer_open(&writer, path, &info);
+    }
+
+    long long bit_pos = 0;
+    for (long long sym = 0; status == 0 && sym < total_symbols; ) {
+        int symbols = (total_symbols - sym < chunk_symbols) ? (int)(total_symbols - sym)
+                                                            : chunk_symbols;
+        for (int done = 0; done < symbols; ) {
+            int part = symbols - done;
+            if (bit_pos + 2LL * part > IQ_PATTERN_BITS) {
+                part = (int)((IQ_PATTERN_BITS - bit_pos) / 2);
+            }
+            qpsk_modulator_process_packed(&mod, pattern, bit_pos, 2 * part,
+                                          &block[(size_t)done * sps]);
+            bit_pos = (bit_pos + 2LL * part) % IQ_PATTERN_BITS;
+            done += part;
+        }
+        add_noise_and_interference_block(block, symbols * sps, NOISE_POWER, INTERFERENCE_POWER,
+                                         &interference, &noise_rng);
+        status = iq_writer_write(&writer, block, symbols * sps);
+        sym += symbols;
+    }
+    if (status == 0 || status == -4) {
+        int close_status = iq_writer_close(&writer);
+        if (status == 0) status = close_status;
+        if (status == 0) {
+            printf("Записано %lld отсчетов (%s), насыщений %lld\n", writer.samples,
+                   info.format == IQ_CI16 ? "ci16" : "cf32", writer.saturated);
+        }
+    }
+    qpsk_modulator_free(&mod);
+    free(pattern);
+    free(block);
+    return status;
+}
+
+// Обработка записи IQ блоками: фильтр, запись выхода и демодуляция
+int run_iq(int argc, char** argv) {
+    const char* input = NULL;
+    const char* output = NULL;
+    const char* filter_name = "fir";
+    long long generate = 0;
+    int sps = SAMPLES_PER_SYMBOL;
+    const char* coeff_path = NULL;
+    int design = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "i:o:f:s:g:c:dh")) != -1) {
+        switch (opt) {
+        case 'i': input = optarg; break;
+        case 'o': output = optarg; break;
+        case 'f': filter_name = optarg; break;
+        case 's': sps = atoi(optarg); break;
+        case 'g': generate = atoll(optarg); break;
+        case 'c': coeff_path = optarg; break;
+        case 'd': design = 1; break;
+        default:
+            print_usage("dsp_benchmark");
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    // Разбивка по этапам печатается, если замеры встроены в сборку
+    dsp_stats_init(0);
+    if (generate > 0) {
+        if (!output) {
+            printf("Для -g нужен путь записи -o\n");
+            return 1;
+        }
+        int status = iq_generate(output, generate);
+        if (status != 0) {
+            printf("Ошибка записи %s: %d\n", output, status);
+        } else if (dsp_stats_compiled()) {
+            dsp_stats_print(stdout);
+        }
+        return status == 0 ? 0 : 1;
+    }
+
+    const char* filter_names[3] = {"none", "fir", "iir"};
+    int filter = -1;
+    for (int f = 0; f < 3; f++) {
+        if (strcmp(filter_name, filter_names[f]) == 0) filter = f;
+    }
+    if (!input || filter < 0 || sps <= 0 || (design && coeff_path)) {
+        print_usage("dsp_benchmark");
+        return 1;
+    }
+    iq_reader reader;
+    int status = iq_reader_open(&reader, input);
+    if (status != 0) {
+        printf("Ошибка открытия записи %s: %d\n", input, status);
+        return 1;
+    }
+    if (!(reader.info.fs > 0.0)) {
+        printf("В %s%s не задана частота дискретизации fs\n", input, IQ_HEADER_SUFFIX);
+        iq_reader_close(&reader);
+        return 1;
+    }
+    qpsk_params params = {
+        .f_center = (float)reader.info.f_center,
+        .fs = (float)reader.info.fs,
+        .samples_per_sym = sps
+    };
+    // Синтез -d - по полосе сигнала записи
+    if (select_coefficients(&params, coeff_path, design) != 0) {
+        iq_reader_close(&reader);
+        return 1;
+    }
+
+    iq_writer writer;
+    iq_info out_info = {iq_path_format(output ? output : ""), reader.info.fs,
+                        reader.info.f_center, IQ_CI16_SCALE};
+    if (output && iq_writer_open(&writer, output, &out_info) != 0) {
+        printf("Ошибка создания %s\n", output);
+        iq_reader_close(&reader);
+        coeff_file_close(&active_coeff_file);
+        return 1;
+    }
+
+    // Решения сравниваются с последовательностью записей iq -g
+    rng_state rng, noise_rng;
+    rng_init(&rng, RNG_SEED);
+    rng_split(&rng, &noise_rng);
+    uint64_t* pattern = generate_random_bits_packed(IQ_PATTERN_BITS, &rng);
+    iq_stream_stats stats;
+    status = pattern ? iq_stream(&reader, output ? &writer : NULL, (iq_filter)filter,
+                                 &active_coeffs, &params, pattern, IQ_PATTERN_BITS, &stats)
+                     : -2;
+    if (output && iq_writer_close(&writer) != 0 && status == 0) {
+        status = -4;
+    }
+
+    if (status == 0) {
+        printf("%s: %lld отсчетов, fs %.6g Гц, f_center %.6g Гц, фильтр %s\n", input,
+               stats.samples, reader.info.fs, reader.info.f_center, filter_names[filter]);
+        printf("Время: %.3f сек, %.2f млн отсчетов/сек\n", stats.seconds,
+               stats.samples / stats.seconds / 1e6);
+        printf("Символов: %lld, BER относительно последовательности iq -g: %.6f\n",
+               stats.symbols, stats.symbols ? stats.bit_errors / (2.0 * stats.symbols) : 0.0);
+        if (output) {
+            printf("Выход фильтра записан в %s\n", output);
+        }
+        if (dsp_stats_compiled()) {
+            dsp_stats_print(stdout);
+        }
+    } else {
+        printf("Ошибка обработки записи: %d\n", status);
+    }
+    free(pattern);
+    iq_reader_close(&reader);
+    coeff_file_close(&active_coeff_file);
+    return status == 0 ? 0 : 1;
+}
+
+// Варианты сравнения цепочки стадий: стадия перед демодулятором
+typedef enum {
+    CHAIN_CASE_FIR = 0,
+    CHAIN_CASE_IIR,
+    CHAIN_CASE_DDC,
+    CHAIN_CASE_COUNT
+} chain_case;
+
+typedef struct {
+    fft_fir_filter fir_i, fir_q;
+    stage_chain_fir_pair pair;
+    ciir_filter iir;
+    ddc_filter ddc;
+    stage_chain_config config;
+} chain_stages;
+
+// Свежие фильтры варианта и конфигурация цепочки с тайлом tile
+static int chain_stages_init(chain_stages* st, chain_case kind, const qpsk_params* params,
+                             const float* lowpass, int tile) {
+    memset(st, 0, sizeof(*st));
+    st->config.params = *params;
+    st->config.tile = tile;
+    int status = -1;
+    if (kind == CHAIN_CASE_FIR) {
+        status = fft_fir_filter_init(&st->fir_i, active_coeffs.fir, active_coeffs.fir_taps, 0);
+        if (status == 0) {
+            status = fft_fir_filter_init(&st->fir_q, active_coeffs.fir, active_coeffs.fir_taps, 0);
+        }
+        // Буферизация по блокам: тайлы короче шага overlap-save не платят
+        // полное БПФ на каждый вызов (при прямой свертке ни на что не влияет)
+        if (status == 0) {
+            fft_fir_filter_set_buffered(&st->fir_i, 1);
+            fft_fir_filter_set_buffered(&st->fir_q, 1);
+        }
+        st->pair.i = &st->fir_i;
+        st->pair.q = &st->fir_q;
+        st->config.filters[0] = stage_chain_fir;
+        st->config.filter_states[0] = &st->pair;
+        st->config.num_filters = 1;
+        st->config.delay = active_coeffs.fir_taps / 2 + fft_fir_filter_latency(&st->fir_i);
+    } else if (kind == CHAIN_CASE_IIR) {
+        status = ciir_filter_init_sos(&st->iir, active_coeffs.sos, active_coeffs.iir_sections);
+        st->config.filters[0] = stage_chain_ciir;
+        st->config.filter_states[0] = &st->iir;
+        st->config.num_filters = 1;
+        st->config.delay = iir_demod_delay(params);
+    } else {
+        status = ddc_filter_init(&st->ddc, lowpass, FIR_NUMTAPS, DDC_FACTOR,
+                                 params->f_center, params->fs);
+        st->config.ddc = &st->ddc;
+        st->config.delay = ddc_filter_delay(&st->ddc);
+    }
+    return status;
+}
+
+static void chain_stages_free(chain_stages* st, chain_case kind) {
+    if (kind == CHAIN_CASE_FIR) {
+        fft_fir_filter_free(&st->fir_i);
+        fft_fir_filter_free(&st->fir_q);
+    } else if (kind == CHAIN_CASE_IIR) {
+        ciir_filter_free(&st->iir);
+    } else {
+        ddc_filter_free(&st->ddc);
+    }
+}
+
+// Текущая схема: стадия пишет весь выход в буфер длины сигнала (stage),
+// затем qpsk_demodulate читает его целиком. Возвращает время или -1.
+static double chain_run_buffered(chain_case kind, const complex_float* signal, int length,
+                                 const qpsk_params* params, const float* lowpass,
+                                 complex_float* stage, uint8_t** out_bits, int* out_num_bits) {
+    chain_stages st;
+    if (chain_stages_init(&st, kind, params, lowpass, BLOCK_SIZE) != 0) {
+        chain_stages_free(&st, kind);
+        return -1.0;
+    }
+    qpsk_params demod_params = *params;
+    if (kind == CHAIN_CASE_DDC && ddc_filter_demod_params(&st.ddc, params, &demod_params) != 0) {
+        chain_stages_free(&st, kind);
+        return -1.0;
+    }
+    uint64_t start = bench_now_ns();
+    int stage_length = 0;
+    for (int offset = 0; offset < length; offset += BLOCK_SIZE) {
+        int n = (length - offset < BLOCK_SIZE) ? length - offset : BLOCK_SIZE;
+        if (kind == CHAIN_CASE_DDC) {
+            stage_length += ddc_filter_process_block(&st.ddc, &signal[offset], n,
+                                                     &stage[stage_length]);
+        } else {
+            st.config.filters[0](st.config.filter_states[0], &signal[offset],
+                                 &stage[offset], n);
+            stage_length += n;
+        }
+    }
+    complex_float* constellation = NULL;
+    *out_bits = qpsk_demodulate(stage, stage_length, &demod_params, st.config.delay,
+                                out_num_bits, &constellation);
+    double elapsed = bench_elapsed(start);
+    free(constellation);
+    chain_stages_free(&st, kind);
+    return *out_bits ? elapsed : -1.0;
+}
+
+// Цепочка тайлами: решения в bits, возвращает время или -1
+static double chain_run_tiled(chain_case kind, const complex_float* signal, int length,
+                              const qpsk_params* params, const float* lowpass, int tile,
+                              uint8_t* bits, int* out_num_bits) {
+    chain_stages st;
+    stage_chain chain;
+    if (chain_stages_init(&st, kind, params, lowpass, tile) != 0 ||
+        stage_chain_init(&chain, &st.config) != 0) {
+        chain_stages_free(&st, kind);
+        return -1.0;
+    }
+    uint64_t start = bench_now_ns();
+    int symbols = stage_chain_process(&chain, signal, length, bits);
+    symbols += stage_chain_flush(&chain, &bits[2 * symbols]);
+    double elapsed = bench_elapsed(start);
+    *out_num_bits = 2 * symbols;
+    stage_chain_free(&chain);
+    chain_stages_free(&st, kind);
+    return elapsed;
+}
+
+// Цепочка стадий тайлами против схемы "буфер на стадию" на сигнале,
+// который не помещается в L2: время, ускорение, BER и совпадение решений
+int run_chain_benchmark(const qpsk_params* params) {
+    const char* case_names[CHAIN_CASE_COUNT] = {"FIR", "IIR", "DDC"};
+    const int tiles[] = {512, STAGE_CHAIN_DEFAULT_TILE, 8192, 32768};
+    const int num_tiles = (int)(sizeof(tiles) / sizeof(tiles[0]));
+    int sps = params->samples_per_sym;
+    int num_bits = 2 * (CHAIN_SAMPLES / sps);
+
+    rng_state rng, noise_rng;
+    rng_init(&rng, RNG_SEED + 2);
+    rng_split(&rng, &noise_rng);
+    uint8_t* tx_bits = generate_random_bits(num_bits, &rng);
+    int length = 0;
+    complex_float* signal = tx_bits ? qpsk_modulate(tx_bits, num_bits, params, &length) : NULL;
+    complex_float* stage = malloc((size_t)CHAIN_SAMPLES * sizeof(complex_float));
+    uint8_t* bits = malloc((size_t)2 * (CHAIN_SAMPLES / sps + 2));
+    float lowpass[FIR_NUMTAPS];
+    if (!signal || !stage || !bits) {
+        printf("\n[Цепочка стадий] Ошибка выделения памяти\n");
+        free(tx_bits);
+        free(signal);
+        free(stage);
+        free(bits);
+        return 1;
+    }
+    add_noise_and_interference(signal, length, NOISE_POWER, INTERFERENCE_FREQ,
+                               INTERFERENCE_POWER, params->fs, &noise_rng);
+    ddc_filter_design_lowpass(lowpass, FIR_NUMTAPS, DDC_CUTOFF, params->fs);
+    // Страницы промежуточного буфера затрагиваются заранее, чтобы в замер
+    // не попали первые обращения к ним
+    memset(stage, 0, (size_t)length * sizeof(complex_float));
+
+    printf("\n[Цепочка стадий] %d отсчетов (%.0f МБ), буфер на стадию против тайлов:\n",
+           length, length * sizeof(complex_float) / 1048576.0);
+    int failed = 0;
+    for (int kind = 0; kind < CHAIN_CASE_COUNT; kind++) {
+        uint8_t* reference = NULL;
+        int reference_bits = 0;
+        double buffered = -1.0;
+        for (int r = 0; r < CHAIN_REPEATS; r++) {
+            uint8_t* decoded;
+            int decoded_bits;
+            double t = chain_run_buffered((chain_case)kind, signal, length, params, lowpass,
+                                          stage, &decoded, &decoded_bits);
+            if (t < 0.0) {
+                buffered = -1.0;
+                break;
+            }
+            if (buffered < 0.0 || t < buffered) buffered = t;
+            free(reference);
+            reference = decoded;
+            reference_bits = decoded_bits;
+        }
+        if (buffered < 0.0) {
+            printf("  %s: ошибка\n", case_names[kind]);
+            free(reference);
+            failed = 1;
+            continue;
+        }
+        // BER эталона: совпадение решений тайлов ничего не говорит, если
+        // задержка демодулятора неверна для обеих схем
+        int compare_bits = (reference_bits < num_bits) ? reference_bits : num_bits;
+        printf("  %s -> демодулятор, буфер на стадию: %.4f сек (%.2f млн отсчетов/сек), "
+               "BER %.6f\n", case_names[kind], buffered, length / buffered / 1e6,
+               calculate_ber(tx_bits, reference, compare_bits));
+
+        for (int t = 0; t < num_tiles; t++) {
+            double best = -1.0;
+            int decoded_bits = 0;
+            for (int r = 0; r < CHAIN_REPEATS; r++) {
+                double e = chain_run_tiled((chain_case)kind, signal, length, params, lowpass,
+                                           tiles[t], bits, &decoded_bits);
+                if (e < 0.0) {
+                    best = -1.0;
+                    break;
+                }
+                if (best < 0.0 || e < best) best = e;
+            }
+            if (best < 0.0) {
+                printf("    тайл %6d: ошибка\n", tiles[t]);
+                failed = 1;
+                continue;
+            }
+            int same = decoded_bits == reference_bits &&
+                       memcmp(bits, reference, (size_t)reference_bits) == 0;
+            printf("    тайл %6d (%4.0f КБ буферов): %.4f сек, ускорение %.2f, решения %s\n",
+                   tiles[t], 2.0 * tiles[t] * sizeof(complex_float) / 1024.0, best,
+                   buffered / best, same ? "совпадают" : "РАЗЛИЧАЮТСЯ");
+            failed |= !same;
+        }
+        free(reference);
+    }
+
+    free(tx_bits);
+    free(signal);
+    free(stage);
+    free(bits);
+    return failed;
+}
@@ -0,0 +1,509 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include "ber_sweep.h"
+#include "../signal_generator/signal_generator.h"
+#include "../filters/fft_fir_filter.h"
+#include "../filters/ciir_filter.h"
+#include "../filters/iir_filter.h"
+#include "../filters/clms_filter.h"
+#include "../filters/crls_filter.h"
+
+#define SWEEP_Z95 1.959964  // квантиль нормального распределения для 95%
+#define SWEEP_SLOTS_PER_THREAD 4  // испытаний на поток, которые могут ждать учета
+
+static const char* sweep_filter_names[SWEEP_FILTER_COUNT] = {
+    "none", "fir", "iir", "lms", "rls"
+};
+
+// Результат испытания, ожидающий учета
+typedef struct {
+    long long bits;
+    long long errors;
+    int ready;
+} sweep_slot;
+
+// Общее состояние точки сетки для потоков пула. Испытания завершаются в
+// произвольном порядке, но учитываются строго по номерам: результат
+// испытания t ждет в slots[t % num_slots], пока не учтены все предыдущие,
+// а остановка проверяется после каждого учтенного. Поэтому сумма - всегда
+// кратчайший префикс испытаний 0, 1, 2, ..., удовлетворяющий sweep_done,
+// при любом числе потоков и порядке их работы; испытания после него
+// отбрасываются. Поток не берет испытание, для которого нет свободного
+// слота, и ждет учета предыдущих
+typedef struct {
+    const sweep_config* config;
+    sweep_filter filter;
+    int point_index;            // номер Eb/N0 в сетке (одинаков для всех фильтров)
+    float noise_power;
+    int delay;                  // задержка фильтра для демодулятора
+    pthread_mutex_t lock;       // защищает все поля ниже
+    pthread_cond_t progress;    // учтено испытание или точка остановлена
+    sweep_slot* slots;
+    int num_slots;
+    int next_trial;             // следующее испытание для раздачи
+    int stop;
+    int error;
+    long long bits;             // сумма по учтенным испытаниям 0 .. trials - 1
+    long long errors;
+    int trials;
+} sweep_shared;
+
+// Рабочие буферы потока на одно испытание. Все они, а также состояние
+// фильтра испытания лежат в рабочей области потока: фильтр создается в ней
+// после метки trial_mark и возвращается откатом, поэтому испытания не
+// обращаются к malloc
+typedef struct {
+    workspace ws;
+    size_t trial_mark;
+    int length;
+    uint64_t* bits;             // упакованные биты испытания
+    complex_float* tx;
+    complex_float* rx;          // фильтруется на месте
+    float* split;               // I и Q для FIR, 2 * length
+    uint64_t* decoded;          // упакованные решения демодулятора
+    complex_float* constellation;
+} sweep_buffers;
+
+const char* ber_sweep_filter_name(sweep_filter filter) {
+    return (filter >= 0 && filter < SWEEP_FILTER_COUNT) ? sweep_filter_names[filter] : "?";
+}
+
+int ber_sweep_parse_filters(const char* list, unsigned* mask) {
+    *mask = 0;
+    while (list && *list) {
+        const char* end = strchr(list, ',');
+        size_t len = end ? (size_t)(end - list) : strlen(list);
+        int found = 0;
+        for (int f = 0; f < SWEEP_FILTER_COUNT; f++) {
+            if (strlen(sweep_filter_names[f]) == len && strncmp(list, sweep_filter_names[f], len) == 0) {
+                *mask |= 1u << f;
+                found = 1;
+            }
+        }
+        if (!found) {
+            return -1;
+        }
+        list = end ? end + 1 : NULL;
+    }
+    return *mask ? 0 : -1;
+}
+
+// Интервал Уилсона для errors ошибок из bits
+static void sweep_wilson(long long errors, long long bits, double* low, double* high) {
+    if (bits == 0) {
+        *low = 0.0;
+        *high = 1.0;
+        return;
+    }
+    double n = (double)bits;
+    double p = errors / n;
+    double z2 = SWEEP_Z95 * SWEEP_Z95;
+    double denom = 1.0 + z2 / n;
+    double center = (p + z2 / (2.0 * n)) / denom;
+    double half = SWEEP_Z95 * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / denom;
+    *low = fmax(0.0, center - half);
+    *high = fmin(1.0, center + half);
+}
+
+static int sweep_done(const sweep_config* cfg, long long bits, long long errors) {
+    if (cfg->target_errors > 0 && errors >= cfg->target_errors) {
+        return 1;
+    }
+    if (cfg->target_rel_ci > 0.0 && errors > 0) {
+        double low, high;
+        sweep_wilson(errors, bits, &low, &high);
+        if ((high - low) / 2.0 <= cfg->target_rel_ci * ((double)errors / bits)) {
+            return 1;
+        }
+    }
+    return bits >= cfg->max_bits;
+}
+
+// Задержка фильтра в отсчетах: для IIR - по каскаду SOS с учетом фазы
+// несущей (iir_filter_sos_delay, как в benchmark). Адаптивные фильтры
+// следуют за опорным сигналом tx без задержки
+static int sweep_filter_delay(const sweep_config* cfg, sweep_filter filter) {
+    switch (filter) {
+        case SWEEP_FILTER_FIR: return cfg->fir_taps / 2;
+        case SWEEP_FILTER_IIR:
+            return iir_filter_sos_delay(cfg->sos, cfg->iir_sections, cfg->params.f_center,
+                                        cfg->params.fs);
+        default: return 0;
+    }
+}
+
+// Наибольшая рабочая область фильтров маски
+static size_t sweep_filter_workspace_size(const sweep_config* cfg) {
+    size_t size = 0, need;
+    if (cfg->filters & (1u << SWEEP_FILTER_FIR)) {
+        need = 2 * fft_fir_filter_workspace_size(cfg->fir_taps, 0, FFT_FIR_AUTO);
+        if (need > size) size = need;
+    }
+    if (cfg->filters & (1u << SWEEP_FILTER_IIR)) {
+        need = ciir_filter_workspace_size(cfg->iir_sections);
+        if (need > size) size = need;
+    }
+    if (cfg->filters & (1u << SWEEP_FILTER_LMS)) {
+        need = clms_filter_workspace_size(cfg->lms_length);
+        if (need > size) size = need;
+    }
+    if (cfg->filters & (1u << SWEEP_FILTER_RLS)) {
+        need = crls_filter_workspace_size(cfg->rls_length);
+        if (need > size) size = need;
+    }
+    return size;
+}
+
+static int sweep_alloc(sweep_buffers* buf, const sweep_config* cfg) {
+    // Сигнал испытания вместе с хвостом импульса
+    int length = (cfg->bits_per_trial / 2 + qpsk_pulse_delay(&cfg->params)) *
+                 cfg->params.samples_per_sym;
+    int max_symbols = length / cfg->params.samples_per_sym + 1 + QPSK_DEMOD_FLUSH_MAX;
+    size_t bits_size = packed_words(cfg->bits_per_trial) * sizeof(uint64_t);
+    size_t signal_size = length * sizeof(complex_float);
+    size_t split_size = 2 * (size_t)length * sizeof(float);
+    size_t decoded_size = packed_words(2LL * max_symbols) * sizeof(uint64_t);
+    size_t points_size = max_symbols * sizeof(complex_float);
+    // Модулятор, фильтр и демодулятор испытания создаются после trial_mark
+    // по очереди, поэтому область вмещает наибольший из них
+    size_t trial_size = sweep_filter_workspace_size(cfg);
+    if (qpsk_modulator_workspace_size(&cfg->params) > trial_size) {
+        trial_size = qpsk_modulator_workspace_size(&cfg->params);
+    }
+    if (qpsk_demodulator_workspace_size(&cfg->params) > trial_size) {
+        trial_size = qpsk_demodulator_workspace_size(&cfg->params);
+    }
+    size_t size = workspace_align(bits_size) + 2 * workspace_align(signal_size) +
+                  workspace_align(split_size) + workspace_align(decoded_size) +
+                  workspace_align(points_size) + trial_size;
+    if (workspace_init(&buf->ws, size) != 0) {
+        return -2;
+    }
+    buf->length = length;
+    buf->bits = workspace_alloc(&buf->ws, bits_size);
+    buf->tx = workspace_alloc(&buf->ws, signal_size);
+    buf->rx = workspace_alloc(&buf->ws, signal_size);
+    buf->split = workspace_alloc(&buf->ws, split_size);
+    buf->decoded = workspace_alloc(&buf->ws, decoded_size);
+    buf->constellation = workspace_alloc(&buf->ws, points_size);
+    buf->trial_mark = workspace_mark(&buf->ws);
+    return 0;
+}
+
+static void sweep_release(sweep_buffers* buf) {
+    workspace_free(&buf->ws);
+}
+
+// Фильтрация rx на месте свежим фильтром в рабочей области; опорный
+// сигнал адаптивных - tx
+static int sweep_apply_filter(const sweep_config* cfg, sweep_filter filter, sweep_buffers* buf) {
+    int n = buf->length;
+    workspace* ws = &buf->ws;
+    int status = 0;
+
+    switch (filter) {
+        case SWEEP_FILTER_FIR: {
+            fft_fir_filter fir_i, fir_q;
+            float *re = buf->split, *im = re + n;
+            if (fft_fir_filter_init_ws(&fir_i, cfg->fir, cfg->fir_taps, 0, FFT_FIR_AUTO, ws) != 0 ||
+                fft_fir_filter_init_ws(&fir_q, cfg->fir, cfg->fir_taps, 0, FFT_FIR_AUTO, ws) != 0) {
+                status = -2;
+                break;
+            }
+            for (int i = 0; i < n; i++) {
+                re[i] = buf->rx[i].real;
+                im[i] = buf->rx[i].imag;
+            }
+            fft_fir_filter_process_block(&fir_i, re, re, n);
+            fft_fir_filter_process_block(&fir_q, im, im, n);
+            for (int i = 0; i < n; i++) {
+                buf->rx[i].real = re[i];
+                buf->rx[i].imag = im[i];
+            }
+            break;
+        }
+        case SWEEP_FILTER_IIR: {
+            ciir_filter iir;
+            if (ciir_filter_init_sos_ws(&iir, cfg->sos, cfg->iir_sections, ws) != 0) {
+                status = -2;
+                break;
+            }
+            ciir_filter_process_block(&iir, buf->rx, buf->rx, n);
+            break;
+        }
+        case SWEEP_FILTER_LMS: {
+            // Нормированный шаг: mu = lms_mu / (length * P) по измеренной
+            // мощности входа испытания, иначе при сильном шуме LMS расходится
+            double power = 0.0;
+            for (int i = 0; i < n; i++) {
+                power += (double)buf->rx[i].real * buf->rx[i].real +
+                         (double)buf->rx[i].imag * buf->rx[i].imag;
+            }
+            power /= n;
+            float mu = (power > 0.0) ? (float)(cfg->lms_mu / (cfg->lms_length * power))
+                                     : cfg->lms_mu;
+            clms_filter lms;
+            if (clms_filter_init_ws(&lms, cfg->lms_length, mu, ws) != 0) {
+                status = -2;
+                break;
+            }
+            clms_filter_process_block(&lms, buf->rx, buf->tx, buf->rx, n);
+            break;
+        }
+        case SWEEP_FILTER_RLS: {
+            crls_filter rls;
+            if (crls_filter_init_ws(&rls, cfg->rls_length, cfg->rls_lambda, cfg->rls_delta, ws) != 0) {
+                status = -2;
+                break;
+            }
+            crls_filter_process_block(&rls, buf->rx, buf->tx, buf->rx, n);
+            break;
+        }
+        default:
+            break;
+    }
+    workspace_release(ws, buf->trial_mark);
+    return status;
+}
+
+// Одно испытание; возвращает число ошибок, *bits - число сравненных бит
+static long long sweep_trial(sweep_shared* shared, sweep_buffers* buf, int trial, long long* bits) {
+    const sweep_config* cfg = shared->config;
+    int n = buf->length;
+    int sps = cfg->params.samples_per_sym;
+    rng_state rng;
+    oscillator interference;
+    qpsk_modulator mod;
+
+    // Поток генератора определяется точкой и номером испытания
+    rng_init(&rng, cfg->seed ^ ((uint64_t)shared->point_index << 40) ^ (uint64_t)trial);
+    rng_bits_packed(&rng, buf->bits, cfg->bits_per_trial);
+    if (qpsk_modulator_init_ws(&mod, &cfg->params, &buf->ws) != 0) return -1;
+    qpsk_modulator_process_packed(&mod, buf->bits, 0, cfg->bits_per_trial, buf->tx);
+    qpsk_modulator_flush(&mod, &buf->tx[cfg->bits_per_trial / 2 * sps]);
+    workspace_release(&buf->ws, buf->trial_mark);
+
+    memcpy(buf->rx, buf->tx, n * sizeof(complex_float));
+    if (cfg->interference_power > 0.0f) {
+        if (oscillator_init(&interference, cfg->interference_freq, cfg->params.fs) != 0) return -1;
+        add_noise_and_interference_block(buf->rx, n, shared->noise_power,
+                                         cfg->interference_power, &interference, &rng);
+    } else {
+        add_awgn(buf->rx, n, shared->noise_power, &rng);
+    }
+
+    if (sweep_apply_filter(cfg, shared->filter, buf) != 0) return -2;
+
+    int delay = shared->delay;
+    qpsk_demodulator dem;
+    if (qpsk_demodulator_init_ws(&dem, &cfg->params, delay, &buf->ws) != 0) return -1;
+    int symbols = qpsk_demodulator_push_packed(&dem, buf->rx, n, buf->decoded, 0,
+                                               buf->constellation);
+    symbols += qpsk_demodulator_flush_packed(&dem, buf->decoded, 2LL * symbols,
+                                             buf->constellation + symbols);
+    workspace_release(&buf->ws, buf->trial_mark);
+
+    // Сравниваются только символы с полным окном усреднения после задержки;
+    // согласованный фильтр RRC сам выдает только такие символы
+    int valid = symbols;
+    if (cfg->params.pulse != QPSK_PULSE_RRC) {
+        int window_end = sps / 4 + sps / 2;
+        valid = (n - delay >= window_end) ? (n - delay - window_end) / sps + 1 : 0;
+    }
+    if (valid > symbols) valid = symbols;
+    if (valid > cfg->bits_per_trial / 2) valid = cfg->bits_per_trial / 2;
+
+    *bits = 2 * valid;
+    return packed_count_errors(buf->decoded, 0, buf->bits, 0, 2LL * valid);
+}
+
+// Остановка точки с кодом ошибки (вызывается под lock)
+static void sweep_fail(sweep_shared* shared, int error) {
+    shared->error = error;
+    shared->stop = 1;
+    pthread_cond_broadcast(&shared->progress);
+}
+
+static void* sweep_worker(void* arg) {
+    sweep_shared* shared = arg;
+    sweep_buffers buf;
+    memset(&buf, 0, sizeof(buf));
+    int status = sweep_alloc(&buf, shared->config);
+
+    pthread_mutex_lock(&shared->lock);
+    if (status != 0) {
+        sweep_fail(shared, status);
+    }
+    while (!shared->stop) {
+        if (shared->next_trial >= shared->trials + shared->num_slots) {
+            pthread_cond_wait(&shared->progress, &shared->lock);
+            continue;
+        }
+        int trial = shared->next_trial++;
+        pthread_mutex_unlock(&shared->lock);
+
+        long long bits = 0;
+        long long errors = sweep_trial(shared, &buf, trial, &bits);
+
+        pthread_mutex_lock(&shared->lock);
+        if (errors < 0) {
+            sweep_fail(shared, (int)errors);
+            break;
+        }
+        sweep_slot* slot = &shared->slots[trial % shared->num_slots];
+        slot->bits = bits;
+        slot->errors = errors;
+        slot->ready = 1;
+        // Учет готовых испытаний по порядку номеров
+        while (!shared->stop) {
+            slot = &shared->slots[shared->trials % shared->num_slots];
+            if (!slot->ready) break;
+            slot->ready = 0;
+            shared->bits += slot->bits;
+            shared->errors += slot->errors;
+            shared->trials++;
+            if (sweep_done(shared->config, shared->bits, shared->errors)) {
+                shared->stop = 1;
+            }
+        }
+        pthread_cond_broadcast(&shared->progress);
+    }
+    pthread_mutex_unlock(&shared->lock);
+
+    sweep_release(&buf);
+    return NULL;
+}
+
+static int sweep_point_run(const sweep_config* cfg, sweep_filter filter, int point_index,
+                           float ebn0, sweep_point* point) {
+    sweep_shared shared;
+    memset(&shared, 0, sizeof(shared));
+    shared.config = cfg;
+    shared.filter = filter;
+    shared.point_index = point_index;
+    // Мощность сигнала на отсчет равна 1 (единичная несущая, |символ| = 1)
+    shared.noise_power = awgn_noise_power(ebn0, 1.0f, cfg->params.samples_per_sym, 2);
+    shared.delay = sweep_filter_delay(cfg, filter);
+    if (shared.delay < 0) {
+        return -1;
+    }
+    shared.num_slots = SWEEP_SLOTS_PER_THREAD * cfg->threads;
+    shared.slots = calloc(shared.num_slots, sizeof(sweep_slot));
+    if (!shared.slots) {
+        return -2;
+    }
+    pthread_mutex_init(&shared.lock, NULL);
+    pthread_cond_init(&shared.progress, NULL);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    pthread_t* threads = malloc(cfg->threads * sizeof(pthread_t));
+    int started = 0;
+    if (threads) {
+        for (; started < cfg->threads; started++) {
+            if (pthread_create(&threads[started], NULL, sweep_worker, &shared) != 0) break;
+        }
+    }
+    if (started == 0) {
+        // Пул не создан - испытания в текущем потоке
+        sweep_worker(&shared);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    free(shared.slots);
+    pthread_cond_destroy(&shared.progress);
+    pthread_mutex_destroy(&shared.lock);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    point->filter = filter;
+    point->ebn0_db = ebn0;
+    point->bits = shared.bits;
+    point->errors = shared.errors;
+    point->trials = shared.trials;
+    point->seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+    sweep_wilson(shared.errors, shared.bits, &point->ci_low, &point->ci_high);
+    return shared.error;
+}
+
+int ber_sweep_run(const sweep_config* config, sweep_point* points, int max_points) {
+    if (!config || !points || config->bits_per_trial < 2 || config->bits_per_trial % 2 != 0 ||
+        config->params.samples_per_sym <= 0 || config->threads <= 0 || config->max_bits <= 0 ||
+        config->ebn0_step <= 0.0f || config->ebn0_stop < config->ebn0_start) {
+        return -1;
+    }
+    if (((config->filters & (1u << SWEEP_FILTER_FIR)) && (!config->fir || config->fir_taps <= 0)) ||
+        ((config->filters & (1u << SWEEP_FILTER_IIR)) && (!config->sos || config->iir_sections <= 0))) {
+        return -1;
+    }
+
+    int grid = (int)floorf((config->ebn0_stop - config->ebn0_start) / config->ebn0_step + 1e-3f) + 1;
+    int count = 0;
+    for (int f = 0; f < SWEEP_FILTER_COUNT; f++) {
+        if (!(config->filters & (1u << f))) continue;
+        for (int k = 0; k < grid && count < max_points; k++) {
+            float ebn0 = config->ebn0_start + k * config->ebn0_step;
+            int status = sweep_point_run(config, (sweep_filter)f, k, ebn0, &points[count]);
+            if (status != 0) {
+                return status;
+            }
+            count++;
+            if (points[count - 1].errors == 0) {
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+int ber_sweep_find_stuck(const sweep_point* points, int count) {
+    for (int i = 0; i < count; i++) {
+        if (points[i].ci_low >= SWEEP_STUCK_BER) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int ber_sweep_write(const char* path, const sweep_point* points, int count) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        return -1;
+    }
+
+    size_t len = strlen(path);
+    int json = len >= 5 && strcmp(path + len - 5, ".json") == 0;
+    if (json) {
+        fprintf(f, "{\n  \"points\": [\n");
+    } else {
+        fprintf(f, "filter,ebn0_db,bits,errors,ber,ci_low,ci_high,trials,seconds\n");
+    }
+    for (int i = 0; i < count; i++) {
+        const sweep_point* p = &points[i];
+        double ber = p->bits ? (double)p->errors / p->bits : 0.0;
+        if (json) {
+            fprintf(f, "    {\"filter\": \"%s\", \"ebn0_db\": %.3f, \"bits\": %lld, \"errors\": %lld, "
+                       "\"ber\": %.6e, \"ci_low\": %.6e, \"ci_high\": %.6e, \"trials\": %d, "
+                       "\"seconds\": %.4f}%s\n",
+                    ber_sweep_filter_name(p->filter), p->ebn0_db, p->bits, p->errors, ber,
+                    p->ci_low, p->ci_high, p->trials, p->seconds, i + 1 < count ? "," : "");
+        } else {
+            fprintf(f, "%s,%.3f,%lld,%lld,%.6e,%.6e,%.6e,%d,%.4f\n",
+                    ber_sweep_filter_name(p->filter), p->ebn0_db, p->bits, p->errors, ber,
+                    p->ci_low, p->ci_high, p->trials, p->seconds);
+        }
+    }
+    if (json) {
+        fprintf(f, "  ]\n}\n");
+    }
+
+    int status = ferror(f) ? -2 : 0;
+    fclose(f);
+    return status;
+}
@@ -0,0 +1,80 @@
+#ifndef BER_SWEEP_H
+#define BER_SWEEP_H
+
+#include <stdint.h>
+#include "../qpsk/qpsk_modem.h"
+
+// Монте-Карло оценка BER в зависимости от Eb/N0. Каждое испытание - блок
+// случайных бит: модуляция, белый шум (и помеха), фильтр, потоковый
+// демодулятор. Испытания точки сетки раздаются пулу потоков; у испытания
+// свой поток генератора, заданный (seed, точка, номер испытания), а
+// испытания учитываются по порядку номеров, поэтому результат, включая
+// момент остановки, не зависит ни от числа потоков, ни от их порядка.
+// Точка останавливается по числу ошибок, по относительной полуширине 95%
+// доверительного интервала (Уилсона) или по пределу бит.
+#define SWEEP_STUCK_BER 0.4     // нижняя граница интервала BER "решения случайны"
+
+typedef enum {
+    SWEEP_FILTER_NONE = 0,  // без фильтра (опорная кривая)
+    SWEEP_FILTER_FIR,
+    SWEEP_FILTER_IIR,
+    SWEEP_FILTER_LMS,
+    SWEEP_FILTER_RLS,
+    SWEEP_FILTER_COUNT
+} sweep_filter;
+
+typedef struct {
+    qpsk_params params;
+    float ebn0_start;           // сетка Eb/N0, дБ
+    float ebn0_stop;
+    float ebn0_step;
+    int bits_per_trial;         // бит в одном испытании (четное)
+    long long target_errors;    // остановка по числу ошибок (0 - выкл.)
+    double target_rel_ci;       // остановка по полуширине интервала / BER (0 - выкл.)
+    long long max_bits;         // предел бит на точку
+    int threads;                // размер пула потоков
+    uint64_t seed;
+    float interference_freq;    // помеха, как в add_noise_and_interference
+    float interference_power;   // 0 - без помехи
+    unsigned filters;           // маска (1u << sweep_filter)
+    const float* fir;           // коэффициенты FIR (для fir в маске)
+    int fir_taps;
+    const float* sos;           // каскад секций IIR по 6 чисел (для iir в маске)
+    int iir_sections;
+    int lms_length;
+    float lms_mu;               // нормированный шаг: делится на lms_length * мощность входа
+    int rls_length;
+    float rls_lambda;
+    float rls_delta;
+} sweep_config;
+
+typedef struct {
+    sweep_filter filter;
+    float ebn0_db;
+    long long bits;
+    long long errors;
+    int trials;
+    double ci_low;              // 95% доверительный интервал BER
+    double ci_high;
+    double seconds;
+} sweep_point;
+
+// Запуск по всем фильтрам маски и точкам сетки. Возвращает число
+// записанных точек (не больше max_points) или отрицательный код ошибки.
+// Кривая фильтра обрывается после первой точки без ошибок.
+int ber_sweep_run(const sweep_config* config, sweep_point* points, int max_points);
+
+// Первая точка, BER которой не ниже SWEEP_STUCK_BER с уверенностью 95%
+// (фильтр не работает: неверная задержка или расходимость), или -1.
+// Такие кривые не записываются, а считаются ошибкой
+int ber_sweep_find_stuck(const sweep_point* points, int count);
+
+// Запись результатов: JSON, если путь оканчивается на .json, иначе CSV
+int ber_sweep_write(const char* path, const sweep_point* points, int count);
+
+const char* ber_sweep_filter_name(sweep_filter filter);
+
+// Разбор списка фильтров через запятую ("none,fir,iir") в маску
+int ber_sweep_parse_filters(const char* list, unsigned* mask);
+
+#endif // BER_SWEEP_H
@@ -0,0 +1,143 @@
+#ifndef COEFFS_H
+#define COEFFS_H
+
+#include <stdint.h>
+#include "filters/complex_float.h"
+
+#define FIR_NUMTAPS 501
+#define IIR_ORDER 8
+#define IIR_SECTIONS 4
+#define LMS_NTAPS 64
+#define RLS_NTAPS 64
+
+static const float fir_coeff[FIR_NUMTAPS] = {
+    0.00000000f,    -0.00000023f,    0.00000036f,    -0.00000020f,    -0.00000034f,
+    0.00000126f,    -0.00000239f,    0.00000335f,    -0.00000372f,    0.00000307f,
+    -0.00000116f,    -0.00000192f,    0.00000568f,    -0.00000928f,    0.00001163f,
+    -0.00001170f,    0.00000878f,    -0.00000280f,    -0.00000552f,    0.00001464f,
+    -0.00002246f,    0.00002672f,    -0.00002558f,    0.00001815f,    -0.00000493f,
+    -0.00001208f,    0.00002953f,    -0.00004341f,    0.00004984f,    -0.00004604f,
+    0.00003122f,    -0.00000707f,    -0.00002233f,    0.00005104f,    -0.00007246f,
+    0.00008077f,    -0.00007240f,    0.00004712f,    -0.00000851f,    -0.00003641f,
+    0.00007841f,    -0.00010792f,    0.00011717f,    -0.00010214f,    0.00006383f,
+    -0.00000848f,    -0.00005336f,    0.00010882f,    -0.00014544f,    0.00015395f,
+    -0.00013057f,    0.00007825f,    -0.00000644f,    -0.00007063f,    0.00013682f,
+    -0.00017753f,    0.00018303f,    -0.00015079f,    0.00008637f,    -0.00000245f,
+    -0.00008373f,    0.00015404f,    -0.00019349f,    0.00019354f,    -0.00015414f,
+    0.00008375f,    0.00000245f,    -0.00008603f,    0.00014944f,    -0.00018001f,
+    0.00017270f,    -0.00013109f,    0.00006631f,    0.00000589f,    -0.00006907f,
+    0.00011016f,    -0.00012252f,    0.00010729f,    -0.00007264f,    0.00003114f,
+    0.00000410f,    -0.00002331f,    0.00002302f,    -0.00000714f,    -0.00001423f,
+    0.00002803f,    -0.00002261f,    -0.00000789f,    0.00006058f,    -0.00012322f,
+    0.00017656f,    -0.00019916f,    0.00017367f,    -0.00009297f,    -0.00003567f,
+    0.00018980f,    -0.00033512f,    0.00043258f,    -0.00044788f,    0.00036124f,
+    -0.00017482f,    -0.00008432f,    0.00036718f,    -0.00061158f,    0.00075538f,
+    -0.00075141f,    0.00058061f,    -0.00025999f,    -0.00015701f,    0.00058872f,
+    -0.00094096f,    0.00112734f,    -0.00108967f,    0.00081401f,    -0.00033793f,
+    -0.00025322f,    0.00084127f,    -0.00129889f,    0.00151708f,    -0.00143077f,
+    0.00103642f,    -0.00039707f,    -0.00036697f,    0.00110089f,    -0.00164705f,
+    0.00187923f,    -0.00173179f,    0.00121709f,    -0.00042659f,    -0.00048533f,
+    0.00133204f,    -0.00193362f,    0.00215596f,    -0.00194111f,    0.00132214f,
+    -0.00041851f,    -0.00058742f,    0.00148823f,    -0.00209550f,    0.00228045f,
+    -0.00200236f,    0.00131798f,    -0.00036983f,    -0.00064436f,    0.00151427f,
+    -0.00206243f,    0.00218217f,    -0.00185970f,    0.00117541f,    -0.00028419f,
+    -0.00062043f,    0.00135008f,    -0.00176299f,    0.00179365f,    -0.00146394f,
+    0.00087364f,    -0.00017303f,    -0.00047535f,    0.00093609f,    -0.00113186f,
+    0.00105819f,    -0.00077894f,    0.00040400f,    -0.00005555f,    -0.00016791f,
+    0.00021975f,    -0.00011783f,    -0.00006239f,    0.00021255f,    -0.00022743f,
+    0.00004229f,    0.00033950f,    -0.00083754f,    0.00130841f,    -0.00158088f,
+    0.00150440f,    -0.00099865f,    0.00009015f,    0.00107573f,    -0.00225374f,
+    0.00314759f,    -0.00347946f,    0.00306457f,    -0.00187229f,    0.00005653f,
+    0.00205583f,    -0.00402058f,    0.00536723f,    -0.00570720f,    0.00483510f,
+    -0.00279796f,    -0.00008717f,    0.00327657f,    -0.00610005f,    0.00789995f,
+    -0.00818064f,    0.00673486f,    -0.00371636f,    -0.00036248f,    0.00471343f,
+    -0.00842339f,    0.01064512f,    -0.01078772f,    0.00866487f,    -0.00456460f,
+    -0.00078000f,    0.00631937f,    -0.01089330f,    0.01347397f,    -0.01339498f,
+    0.01051584f,    -0.00528226f,    -0.00133646f,    0.00802605f,    -0.01338913f,
+    0.01623812f,    -0.01585743f,    0.01217724f,    -0.00581745f,    -0.00201319f,
+    0.00974742f,    -0.01577513f,    0.01878061f,    -0.01803011f,    0.01354680f,
+    -0.00613211f,    -0.00277638f,    0.01138555f,    -0.01791071f,    0.02094855f,
+    -0.01978032f,    0.01453964f,    -0.00620598f,    -0.00357913f,    0.01283836f,
+    -0.01966212f,    0.02260606f,    -0.02099909f,    0.01509580f,    -0.00603860f,
+    -0.00436531f,    0.01400835f,    -0.02091402f,    0.02364625f,    -0.02161086f,
+    0.01518551f,    -0.00564927f,    -0.00507477f,    0.01481153f,    -0.02158005f,
+    0.02400080f,    -0.02158005f,    0.01481153f,    -0.00507477f,    -0.00564927f,
+    0.01518551f,    -0.02161086f,    0.02364625f,    -0.02091402f,    0.01400835f,
+    -0.00436531f,    -0.00603860f,    0.01509580f,    -0.02099909f,    0.02260606f,
+    -0.01966212f,    0.01283836f,    -0.00357913f,    -0.00620598f,    0.01453964f,
+    -0.01978032f,    0.02094855f,    -0.01791071f,    0.01138555f,    -0.00277638f,
+    -0.00613211f,    0.01354680f,    -0.01803011f,    0.01878061f,    -0.01577513f,
+    0.00974742f,    -0.00201319f,    -0.00581745f,    0.01217724f,    -0.01585743f,
+    0.01623812f,    -0.01338913f,    0.00802605f,    -0.00133646f,    -0.00528226f,
+    0.01051584f,    -0.01339498f,    0.01347397f,    -0.01089330f,    0.00631937f,
+    -0.00078000f,    -0.00456460f,    0.00866487f,    -0.01078772f,    0.01064512f,
+    -0.00842339f,    0.00471343f,    -0.00036248f,    -0.00371636f,    0.00673486f,
+    -0.00818064f,    0.00789995f,    -0.00610005f,    0.00327657f,    -0.00008717f,
+    -0.00279796f,    0.00483510f,    -0.00570720f,    0.00536723f,    -0.00402058f,
+    0.00205583f,    0.00005653f,    -0.00187229f,    0.00306457f,    -0.00347946f,
+    0.00314759f,    -0.00225374f,    0.00107573f,    0.00009015f,    -0.00099865f,
+    0.00150440f,    -0.00158088f,    0.00130841f,    -0.00083754f,    0.00033950f,
+    0.00004229f,    -0.00022743f,    0.00021255f,    -0.00006239f,    -0.00011783f,
+    0.00021975f,    -0.00016791f,    -0.00005555f,    0.00040400f,    -0.00077894f,
+    0.00105819f,    -0.00113186f,    0.00093609f,    -0.00047535f,    -0.00017303f,
+    0.00087364f,    -0.00146394f,    0.00179365f,    -0.00176299f,    0.00135008f,
+    -0.00062043f,    -0.00028419f,    0.00117541f,    -0.00185970f,    0.00218217f,
+    -0.00206243f,    0.00151427f,    -0.00064436f,    -0.00036983f,    0.00131798f,
+    -0.00200236f,    0.00228045f,    -0.00209550f,    0.00148823f,    -0.00058742f,
+    -0.00041851f,    0.00132214f,    -0.00194111f,    0.00215596f,    -0.00193362f,
+    0.00133204f,    -0.00048533f,    -0.00042659f,    0.00121709f,    -0.00173179f,
+    0.00187923f,    -0.00164705f,    0.00110089f,    -0.00036697f,    -0.00039707f,
+    0.00103642f,    -0.00143077f,    0.00151708f,    -0.00129889f,    0.00084127f,
+    -0.00025322f,    -0.00033793f,    0.00081401f,    -0.00108967f,    0.00112734f,
+    -0.00094096f,    0.00058872f,    -0.00015701f,    -0.00025999f,    0.00058061f,
+    -0.00075141f,    0.00075538f,    -0.00061158f,    0.00036718f,    -0.00008432f,
+    -0.00017482f,    0.00036124f,    -0.00044788f,    0.00043258f,    -0.00033512f,
+    0.00018980f,    -0.00003567f,    -0.00009297f,    0.00017367f,    -0.00019916f,
+    0.00017656f,    -0.00012322f,    0.00006058f,    -0.00000789f,    -0.00002261f,
+    0.00002803f,    -0.00001423f,    -0.00000714f,    0.00002302f,    -0.00002331f,
+    0.00000410f,    0.00003114f,    -0.00007264f,    0.00010729f,    -0.00012252f,
+    0.00011016f,    -0.00006907f,    0.00000589f,    0.00006631f,    -0.00013109f,
+    0.00017270f,    -0.00018001f,    0.00014944f,    -0.00008603f,    0.00000245f,
+    0.00008375f,    -0.00015414f,    0.00019354f,    -0.00019349f,    0.00015404f,
+    -0.00008373f,    -0.00000245f,    0.00008637f,    -0.00015079f,    0.00018303f,
+    -0.00017753f,    0.00013682f,    -0.00007063f,    -0.00000644f,    0.00007825f,
+    -0.00013057f,    0.00015395f,    -0.00014544f,    0.00010882f,    -0.00005336f,
+    -0.00000848f,    0.00006383f,    -0.00010214f,    0.00011717f,    -0.00010792f,
+    0.00007841f,    -0.00003641f,    -0.00000851f,    0.00004712f,    -0.00007240f,
+    0.00008077f,    -0.00007246f,    0.00005104f,    -0.00002233f,    -0.00000707f,
+    0.00003122f,    -0.00004604f,    0.00004984f,    -0.00004341f,    0.00002953f,
+    -0.00001208f,    -0.00000493f,    0.00001815f,    -0.00002558f,    0.00002672f,
+    -0.00002246f,    0.00001464f,    -0.00000552f,    -0.00000280f,    0.00000878f,
+    -0.00001170f,    0.00001163f,    -0.00000928f,    0.00000568f,    -0.00000192f,
+    -0.00000116f,    0.00000307f,    -0.00000372f,    0.00000335f,    -0.00000239f,
+    0.00000126f,    -0.00000034f,    -0.00000020f,    0.00000036f,    -0.00000023f,
+    0.00000000f
+};
+
+static const float iir_b[IIR_ORDER + 1] = {
+    0.00000183f,    0.00000000f,    -0.00000734f,    0.00000000f,    0.00001100f,
+    0.00000000f,    -0.00000734f,    0.00000000f,    0.00000183f
+};
+
+static const float iir_a[IIR_ORDER + 1] = {
+    1.00000000f,    7.02304703f,    22.30293591f,    41.70276851f,    50.14902415f,
+    39.69766893f,    20.20983608f,    6.05798954f,    0.82112514f
+};
+
+static const float iir_sos[IIR_SECTIONS * 6] = {
+    1.8338017800e-06f,    0.00000000f,    -1.8338017800e-06f,    1.00000000f,    1.80420940f,    0.97359060f,
+    1.00000000f,    0.00000000f,    -1.00000000f,    1.00000000f,    1.75308744f,    0.93461512f,
+    1.00000000f,    0.00000000f,    -1.00000000f,    1.00000000f,    1.72518758f,    0.93072570f,
+    1.00000000f,    0.00000000f,    -1.00000000f,    1.00000000f,    1.74056262f,    0.96956843f
+
+};
+
+static const complex_float lms_weights[LMS_NTAPS] = {
+    {0.0f, 0.0f}
+};
+
+static const complex_float rls_weights[RLS_NTAPS] = {
+    {0.0f, 0.0f}
+};
+
+#endif // COEFFS_H
@@ -0,0 +1,73 @@
+#include <stdlib.h>
+#include <string.h>
+#include "cfir_filter.h"
+#include "dsp_stats.h"
+#include "dsp_dispatch.h"
+
+int cfir_filter_init(cfir_filter *fir, const float *coefficients, int length) {
+    if (!fir || !coefficients || length <= 0) {
+        return -1;
+    }
+
+    fir->length = length;
+    fir->coefficients = (float*)malloc(2 * length * sizeof(float));
+    fir->buffer = (float*)calloc(4 * length, sizeof(float));
+    if (!fir->coefficients || !fir->buffer) {
+        cfir_filter_free(fir);
+        return -2;
+    }
+
+    for (int i = 0; i < length; i++) {
+        fir->coefficients[2 * i] = coefficients[length - 1 - i];
+        fir->coefficients[2 * i + 1] = coefficients[length - 1 - i];
+    }
+    fir->position = 0;
+    return 0;
+}
+
+void cfir_filter_free(cfir_filter *fir) {
+    if (fir) {
+        free(fir->coefficients);
+        free(fir->buffer);
+        fir->coefficients = NULL;
+        fir->buffer = NULL;
+    }
+}
+
+static void cfir_filter_run(cfir_filter *fir, const complex_float *in,
+                            complex_float *out, int n) {
+    const dsp_kernels *kernels = dsp_dispatch();
+    float *buffer = fir->buffer;
+    int length = fir->length;
+    int position = fir->position;
+
+    for (int i = 0; i < n; i++) {
+        buffer[2 * position] = in[i].real;
+        buffer[2 * position + 1] = in[i].imag;
+        buffer[2 * (position + length)] = in[i].real;
+        buffer[2 * (position + length) + 1] = in[i].imag;
+        position++;
+        if (position == length) {
+            position = 0;
+        }
+        float acc[2];
+        kernels->dot_real_complex(fir->coefficients, buffer + 2 * position, length, acc);
+        out[i].real = acc[0];
+        out[i].imag = acc[1];
+    }
+
+    fir->position = position;
+}
+
+void cfir_filter_process_block(cfir_filter *fir, const complex_float *in,
+                               complex_float *out, int n) {
+    DSP_STATS_BEGIN(probe);
+    cfir_filter_run(fir, in, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_FIR, n);
+}
+
+complex_float cfir_filter_process(cfir_filter *fir, complex_float input) {
+    complex_float output;
+    cfir_filter_run(fir, &input, &output, 1);
+    return output;
+}
@@ -0,0 +1,22 @@
+#ifndef CFIR_FILTER_H
+#define CFIR_FILTER_H
+
+#include "complex_float.h"
+
+// КИХ фильтр комплексного сигнала с общими действительными коэффициентами.
+// Составляющие I и Q обрабатываются за один проход по зеркальной линии
+// задержки из чередующихся отсчетов (см. fir_filter).
+typedef struct {
+    float *coefficients;  // коэффициенты в обратном порядке, каждый продублирован для re и im
+    float *buffer;        // зеркальная линия задержки, 2 * length комплексных отсчетов
+    int length;
+    int position;
+} cfir_filter;
+
+int cfir_filter_init(cfir_filter *fir, const float *coefficients, int length);
+void cfir_filter_free(cfir_filter *fir);
+complex_float cfir_filter_process(cfir_filter *fir, complex_float input);
+void cfir_filter_process_block(cfir_filter *fir, const complex_float *in,
+                               complex_float *out, int n);
+
+#endif // CFIR_FILTER_H
@@ -0,0 +1,117 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ciir_filter.h"
+#include "dsp_stats.h"
+#include "dsp_dispatch.h"
+
+int ciir_filter_init(ciir_filter *filter, const float *b_coeffs, int b_length,
+                     const float *a_coeffs, int a_length) {
+    if (!filter || b_length <= 0 || b_length % 3 != 0 || b_length != a_length) {
+        return -1;
+    }
+
+    filter->num_sections = b_length / 3;
+    filter->external = 0;
+    filter->coeffs = (float*)calloc(5 * filter->num_sections, sizeof(float));
+    filter->state = (float*)calloc(4 * filter->num_sections, sizeof(float));
+    if (!filter->coeffs || !filter->state) {
+        ciir_filter_free(filter);
+        return -2;
+    }
+
+    if (b_coeffs && a_coeffs) {
+        for (int i = 0; i < filter->num_sections; i++) {
+            const float *b = &b_coeffs[3 * i];
+            const float *a = &a_coeffs[3 * i];
+            if (ciir_filter_set_section(filter, i, b[0], b[1], b[2], a[0], a[1], a[2]) != 0) {
+                ciir_filter_free(filter);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int ciir_filter_init_sos(ciir_filter *filter, const float *sos, int num_sections) {
+    return ciir_filter_init_sos_ws(filter, sos, num_sections, NULL);
+}
+
+size_t ciir_filter_workspace_size(int num_sections) {
+    return workspace_align(5 * num_sections * sizeof(float)) +
+           workspace_align(4 * num_sections * sizeof(float));
+}
+
+int ciir_filter_init_sos_ws(ciir_filter *filter, const float *sos, int num_sections,
+                            workspace *ws) {
+    if (!filter || !sos || num_sections <= 0) {
+        return -1;
+    }
+
+    filter->num_sections = num_sections;
+    filter->external = ws != NULL;
+    filter->coeffs = (float*)workspace_calloc(ws, 5 * num_sections, sizeof(float));
+    filter->state = (float*)workspace_calloc(ws, 4 * num_sections, sizeof(float));
+    if (!filter->coeffs || !filter->state) {
+        ciir_filter_free(filter);
+        return -2;
+    }
+
+    for (int i = 0; i < num_sections; i++) {
+        const float *row = &sos[6 * i];
+        if (ciir_filter_set_section(filter, i, row[0], row[1], row[2],
+                                    row[3], row[4], row[5]) != 0) {
+            ciir_filter_free(filter);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int ciir_filter_set_section(ciir_filter *filter, int section,
+                            float b0, float b1, float b2,
+                            float a0, float a1, float a2) {
+    if (section < 0 || section >= filter->num_sections || a0 == 0.0f) {
+        return -1;
+    }
+    float *c = &filter->coeffs[5 * section];
+    c[0] = b0 / a0;
+    c[1] = b1 / a0;
+    c[2] = b2 / a0;
+    c[3] = a1 / a0;
+    c[4] = a2 / a0;
+    return 0;
+}
+
+void ciir_filter_free(ciir_filter *filter) {
+    if (filter) {
+        if (!filter->external) {
+            free(filter->coeffs);
+            free(filter->state);
+        }
+        filter->coeffs = NULL;
+        filter->state = NULL;
+        filter->num_sections = 0;
+    }
+}
+
+// Каскад секций - ядро активного набора команд (dsp_dispatch.h)
+static void ciir_filter_run(ciir_filter *filter, const complex_float *in,
+                            complex_float *out, int n) {
+    if (in != out) {
+        memmove(out, in, n * sizeof(complex_float));
+    }
+    dsp_dispatch()->cbiquad(filter->coeffs, filter->state, filter->num_sections, out, n);
+}
+
+void ciir_filter_process_block(ciir_filter *filter, const complex_float *in,
+                               complex_float *out, int n) {
+    DSP_STATS_BEGIN(probe);
+    ciir_filter_run(filter, in, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_IIR, n);
+}
+
+complex_float ciir_filter_process(ciir_filter *filter, complex_float input) {
+    complex_float output;
+    ciir_filter_run(filter, &input, &output, 1);
+    return output;
+}
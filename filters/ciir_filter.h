@@ -0,0 +1,37 @@
+#ifndef CIIR_FILTER_H
+#define CIIR_FILTER_H
+
+#include "complex_float.h"
+#include "workspace.h"
+
+// БИХ фильтр комплексного сигнала: каскад биквадратных секций с общими
+// действительными коэффициентами. Коэффициенты нормируются на a0 при
+// инициализации, состояние секции - два комплексных отсчета (транспонированная
+// прямая форма II), I и Q обновляются парой.
+typedef struct {
+    float *coeffs;     // b0, b1, b2, a1, a2 для каждой секции
+    float *state;      // s1.re, s1.im, s2.re, s2.im для каждой секции
+    int num_sections;
+    int external;      // массивы в рабочей области (ciir_filter_free их не освобождает)
+} ciir_filter;
+
+// Коэффициенты задаются тройками (b0, b1, b2) и (a0, a1, a2) на секцию,
+// как в iir_filter_init
+int ciir_filter_init(ciir_filter *filter, const float *b_coeffs, int b_length,
+                     const float *a_coeffs, int a_length);
+// Инициализация по матрице SOS (строки b0, b1, b2, a0, a1, a2), как iir_filter_init_sos
+int ciir_filter_init_sos(ciir_filter *filter, const float *sos, int num_sections);
+// То же с массивами из рабочей области ws (NULL - из кучи)
+int ciir_filter_init_sos_ws(ciir_filter *filter, const float *sos, int num_sections,
+                            workspace *ws);
+size_t ciir_filter_workspace_size(int num_sections);
+int ciir_filter_set_section(ciir_filter *filter, int section,
+                            float b0, float b1, float b2,
+                            float a0, float a1, float a2);
+void ciir_filter_free(ciir_filter *filter);
+complex_float ciir_filter_process(ciir_filter *filter, complex_float input);
+// in и out могут совпадать
+void ciir_filter_process_block(ciir_filter *filter, const complex_float *in,
+                               complex_float *out, int n);
+
+#endif // CIIR_FILTER_H
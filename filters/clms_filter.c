@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include <string.h>
+#include "clms_filter.h"
+#include "dsp_stats.h"
+#include "dsp_dispatch.h"
+
+int clms_filter_init(clms_filter *filter, int length, float mu) {
+    return clms_filter_init_ws(filter, length, mu, NULL);
+}
+
+size_t clms_filter_workspace_size(int length) {
+    return workspace_align(2 * length * sizeof(float)) + workspace_align(4 * length * sizeof(float));
+}
+
+int clms_filter_init_ws(clms_filter *filter, int length, float mu, workspace *ws) {
+    if (!filter || length <= 0 || mu <= 0.0f) {
+        return -1;
+    }
+
+    filter->length = length;
+    filter->mu = mu;
+    filter->external = ws != NULL;
+    filter->weights = (float*)workspace_calloc(ws, 2 * length, sizeof(float));
+    filter->buffer = (float*)workspace_calloc(ws, 4 * length, sizeof(float));
+    if (!filter->weights || !filter->buffer) {
+        clms_filter_free(filter);
+        return -2;
+    }
+
+    filter->position = 0;
+    return 0;
+}
+
+void clms_filter_free(clms_filter *filter) {
+    if (filter) {
+        if (!filter->external) {
+            free(filter->weights);
+            free(filter->buffer);
+        }
+        filter->weights = NULL;
+        filter->buffer = NULL;
+    }
+}
+
+static void clms_filter_run(clms_filter *filter, const complex_float *in,
+                            const complex_float *desired, complex_float *out, int n) {
+    const dsp_kernels *kernels = dsp_dispatch();
+    float *buffer = filter->buffer;
+    int length = filter->length;
+    int position = filter->position;
+
+    for (int i = 0; i < n; i++) {
+        buffer[2 * position] = in[i].real;
+        buffer[2 * position + 1] = in[i].imag;
+        buffer[2 * (position + length)] = in[i].real;
+        buffer[2 * (position + length) + 1] = in[i].imag;
+        position++;
+        if (position == length) {
+            position = 0;
+        }
+        const float *x = buffer + 2 * position;
+
+        float y[2];
+        kernels->cdot_conj(filter->weights, x, length, y);
+
+        // w += mu * conj(e) * x
+        float er = desired[i].real - y[0];
+        float ei = desired[i].imag - y[1];
+        kernels->caxpy(filter->weights, x, length, filter->mu * er, -filter->mu * ei);
+
+        out[i].real = y[0];
+        out[i].imag = y[1];
+    }
+
+    filter->position = position;
+}
+
+void clms_filter_process_block(clms_filter *filter, const complex_float *in,
+                               const complex_float *desired, complex_float *out, int n) {
+    DSP_STATS_BEGIN(probe);
+    clms_filter_run(filter, in, desired, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_LMS, n);
+}
+
+complex_float clms_filter_process(clms_filter *filter, complex_float input,
+                                  complex_float desired) {
+    complex_float output;
+    clms_filter_run(filter, &input, &desired, &output, 1);
+    return output;
+}
@@ -0,0 +1,30 @@
+#ifndef CLMS_FILTER_H
+#define CLMS_FILTER_H
+
+#include "complex_float.h"
+#include "workspace.h"
+
+// Комплексный LMS фильтр: y = w^H * x, e = d - y, w += mu * conj(e) * x.
+// Веса хранятся в порядке линии задержки (от старых отсчетов к новым),
+// линия задержки зеркальная, поэтому оба прохода идут по непрерывной памяти.
+typedef struct {
+    float *weights;    // комплексные веса (re, im)
+    float *buffer;     // зеркальная линия задержки, 2 * length комплексных отсчетов
+    int length;        // длина фильтра
+    float mu;          // шаг адаптации
+    int position;      // текущая позиция в буфере
+    int external;      // массивы в рабочей области (clms_filter_free их не освобождает)
+} clms_filter;
+
+int clms_filter_init(clms_filter *filter, int length, float mu);
+// Массивы из рабочей области ws (NULL - из кучи)
+int clms_filter_init_ws(clms_filter *filter, int length, float mu, workspace *ws);
+size_t clms_filter_workspace_size(int length);
+void clms_filter_free(clms_filter *filter);
+complex_float clms_filter_process(clms_filter *filter, complex_float input,
+                                  complex_float desired);
+// in и out могут совпадать
+void clms_filter_process_block(clms_filter *filter, const complex_float *in,
+                               const complex_float *desired, complex_float *out, int n);
+
+#endif // CLMS_FILTER_H
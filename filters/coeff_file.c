@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "coeff_file.h"
+
+// Таблица CRC-32 по полубайтам: 16 констант, без инициализации при запуске
+static const uint32_t crc32_nibble[16] = {
+    0x00000000u, 0x1db71064u, 0x3b6e20c8u, 0x26d930acu,
+    0x76dc4190u, 0x6b6b51f4u, 0x4db26158u, 0x5005713cu,
+    0xedb88320u, 0xf00f9344u, 0xd6d6a3e8u, 0xcb61b38cu,
+    0x9b64c2b0u, 0x86d3d2d4u, 0xa00ae278u, 0xbdbdf21cu
+};
+
+uint32_t coeff_file_crc32(const void *data, size_t size) {
+    const unsigned char *p = data;
+    uint32_t crc = 0xffffffffu;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= p[i];
+        crc = (crc >> 4) ^ crc32_nibble[crc & 0x0f];
+        crc = (crc >> 4) ^ crc32_nibble[crc & 0x0f];
+    }
+    return ~crc;
+}
+
+// Поля файла little-endian; чтение по байтам не зависит от выравнивания
+static uint32_t read_u32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static void write_u32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static size_t section_floats(coeff_type type, uint32_t count) {
+    return type == COEFF_COMPLEX ? 2 * (size_t)count : (size_t)count;
+}
+
+int coeff_file_open(coeff_file *file, const char *path) {
+    memset(file, 0, sizeof(*file));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < COEFF_FILE_HEADER_SIZE) {
+        close(fd);
+        return -2;
+    }
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+
+    const unsigned char *base = map;
+    int status = 0;
+    uint32_t sections = read_u32(base + 8);
+    if (memcmp(base, COEFF_FILE_MAGIC, 4) != 0) {
+        status = -3;
+    } else if (read_u32(base + 4) != COEFF_FILE_VERSION) {
+        status = -4;
+    } else if (read_u32(base + 12) != size ||
+               sections > (size - COEFF_FILE_HEADER_SIZE) / COEFF_FILE_ENTRY_SIZE) {
+        status = -2;
+    } else if (coeff_file_crc32(base + COEFF_FILE_HEADER_SIZE, size - COEFF_FILE_HEADER_SIZE) !=
+               read_u32(base + 16)) {
+        status = -5;
+    }
+
+    const unsigned char *table = base + COEFF_FILE_HEADER_SIZE;
+    for (uint32_t i = 0; status == 0 && i < sections; i++) {
+        const unsigned char *entry = table + i * COEFF_FILE_ENTRY_SIZE;
+        uint32_t type = read_u32(entry + COEFF_FILE_NAME_SIZE);
+        uint32_t count = read_u32(entry + COEFF_FILE_NAME_SIZE + 4);
+        uint32_t offset = read_u32(entry + COEFF_FILE_NAME_SIZE + 8);
+        size_t bytes = section_floats((coeff_type)type, count) * sizeof(float);
+        if (type > COEFF_COMPLEX || entry[COEFF_FILE_NAME_SIZE - 1] != '\0' ||
+            offset % COEFF_FILE_ALIGN != 0 || offset > size || bytes > size - offset) {
+            status = -6;
+        }
+    }
+    if (status != 0) {
+        munmap(map, size);
+        return status;
+    }
+
+    file->map = map;
+    file->size = size;
+    file->count = (int)sections;
+    file->table = table;
+    return 0;
+}
+
+void coeff_file_close(coeff_file *file) {
+    if (file->map) {
+        munmap(file->map, file->size);
+    }
+    memset(file, 0, sizeof(*file));
+}
+
+const float *coeff_file_find(const coeff_file *file, const char *name, coeff_type type,
+                             int *count) {
+    for (int i = 0; i < file->count; i++) {
+        const unsigned char *entry = file->table + i * COEFF_FILE_ENTRY_SIZE;
+        if (strncmp((const char *)entry, name, COEFF_FILE_NAME_SIZE) != 0 ||
+            read_u32(entry + COEFF_FILE_NAME_SIZE) != (uint32_t)type) {
+            continue;
+        }
+        if (count) {
+            *count = (int)read_u32(entry + COEFF_FILE_NAME_SIZE + 4);
+        }
+        return (const float *)((const unsigned char *)file->map +
+                               read_u32(entry + COEFF_FILE_NAME_SIZE + 8));
+    }
+    return NULL;
+}
+
+int coeff_file_write(const char *path, const coeff_section *sections, int count) {
+    if (!path || !sections || count < 0) {
+        return -1;
+    }
+    size_t size = COEFF_FILE_HEADER_SIZE + (size_t)count * COEFF_FILE_ENTRY_SIZE;
+    for (int i = 0; i < count; i++) {
+        if (!sections[i].name || strlen(sections[i].name) >= COEFF_FILE_NAME_SIZE ||
+            sections[i].count < 0 || (sections[i].count > 0 && !sections[i].data)) {
+            return -1;
+        }
+        size = (size + COEFF_FILE_ALIGN - 1) / COEFF_FILE_ALIGN * COEFF_FILE_ALIGN;
+        size += section_floats(sections[i].type, sections[i].count) * sizeof(float);
+    }
+
+    unsigned char *image = calloc(size, 1);
+    if (!image) {
+        return -2;
+    }
+    memcpy(image, COEFF_FILE_MAGIC, 4);
+    write_u32(image + 4, COEFF_FILE_VERSION);
+    write_u32(image + 8, (uint32_t)count);
+    write_u32(image + 12, (uint32_t)size);
+
+    size_t offset = COEFF_FILE_HEADER_SIZE + (size_t)count * COEFF_FILE_ENTRY_SIZE;
+    for (int i = 0; i < count; i++) {
+        unsigned char *entry = image + COEFF_FILE_HEADER_SIZE + i * COEFF_FILE_ENTRY_SIZE;
+        offset = (offset + COEFF_FILE_ALIGN - 1) / COEFF_FILE_ALIGN * COEFF_FILE_ALIGN;
+        size_t bytes = section_floats(sections[i].type, sections[i].count) * sizeof(float);
+        memcpy(entry, sections[i].name, strlen(sections[i].name));
+        write_u32(entry + COEFF_FILE_NAME_SIZE, (uint32_t)sections[i].type);
+        write_u32(entry + COEFF_FILE_NAME_SIZE + 4, (uint32_t)sections[i].count);
+        write_u32(entry + COEFF_FILE_NAME_SIZE + 8, (uint32_t)offset);
+        if (bytes) {
+            memcpy(image + offset, sections[i].data, bytes);
+        }
+        offset += bytes;
+    }
+    write_u32(image + 16, coeff_file_crc32(image + COEFF_FILE_HEADER_SIZE,
+                                           size - COEFF_FILE_HEADER_SIZE));
+
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        free(image);
+        return -3;
+    }
+    int status = fwrite(image, 1, size, f) == size ? 0 : -4;
+    if (fclose(f) != 0) {
+        status = -4;
+    }
+    free(image);
+    return status;
+}
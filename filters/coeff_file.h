@@ -0,0 +1,65 @@
+#ifndef COEFF_FILE_H
+#define COEFF_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Двоичный файл коэффициентов (пишется filters_calculation.py или
+// coeff_file_write). Все поля little-endian, файл отображается в память
+// целиком, и данные секций читаются прямо из отображения.
+//
+// Заголовок, 32 байта:
+//   char magic[4] = "DSPC", uint32 version, uint32 section_count,
+//   uint32 file_size, uint32 crc32 (по всем байтам после заголовка),
+//   uint32 reserved[3] = 0
+// Таблица секций, section_count записей по 32 байта:
+//   char name[20] (с завершающим нулем), uint32 type, uint32 count,
+//   uint32 offset (от начала файла, кратно COEFF_FILE_ALIGN)
+// Данные: float32; комплексная секция - count пар (re, im).
+
+#define COEFF_FILE_MAGIC "DSPC"
+#define COEFF_FILE_VERSION 1
+#define COEFF_FILE_HEADER_SIZE 32
+#define COEFF_FILE_ENTRY_SIZE 32
+#define COEFF_FILE_NAME_SIZE 20
+#define COEFF_FILE_ALIGN 16
+
+typedef enum {
+    COEFF_REAL = 0,     // count значений float
+    COEFF_COMPLEX = 1   // count значений complex_float
+} coeff_type;
+
+// Описание секции для записи и результат поиска
+typedef struct {
+    const char *name;
+    coeff_type type;
+    int count;
+    const float *data;
+} coeff_section;
+
+typedef struct {
+    void *map;          // отображение файла (только чтение)
+    size_t size;
+    int count;          // число секций
+    const unsigned char *table;
+} coeff_file;
+
+// Открытие и проверка файла: 0 - успех; -1 - файл не открыт, -2 - короткий
+// файл или размер не совпадает с заголовком, -3 - неверная сигнатура,
+// -4 - неподдерживаемая версия, -5 - не совпала контрольная сумма,
+// -6 - секция выходит за пределы файла.
+int coeff_file_open(coeff_file *file, const char *path);
+void coeff_file_close(coeff_file *file);
+
+// Поиск секции по имени и типу. Возвращает указатель внутрь отображения
+// (действителен до coeff_file_close) и число значений в count, либо NULL.
+const float *coeff_file_find(const coeff_file *file, const char *name, coeff_type type,
+                             int *count);
+
+// Запись секций в файл: 0 - успех, отрицательный код - ошибка
+int coeff_file_write(const char *path, const coeff_section *sections, int count);
+
+// CRC-32 (IEEE 802.3, как zlib.crc32)
+uint32_t coeff_file_crc32(const void *data, size_t size);
+
+#endif // COEFF_FILE_H
@@ -0,0 +1,12 @@
+#ifndef COMPLEX_FLOAT_H
+#define COMPLEX_FLOAT_H
+
+// Комплексный отсчет float (re, im подряд, как в массивах float[2 * n]).
+// Отдельно от coeffs.h: модулям, которым нужен только тип, не нужны
+// сгенерированные коэффициенты; coeffs.h подключает этот заголовок
+typedef struct {
+    float real;
+    float imag;
+} complex_float;
+
+#endif // COMPLEX_FLOAT_H
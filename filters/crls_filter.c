@@ -0,0 +1,136 @@
+#include <stdlib.h>
+#include <string.h>
+#include "crls_filter.h"
+#include "dsp_stats.h"
+#include "dsp_dispatch.h"
+
+int crls_filter_init(crls_filter *filter, int length, float lambda, float delta) {
+    return crls_filter_init_ws(filter, length, lambda, delta, NULL);
+}
+
+size_t crls_filter_workspace_size(int length) {
+    return 2 * workspace_align(2 * length * sizeof(float)) +
+           workspace_align(4 * length * sizeof(float)) +
+           workspace_align(2 * (size_t)length * length * sizeof(float));
+}
+
+int crls_filter_init_ws(crls_filter *filter, int length, float lambda, float delta,
+                        workspace *ws) {
+    if (!filter || length <= 0 || lambda <= 0.0f || lambda > 1.0f || delta <= 0.0f) {
+        return -1;
+    }
+
+    filter->length = length;
+    filter->lambda = lambda;
+    filter->delta = delta;
+    filter->external = ws != NULL;
+    filter->weights = (float*)workspace_calloc(ws, 2 * length, sizeof(float));
+    filter->buffer = (float*)workspace_calloc(ws, 4 * length, sizeof(float));
+    filter->Q = (float*)workspace_calloc(ws, 2 * (size_t)length * length, sizeof(float));
+    filter->Px = (float*)workspace_calloc(ws, 2 * length, sizeof(float));
+    if (!filter->weights || !filter->buffer || !filter->Q || !filter->Px) {
+        crls_filter_free(filter);
+        return -2;
+    }
+
+    // P = I / delta
+    for (int i = 0; i < length; i++) {
+        filter->Q[2 * (i * length + i)] = 1.0f / delta;
+    }
+
+    filter->position = 0;
+    return 0;
+}
+
+void crls_filter_free(crls_filter *filter) {
+    if (filter) {
+        if (!filter->external) {
+            free(filter->weights);
+            free(filter->buffer);
+            free(filter->Q);
+            free(filter->Px);
+        }
+        filter->weights = NULL;
+        filter->buffer = NULL;
+        filter->Q = NULL;
+        filter->Px = NULL;
+    }
+}
+
+static void crls_filter_run(crls_filter *filter, const complex_float *in,
+                            const complex_float *desired, complex_float *out, int n) {
+    const dsp_kernels *kernels = dsp_dispatch();
+    int length = filter->length;
+    float *buffer = filter->buffer;
+    float *Q = filter->Q;
+    float *Px = filter->Px;
+    float inv_lambda = 1.0f / filter->lambda;
+
+    for (int t = 0; t < n; t++) {
+        int position = filter->position;
+        buffer[2 * position] = in[t].real;
+        buffer[2 * position + 1] = in[t].imag;
+        buffer[2 * (position + length)] = in[t].real;
+        buffer[2 * (position + length) + 1] = in[t].imag;
+        position++;
+        if (position == length) {
+            position = 0;
+        }
+        filter->position = position;
+        const float *x = buffer + 2 * position;
+
+        float y[2];
+        kernels->cdot_conj(filter->weights, x, length, y);
+        float er = desired[t].real - y[0];
+        float ei = desired[t].imag - y[1];
+
+        // P x: строка i матрицы P равна сопряженной строке i матрицы Q
+        for (int i = 0; i < length; i++) {
+            kernels->cdot_conj(&Q[2 * i * length], x, length, &Px[2 * i]);
+        }
+
+        // lambda + x^H P x (действительное для эрмитовой P)
+        float xPx[2];
+        kernels->cdot_conj(x, Px, length, xPx);
+        float denominator = filter->lambda + xPx[0];
+        float inv_den = 1.0f / denominator;
+
+        // w += k * conj(e), k = P x / denominator
+        kernels->caxpy(filter->weights, Px, length, er * inv_den, -ei * inv_den);
+
+        // Q = (Q - conj(P x) (P x)^T / denominator) / lambda.
+        // Считается только верхний треугольник, нижний заполняется сопряженными
+        // значениями: без этого в float эрмитовость P теряется и фильтр расходится
+        for (int i = 0; i < length; i++) {
+            float ar = -Px[2 * i] * inv_den, ai = Px[2 * i + 1] * inv_den;
+            for (int j = i; j < length; j++) {
+                float *q = &Q[2 * (i * length + j)];
+                float pr = Px[2 * j], pi = Px[2 * j + 1];
+                float qr = (q[0] + ar * pr - ai * pi) * inv_lambda;
+                float qi = (q[1] + ar * pi + ai * pr) * inv_lambda;
+                q[0] = qr;
+                q[1] = qi;
+                Q[2 * (j * length + i)] = qr;
+                Q[2 * (j * length + i) + 1] = -qi;
+            }
+            Q[2 * (i * length + i) + 1] = 0.0f;
+        }
+
+        out[t].real = y[0];
+        out[t].imag = y[1];
+    }
+}
+
+void crls_filter_process_block(crls_filter *filter, const complex_float *in,
+                               const complex_float *desired, complex_float *out, int n) {
+    DSP_STATS_BEGIN(probe);
+    crls_filter_run(filter, in, desired, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_RLS, n);
+}
+
+complex_float crls_filter_process(crls_filter *filter, complex_float input,
+                                  complex_float desired) {
+    complex_float output;
+    crls_filter_run(filter, &input, &desired, &output, 1);
+    return output;
+}
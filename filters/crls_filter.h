@@ -0,0 +1,35 @@
+#ifndef CRLS_FILTER_H
+#define CRLS_FILTER_H
+
+#include "complex_float.h"
+#include "workspace.h"
+
+// Комплексный RLS фильтр: y = w^H * x, k = P x / (lambda + x^H P x),
+// w += k * conj(e), P = (P - k x^H P) / lambda.
+// Матрица P эрмитова, поэтому хранится сопряженной (Q = conj(P) = P^T):
+// тогда P x считается построчными скалярными произведениями.
+typedef struct {
+    float *weights;    // комплексные веса (re, im)
+    float *buffer;     // зеркальная линия задержки, 2 * length комплексных отсчетов
+    float *Q;          // conj(P), length x length комплексных элементов
+    float *Px;         // рабочий вектор P * x
+    int length;        // длина фильтра
+    float lambda;      // фактор забывания
+    float delta;       // параметр регуляризации
+    int position;      // текущая позиция в буфере
+    int external;      // массивы в рабочей области (crls_filter_free их не освобождает)
+} crls_filter;
+
+int crls_filter_init(crls_filter *filter, int length, float lambda, float delta);
+// Массивы из рабочей области ws (NULL - из кучи)
+int crls_filter_init_ws(crls_filter *filter, int length, float lambda, float delta,
+                        workspace *ws);
+size_t crls_filter_workspace_size(int length);
+void crls_filter_free(crls_filter *filter);
+complex_float crls_filter_process(crls_filter *filter, complex_float input,
+                                  complex_float desired);
+// in и out могут совпадать
+void crls_filter_process_block(crls_filter *filter, const complex_float *in,
+                               const complex_float *desired, complex_float *out, int n);
+
+#endif // CRLS_FILTER_H
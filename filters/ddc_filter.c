@@ -0,0 +1,132 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ddc_filter.h"
+#include "dsp_dispatch.h"
+#include "dsp_stats.h"
+#include "filter_design.h"
+
+int ddc_filter_init(ddc_filter *ddc, const float *coefficients, int length,
+                    int factor, float f_center, float fs) {
+    if (!ddc || !coefficients || length <= 0 || factor <= 0 || fs <= 0.0f) {
+        return -1;
+    }
+
+    ddc->length = length;
+    ddc->factor = factor;
+    ddc->phase_length = (length + factor - 1) / factor;
+    int K = ddc->phase_length;
+
+    ddc->coefficients = (float*)calloc(2 * factor * K, sizeof(float));
+    ddc->buffer = (float*)calloc(4 * factor * K, sizeof(float));
+    if (!ddc->coefficients || !ddc->buffer) {
+        ddc_filter_free(ddc);
+        return -2;
+    }
+
+    // Ветвь p: E_p[q] = h[q * factor + p], хранится в обратном порядке
+    for (int p = 0; p < factor; p++) {
+        float *branch = &ddc->coefficients[2 * p * K];
+        for (int q = 0; q < K; q++) {
+            int tap = q * factor + p;
+            float h = (tap < length) ? coefficients[tap] : 0.0f;
+            branch[2 * (K - 1 - q)] = h;
+            branch[2 * (K - 1 - q) + 1] = h;
+        }
+    }
+
+    ddc->position = 0;
+    ddc->branch = 0;
+    ddc->mix = f_center != 0.0f;
+    return oscillator_init(&ddc->nco, f_center, fs) == 0 ? 0 : -1;
+}
+
+void ddc_filter_free(ddc_filter *ddc) {
+    if (ddc) {
+        free(ddc->coefficients);
+        free(ddc->buffer);
+        ddc->coefficients = NULL;
+        ddc->buffer = NULL;
+    }
+}
+
+static int ddc_filter_run(ddc_filter *ddc, const complex_float *in, int n,
+                          complex_float *out) {
+    const dsp_kernels *kernels = dsp_dispatch();
+    int K = ddc->phase_length;
+    int factor = ddc->factor;
+    int produced = 0;
+
+    for (int i = 0; i < n; i++) {
+        float re = in[i].real, im = in[i].imag;
+
+        // Перенос в базовую полосу, как в qpsk_demodulate
+        if (ddc->mix) {
+            complex_float lo = oscillator_next(&ddc->nco);
+            float bb_re = re * lo.real + im * lo.imag;
+            float bb_im = im * lo.real - re * lo.imag;
+            re = bb_re;
+            im = bb_im;
+        }
+
+        float *line = &ddc->buffer[4 * ddc->branch * K];
+        line[2 * ddc->position] = re;
+        line[2 * ddc->position + 1] = im;
+        line[2 * (ddc->position + K)] = re;
+        line[2 * (ddc->position + K) + 1] = im;
+
+        if (ddc->branch > 0) {
+            ddc->branch--;
+            continue;
+        }
+
+        // Ветвь 0 получила отсчет x[m * factor] - считаем выход y[m]
+        ddc->position++;
+        if (ddc->position == K) {
+            ddc->position = 0;
+        }
+        float acc_re = 0.0f, acc_im = 0.0f;
+        for (int p = 0; p < factor; p++) {
+            float acc[2];
+            kernels->dot_real_complex(&ddc->coefficients[2 * p * K],
+                                      &ddc->buffer[4 * p * K + 2 * ddc->position], K, acc);
+            acc_re += acc[0];
+            acc_im += acc[1];
+        }
+        out[produced].real = acc_re;
+        out[produced].imag = acc_im;
+        produced++;
+        ddc->branch = factor - 1;
+    }
+
+    return produced;
+}
+
+int ddc_filter_process_block(ddc_filter *ddc, const complex_float *in, int n,
+                             complex_float *out) {
+    DSP_STATS_BEGIN(probe);
+    int produced = ddc_filter_run(ddc, in, n, out);
+    DSP_STATS_END(probe, DSP_STAGE_DDC, n);
+    return produced;
+}
+
+int ddc_filter_delay(const ddc_filter *ddc) {
+    return ((ddc->length - 1) / 2 + ddc->factor / 2) / ddc->factor;
+}
+
+int ddc_filter_demod_params(const ddc_filter *ddc, const qpsk_params *in,
+                            qpsk_params *out) {
+    if (in->samples_per_sym % ddc->factor != 0) {
+        return -1;
+    }
+    *out = *in;
+    out->f_center = 0.0f;
+    out->fs = in->fs / ddc->factor;
+    out->samples_per_sym = in->samples_per_sym / ddc->factor;
+    return 0;
+}
+
+// ФНЧ для DDC: окно Кайзера с бетой по умолчанию, см. filter_design_fir_lowpass
+int ddc_filter_design_lowpass(float *coefficients, int length, float cutoff, float fs) {
+    return filter_design_fir_lowpass(coefficients, length, cutoff, fs,
+                                     FILTER_DESIGN_KAISER_BETA);
+}
@@ -0,0 +1,48 @@
+#ifndef DDC_FILTER_H
+#define DDC_FILTER_H
+
+#include "../qpsk/qpsk_modem.h"
+#include "oscillator.h"
+
+// Цифровой понижающий преобразователь: перенос в базовую полосу (NCO),
+// ФНЧ и децимация в factor раз в одном проходе. Фильтр разложен на factor
+// полифазных ветвей E_p[k] = h[k * factor + p]; входные отсчеты раздаются
+// по ветвям коммутатором, а свертка считается только для сохраняемых
+// выходных отсчетов - один раз на factor входных.
+typedef struct {
+    float *coefficients;  // ветви подряд, в каждой коэффициенты в обратном порядке, продублированы для re и im
+    float *buffer;        // зеркальные линии задержки ветвей, по 2 * phase_length комплексных отсчетов
+    int length;           // число отводов ФНЧ
+    int factor;           // коэффициент децимации
+    int phase_length;     // отводов на ветвь: ceil(length / factor)
+    int position;         // позиция записи в линиях задержки
+    int branch;           // ветвь, которая получит следующий входной отсчет
+    int mix;              // включен ли перенос частоты
+    oscillator nco;       // NCO переноса в базовую полосу
+} ddc_filter;
+
+// f_center = 0 отключает перенос частоты (сигнал уже в базовой полосе)
+int ddc_filter_init(ddc_filter *ddc, const float *coefficients, int length,
+                    int factor, float f_center, float fs);
+void ddc_filter_free(ddc_filter *ddc);
+
+// Обрабатывает n входных отсчетов, возвращает число записанных выходных
+// (не больше n / factor + 1)
+int ddc_filter_process_block(ddc_filter *ddc, const complex_float *in, int n,
+                             complex_float *out);
+
+// Групповая задержка ФНЧ в выходных отсчетах
+int ddc_filter_delay(const ddc_filter *ddc);
+
+// Параметры для qpsk_demodulate на выходе DDC: сигнал уже в базовой полосе,
+// частота дискретизации и число отсчетов на символ уменьшены в factor раз.
+// -1, если samples_per_sym не делится на factor (символы поплыли бы по времени)
+int ddc_filter_demod_params(const ddc_filter *ddc, const qpsk_params *in,
+                            qpsk_params *out);
+
+// Синтез ФНЧ методом окон через filter_design_fir_lowpass (окно Кайзера,
+// FILTER_DESIGN_KAISER_BETA, как firwin в filters_calculation.py) с единичным
+// усилением на нулевой частоте. 0 - успех, -1 - cutoff вне (0, fs / 2)
+int ddc_filter_design_lowpass(float *coefficients, int length, float cutoff, float fs);
+
+#endif // DDC_FILTER_H
@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+#include "dsp_dispatch.h"
+
+// Таблицы из dsp_kernels_<isa>.c
+extern const dsp_kernels dsp_kernels_scalar;
+extern const dsp_kernels dsp_kernels_sse4;
+extern const dsp_kernels dsp_kernels_avx2;
+extern const dsp_kernels dsp_kernels_avx512;
+
+static const dsp_kernels *const dispatch_tables[DSP_ISA_COUNT] = {
+    &dsp_kernels_scalar, &dsp_kernels_sse4, &dsp_kernels_avx2, &dsp_kernels_avx512
+};
+
+static const char *dispatch_names[DSP_ISA_COUNT] = {"scalar", "sse4", "avx2", "avx512"};
+
+const dsp_kernels *dsp_kernels_active = &dsp_kernels_scalar;
+
+#if defined(__x86_64__) || defined(__i386__)
+// Регистры, сохраняемые ОС при переключении контекста (XCR0)
+static uint64_t dispatch_xcr0(void) {
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+}
+#endif
+
+dsp_isa dsp_dispatch_detect(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1) || !(ecx & bit_SSE4_2)) {
+        return DSP_ISA_SCALAR;
+    }
+    if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX) || !(ecx & bit_FMA)) {
+        return DSP_ISA_SSE4;
+    }
+    // XMM и YMM (биты 1, 2); для AVX-512 еще opmask и ZMM (биты 5-7)
+    uint64_t xcr0 = dispatch_xcr0();
+    if ((xcr0 & 0x6) != 0x6 || !__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) ||
+        !(ebx & bit_AVX2)) {
+        return DSP_ISA_SSE4;
+    }
+    unsigned int avx512 = bit_AVX512F | bit_AVX512DQ | bit_AVX512BW | bit_AVX512VL;
+    if ((ebx & avx512) == avx512 && (xcr0 & 0xe0) == 0xe0) {
+        return DSP_ISA_AVX512;
+    }
+    return DSP_ISA_AVX2;
+#else
+    return DSP_ISA_SCALAR;
+#endif
+}
+
+int dsp_dispatch_init(void) {
+    dsp_isa isa = dsp_dispatch_detect();
+    int status = 0;
+    const char *env = getenv(DSP_ISA_ENV);
+    if (env && *env) {
+        dsp_isa forced;
+        if (dsp_isa_parse(env, &forced) != 0) {
+            status = -1;
+        } else if (forced > isa) {
+            status = -2;
+        } else {
+            isa = forced;
+        }
+    }
+    dsp_kernels_active = dispatch_tables[isa];
+    return status;
+}
+
+// Выбор до main, пока не запущены потоки конвейера; далее таблица меняется
+// только явным dsp_dispatch_select. Неверный DSP_ISA не останавливает
+// программу, но и не проходит молча
+__attribute__((constructor)) static void dispatch_startup(void) {
+    int status = dsp_dispatch_init();
+    if (status != 0) {
+        fprintf(stderr, "%s=%s: %s, используется %s\n", DSP_ISA_ENV, getenv(DSP_ISA_ENV),
+                status == -1 ? "неизвестный набор команд (scalar, sse4, avx2, avx512)"
+                             : "не поддерживается процессором",
+                dsp_isa_name(dsp_dispatch_isa()));
+    }
+}
+
+int dsp_dispatch_select(dsp_isa isa) {
+    if (isa < 0 || isa >= DSP_ISA_COUNT || isa > dsp_dispatch_detect()) {
+        return -1;
+    }
+    dsp_kernels_active = dispatch_tables[isa];
+    return 0;
+}
+
+dsp_isa dsp_dispatch_isa(void) {
+    return dsp_kernels_active->isa;
+}
+
+const dsp_kernels *dsp_dispatch_table(dsp_isa isa) {
+    if (isa < 0 || isa >= DSP_ISA_COUNT || isa > dsp_dispatch_detect()) {
+        return NULL;
+    }
+    return dispatch_tables[isa];
+}
+
+const char *dsp_isa_name(dsp_isa isa) {
+    return (isa >= 0 && isa < DSP_ISA_COUNT) ? dispatch_names[isa] : "unknown";
+}
+
+int dsp_isa_parse(const char *name, dsp_isa *isa) {
+    for (int k = 0; k < DSP_ISA_COUNT; k++) {
+        if (strcmp(name, dispatch_names[k]) == 0) {
+            *isa = (dsp_isa)k;
+            return 0;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,106 @@
+#ifndef DSP_DISPATCH_H
+#define DSP_DISPATCH_H
+
+#include <stdint.h>
+#include "complex_float.h"
+#include "oscillator.h"
+#include "fir_filter.h"
+#include "fixed_point.h"
+
+// Выбор ядер горячего пути по набору команд процессора во время работы.
+// Ядра (dsp_simd.h и циклы фильтров, генератора, демаппера) собираются
+// несколько раз - в единицах dsp_kernels_<isa>.c со своими флагами
+// компилятора - и собираются в таблицы указателей. Одна сборка без -march
+// работает на любом x86-64 и использует AVX2/FMA или AVX-512 там, где они
+// есть. Таблица выбирается один раз при запуске программы (cpuid и
+// проверка сохранения регистров ОС через xgetbv); переменная окружения
+// DSP_ISA=scalar|sse4|avx2|avx512 понижает набор, например для сравнения
+// ядер или воспроизведения результата другой машины.
+//
+// Модули берут указатель таблицы один раз перед циклом, поэтому цена
+// выбора - косвенный вызов на блок (или на отсчет у поотсчетных функций).
+// Ядра разных наборов отличаются порядком суммирования и FMA, поэтому
+// результаты совпадают с точностью до округления, а не побитово.
+
+typedef enum {
+    DSP_ISA_SCALAR = 0,  // без векторных команд
+    DSP_ISA_SSE4,        // SSE4.2
+    DSP_ISA_AVX2,        // AVX2 + FMA
+    DSP_ISA_AVX512,      // AVX-512 F/BW/DQ/VL
+    DSP_ISA_COUNT
+} dsp_isa;
+
+#define DSP_ISA_ENV "DSP_ISA"
+
+typedef struct {
+    dsp_isa isa;
+    // dsp_simd.h
+    float (*dot)(const float *a, const float *b, int n);
+    void (*axpy)(float *y, const float *x, int n, float a);
+    void (*dot_real_complex)(const float *h2, const float *x, int n, float *out);
+    void (*cdot_conj)(const float *w, const float *x, int n, float *out);
+    void (*caxpy)(float *w, const float *x, int n, float ar, float ai);
+    // Ядра fir_filter фиксированной длины в порядке FIR_FIXED_TAPS_LIST
+    float (*fir_dot[FIR_FIXED_COUNT])(const float *coeffs, const float *x);
+    int (*fir_block[FIR_FIXED_COUNT])(const float *coeffs, float *buffer, int position,
+                                      const float *in, float *out, int n);
+    // Каскад биквадратных секций на месте: коэффициенты по 5 на секцию
+    // (b0, b1, b2, a1, a2), состояние по 2 (вещественный) или 4 (комплексный)
+    void (*biquad)(const float *coeffs, float *state, int sections, float *x, int n);
+    void (*cbiquad)(const float *coeffs, float *state, int sections, complex_float *x, int n);
+    // n кадров по channels чередующихся каналов; состояние секции - s1 и s2
+    // по channels значений (iir_filter_set_channels)
+    void (*biquad_frames)(const float *coeffs, float *state, int sections, int channels,
+                          float *x, int n);
+    // Q15 (fir_q15_filter): скалярное произведение int16 с суммой int32 и
+    // m сумм окон x + i длины n (блочный режим)
+    int32_t (*dot_q15)(const int16_t *a, const int16_t *b, int n);
+    void (*fir_q15)(const int16_t *h, const int16_t *x, int n, int32_t *acc, int m);
+    // Каскад секций iir_q15_filter на месте над отсчетами Q31: коэффициенты
+    // по 6 на секцию, состояние по 4; возвращает число насыщений
+    long long (*biquad_q15)(const int32_t *coeffs, int32_t *state, int sections, int32_t *x,
+                            int n, fixed_rounding rounding);
+    // Банк filter_bank, кадры x[j * channels + c]: КИХ с общими коэффициентами
+    // h (m выходных кадров из m + length - 1 входных) и LMS со своими весами
+    // каждого канала (выход y, ошибка e = mu * (d - y), обновление весов)
+    void (*bank_fir)(const float *h, const float *x, int channels, int length, float *y, int m);
+    void (*bank_lms)(float *w, const float *x, const float *d, float mu, int channels,
+                     int length, float *e, float *y, int m);
+    // Генератор несущей: mode 0 - генерация, 1 - умножение на e^{j*phi}, -1 - на e^{-j*phi}
+    void (*oscillator)(oscillator *osc, const complex_float *in, complex_float *out, int n,
+                       int mode);
+    // Демаппер QPSK: 32 символа -> слово жестких решений; LLR (Q, I) * scale
+    uint64_t (*demap_word)(const complex_float *symbols);
+    void (*demap_llr)(const complex_float *symbols, int n, float scale, float *llr);
+} dsp_kernels;
+
+// Активная таблица (до выбора при запуске - скалярная)
+extern const dsp_kernels *dsp_kernels_active;
+
+static inline const dsp_kernels *dsp_dispatch(void) {
+    return dsp_kernels_active;
+}
+
+// Лучший набор, поддерживаемый процессором и ОС
+dsp_isa dsp_dispatch_detect(void);
+
+// Выбор по процессору и DSP_ISA (вызывается при запуске). 0 - успех,
+// -1 - значение DSP_ISA не распознано, -2 - набор из DSP_ISA не
+// поддерживается процессором; в обоих случаях выбирается лучший доступный
+int dsp_dispatch_init(void);
+
+// Явный выбор: 0 или -1, если набор не поддерживается процессором.
+// Фильтры fir_filter, созданные до смены, сохраняют прежние ядра
+int dsp_dispatch_select(dsp_isa isa);
+
+dsp_isa dsp_dispatch_isa(void);
+
+// Таблица набора для сравнения ядер; NULL, если набор не поддерживается
+const dsp_kernels *dsp_dispatch_table(dsp_isa isa);
+
+const char *dsp_isa_name(dsp_isa isa);
+
+// Имя набора (scalar, sse4, avx2, avx512): 0 или -1
+int dsp_isa_parse(const char *name, dsp_isa *isa);
+
+#endif // DSP_DISPATCH_H
@@ -0,0 +1,5 @@
+// Ядра AVX2 + FMA (-mavx2 -mfma)
+#define DSP_KERNELS_TABLE dsp_kernels_avx2
+#define DSP_KERNELS_ISA DSP_ISA_AVX2
+
+#include "dsp_kernels_impl.h"
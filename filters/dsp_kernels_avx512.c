@@ -0,0 +1,6 @@
+// Ядра AVX-512 (-mavx512f -mavx512bw -mavx512dq -mavx512vl): 512-битные
+// dsp_dot, демаппер и LLR, остальное - ветви AVX2 в кодировке EVEX
+#define DSP_KERNELS_TABLE dsp_kernels_avx512
+#define DSP_KERNELS_ISA DSP_ISA_AVX512
+
+#include "dsp_kernels_impl.h"
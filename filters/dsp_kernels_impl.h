@@ -0,0 +1,572 @@
+// Ядра одной таблицы dsp_kernels. Файл подключается только единицами
+// dsp_kernels_<isa>.c: каждая задает имя таблицы DSP_KERNELS_TABLE и набор
+// DSP_KERNELS_ISA и собирается со своими флагами (Makefile), поэтому один и
+// тот же код ниже и ветви dsp_simd.h компилируются под каждый набор команд.
+// Все функции статические: копии разных единиц не смешиваются при сборке.
+
+#include <math.h>
+#include <string.h>
+#include "dsp_dispatch.h"
+#include "dsp_simd.h"
+#include "iir_q15_filter.h"
+
+static float kernel_dot(const float *a, const float *b, int n) {
+    return dsp_dot(a, b, n);
+}
+
+static void kernel_axpy(float *y, const float *x, int n, float a) {
+    dsp_axpy(y, x, n, a);
+}
+
+static void kernel_dot_real_complex(const float *h2, const float *x, int n, float *out) {
+    dsp_dot_real_complex(h2, x, n, out);
+}
+
+static void kernel_cdot_conj(const float *w, const float *x, int n, float *out) {
+    dsp_cdot_conj(w, x, n, out);
+}
+
+static void kernel_caxpy(float *w, const float *x, int n, float ar, float ai) {
+    dsp_caxpy(w, x, n, ar, ai);
+}
+
+// Отсчетов на один проход блочного ядра фиксированной длины
+#define FIR_FIXED_CHUNK 256
+
+// Ядра для фиксированной длины N: dsp_dot встраивается с постоянной длиной,
+// компилятор знает число итераций, убирает ветки хвостов и разворачивает
+// циклы. Блочное ядро вместо зеркальной линии задержки ведет на стеке
+// линейную историю (N - 1 прошлых отсчетов и порция входа), поэтому в
+// цикле нет записи отсчета, которую тут же читает векторная загрузка. Окна
+// и порядок суммирования те же, что у общего ядра той же таблицы, поэтому
+// результат совпадает с FIR_KERNEL_GENERIC побитово.
+#define FIR_FIXED_KERNEL(N) \
+static inline float fir_dot_##N(const float *h, const float *x) { \
+    return dsp_dot(h, x, (N)); \
+} \
+static float fir_dot_call_##N(const float *h, const float *x) { \
+    return fir_dot_##N(h, x); \
+} \
+static int fir_block_##N(const float *h, float *buffer, int position, \
+                         const float *in, float *out, int n) { \
+    float history[(N) - 1 + FIR_FIXED_CHUNK]; \
+    /* последние N - 1 отсчетов лежат непрерывно после самого старого */ \
+    memcpy(history, buffer + position + 1, ((N) - 1) * sizeof(float)); \
+    int offset = 0; \
+    while (offset < n) { \
+        int chunk = (n - offset < FIR_FIXED_CHUNK) ? n - offset : FIR_FIXED_CHUNK; \
+        memcpy(history + (N) - 1, in + offset, chunk * sizeof(float)); \
+        for (int i = 0; i < chunk; i++) { \
+            out[offset + i] = fir_dot_##N(h, history + i); \
+        } \
+        memmove(history, history + chunk, ((N) - 1) * sizeof(float)); \
+        offset += chunk; \
+    } \
+    /* самый старый из последних N отсчетов уже не нужен: линия задержки */ \
+    /* заполняется с позиции 1, чтобы окно начиналось с buffer[0] */ \
+    if (n > 0) { \
+        buffer[0] = buffer[N] = 0.0f; \
+        memcpy(buffer + 1, history, ((N) - 1) * sizeof(float)); \
+        memcpy(buffer + (N) + 1, history, ((N) - 1) * sizeof(float)); \
+        position = 0; \
+    } \
+    return position; \
+}
+
+FIR_FIXED_TAPS_LIST(FIR_FIXED_KERNEL)
+
+#define FIR_FIXED_DOT_ENTRY(N) fir_dot_call_##N,
+#define FIR_FIXED_BLOCK_ENTRY(N) fir_block_##N,
+
+// Каждая секция проходит по всему блоку, пока ее коэффициенты и состояние
+// находятся в регистрах
+static void kernel_biquad(const float *coeffs, float *state, int sections, float *x, int n) {
+    for (int s = 0; s < sections; s++) {
+        const float *c = &coeffs[5 * s];
+        float *st = &state[2 * s];
+        float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+        float s1 = st[0], s2 = st[1];
+
+        for (int t = 0; t < n; t++) {
+            float v = x[t];
+            float y = b0 * v + s1;
+            s1 = b1 * v - a1 * y + s2;
+            s2 = b2 * v - a2 * y;
+            x[t] = y;
+        }
+
+        st[0] = s1;
+        st[1] = s2;
+    }
+}
+
+// То же для комплексного сигнала: I и Q обрабатываются одинаковыми операциями
+static void kernel_cbiquad(const float *coeffs, float *state, int sections,
+                           complex_float *x, int n) {
+    for (int s = 0; s < sections; s++) {
+        const float *c = &coeffs[5 * s];
+        float *st = &state[4 * s];
+        float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+        float s1r = st[0], s1i = st[1], s2r = st[2], s2i = st[3];
+
+        for (int i = 0; i < n; i++) {
+            float xr = x[i].real, xi = x[i].imag;
+            float yr = b0 * xr + s1r;
+            float yi = b0 * xi + s1i;
+            s1r = b1 * xr - a1 * yr + s2r;
+            s1i = b1 * xi - a1 * yi + s2i;
+            s2r = b2 * xr - a2 * yr;
+            s2i = b2 * xi - a2 * yi;
+            x[i].real = yr;
+            x[i].imag = yi;
+        }
+
+        st[0] = s1r;
+        st[1] = s1i;
+        st[2] = s2r;
+        st[3] = s2i;
+    }
+}
+
+// Чередующиеся каналы: внутренний цикл по каналам независим и
+// векторизуется компилятором
+static void kernel_biquad_frames(const float *coeffs, float *state, int sections, int channels,
+                                 float *x, int n) {
+    for (int s = 0; s < sections; s++) {
+        const float *c = &coeffs[5 * s];
+        float *restrict s1 = &state[2 * s * channels];
+        float *restrict s2 = s1 + channels;
+        float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+
+        for (int t = 0; t < n; t++) {
+            float *restrict frame = &x[(size_t)t * channels];
+            for (int ch = 0; ch < channels; ch++) {
+                float v = frame[ch];
+                float y = b0 * v + s1[ch];
+                s1[ch] = b1 * v - a1 * y + s2[ch];
+                s2[ch] = b2 * v - a2 * y;
+                frame[ch] = y;
+            }
+        }
+    }
+}
+
+static int32_t kernel_dot_q15(const int16_t *a, const int16_t *b, int n) {
+    return dsp_dot_q15(a, b, n);
+}
+
+static void kernel_fir_q15(const int16_t *h, const int16_t *x, int n, int32_t *acc, int m) {
+    for (int i = 0; i < m; i++) {
+        acc[i] = dsp_dot_q15(h, x + i, n);
+    }
+}
+
+// Режим округления - константа в каждой копии цикла, поэтому ветвление
+// fixed_round_shift выносится из цикла по отсчетам
+static inline __attribute__((always_inline)) long long kernel_biquad_q15_run(
+    const int32_t *coeffs, int32_t *state, int sections, int32_t *x, int n,
+    fixed_rounding rounding) {
+    long long saturations = 0;
+    for (int s = 0; s < sections; s++) {
+        const int32_t *c = &coeffs[6 * s];
+        int32_t st[4];
+        memcpy(st, &state[4 * s], sizeof(st));
+        for (int t = 0; t < n; t++) {
+            x[t] = iir_q15_section(c, st, x[t], rounding, &saturations);
+        }
+        memcpy(&state[4 * s], st, sizeof(st));
+    }
+    return saturations;
+}
+
+static long long kernel_biquad_q15(const int32_t *coeffs, int32_t *state, int sections,
+                                   int32_t *x, int n, fixed_rounding rounding) {
+    switch (rounding) {
+    case FIXED_ROUND_NEAREST:
+        return kernel_biquad_q15_run(coeffs, state, sections, x, n, FIXED_ROUND_NEAREST);
+    case FIXED_ROUND_CONVERGENT:
+        return kernel_biquad_q15_run(coeffs, state, sections, x, n, FIXED_ROUND_CONVERGENT);
+    default:
+        return kernel_biquad_q15_run(coeffs, state, sections, x, n, FIXED_ROUND_TRUNCATE);
+    }
+}
+
+// Банк фильтров (filter_bank): кадры x[j * K + c] по K каналов. Каналы
+// идут группами по KERNEL_BANK_LANES, аккумуляторы группы остаются в
+// регистрах на все отводы; несколько независимых цепочек сложений, чтобы
+// задержка сложения не ограничивала поток (16 каналов - всего один
+// регистр AVX-512)
+#define KERNEL_BANK_LANES 16
+#if defined(DSP_SIMD_AVX512)
+#define KERNEL_BANK_FRAMES 8
+#define KERNEL_BANK_CHAINS 4
+#elif defined(DSP_SIMD_AVX2)
+#define KERNEL_BANK_FRAMES 4
+#define KERNEL_BANK_CHAINS 4
+#else
+#define KERNEL_BANK_FRAMES 2  // 8 регистров SSE на аккумуляторы из 16
+#define KERNEL_BANK_CHAINS 2
+#endif
+
+// Блок KERNEL_BANK_FRAMES выходных кадров по KERNEL_BANK_LANES каналов
+static inline void kernel_bank_fir_block(const float *h, const float *x, size_t K, int length,
+                                         float *y) {
+#if defined(DSP_SIMD_AVX512)
+    __m512 acc[KERNEL_BANK_FRAMES];
+    for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+        acc[r] = _mm512_setzero_ps();
+    }
+    for (int j = 0; j < length; j++) {
+        const float *xj = x + (size_t)j * K;
+        __m512 hj = _mm512_set1_ps(h[j]);
+        for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+            acc[r] = _mm512_fmadd_ps(hj, _mm512_loadu_ps(xj + r * K), acc[r]);
+        }
+    }
+    for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+        _mm512_storeu_ps(y + r * K, acc[r]);
+    }
+#elif defined(DSP_SIMD_AVX2)
+    __m256 lo[KERNEL_BANK_FRAMES], hi[KERNEL_BANK_FRAMES];
+    for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+        lo[r] = _mm256_setzero_ps();
+        hi[r] = _mm256_setzero_ps();
+    }
+    for (int j = 0; j < length; j++) {
+        const float *xj = x + (size_t)j * K;
+        __m256 hj = _mm256_set1_ps(h[j]);
+        for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+            lo[r] = _mm256_fmadd_ps(hj, _mm256_loadu_ps(xj + r * K), lo[r]);
+            hi[r] = _mm256_fmadd_ps(hj, _mm256_loadu_ps(xj + r * K + 8), hi[r]);
+        }
+    }
+    for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+        _mm256_storeu_ps(y + r * K, lo[r]);
+        _mm256_storeu_ps(y + r * K + 8, hi[r]);
+    }
+#elif defined(DSP_SIMD_SSE)
+    __m128 acc[KERNEL_BANK_FRAMES][KERNEL_BANK_LANES / 4];
+    for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+        for (int q = 0; q < KERNEL_BANK_LANES / 4; q++) {
+            acc[r][q] = _mm_setzero_ps();
+        }
+    }
+    for (int j = 0; j < length; j++) {
+        const float *xj = x + (size_t)j * K;
+        __m128 hj = _mm_set1_ps(h[j]);
+        for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+            for (int q = 0; q < KERNEL_BANK_LANES / 4; q++) {
+                acc[r][q] = _mm_add_ps(acc[r][q], _mm_mul_ps(hj, _mm_loadu_ps(xj + r * K + 4 * q)));
+            }
+        }
+    }
+    for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+        for (int q = 0; q < KERNEL_BANK_LANES / 4; q++) {
+            _mm_storeu_ps(y + r * K + 4 * q, acc[r][q]);
+        }
+    }
+#else
+    float acc[KERNEL_BANK_FRAMES][KERNEL_BANK_LANES] = {{0}};
+    for (int j = 0; j < length; j++) {
+        const float *xj = x + (size_t)j * K;
+        float hj = h[j];
+        for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+            for (int l = 0; l < KERNEL_BANK_LANES; l++) {
+                acc[r][l] += hj * xj[r * K + l];
+            }
+        }
+    }
+    for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+        memcpy(y + r * K, acc[r], sizeof(acc[r]));
+    }
+#endif
+}
+
+static float kernel_bank_fir_one(const float *h, const float *x, size_t channels, int length) {
+    float acc = 0.0f;
+    for (int j = 0; j < length; j++) {
+        acc += h[j] * x[(size_t)j * channels];
+    }
+    return acc;
+}
+
+// КИХ с общими коэффициентами, m выходных кадров: y[t * K + c] =
+// sum_j h[j] * x[(t + j) * K + c]. Цепочки - соседние выходные кадры
+// (FMA в векторных ветвях: единицы ядер собираются с -ffp-contract=off),
+// порядок суммирования каждого отсчета - по отводам подряд
+static void kernel_bank_fir(const float *h, const float *x, int channels, int length,
+                            float *y, int m) {
+    size_t K = (size_t)channels;
+    int t = 0;
+    for (; t + KERNEL_BANK_FRAMES <= m; t += KERNEL_BANK_FRAMES) {
+        int c0 = 0;
+        for (; c0 + KERNEL_BANK_LANES <= channels; c0 += KERNEL_BANK_LANES) {
+            kernel_bank_fir_block(h, x + t * K + c0, K, length, y + t * K + c0);
+        }
+        for (int r = 0; r < KERNEL_BANK_FRAMES; r++) {
+            for (int c = c0; c < channels; c++) {
+                y[(t + r) * K + c] = kernel_bank_fir_one(h, x + (t + r) * K + c, K, length);
+            }
+        }
+    }
+    for (; t < m; t++) {
+        for (int c = 0; c < channels; c++) {
+            y[t * K + c] = kernel_bank_fir_one(h, x + t * K + c, K, length);
+        }
+    }
+}
+
+// LMS со своими весами w[j * K + c] у каждого канала, m кадров: выход,
+// ошибка e[c] = mu * (d - y) и обновление весов по кадру. Цепочки -
+// отводы j по модулю KERNEL_BANK_CHAINS
+static void kernel_bank_lms(float *w, const float *x, const float *d, float mu, int channels,
+                            int length, float *e, float *y, int m) {
+    size_t K = (size_t)channels;
+    for (int t = 0; t < m; t++) {
+        const float *xt = x + t * K;
+        float *yt = y + t * K;
+        int c0 = 0;
+        for (; c0 + KERNEL_BANK_LANES <= channels; c0 += KERNEL_BANK_LANES) {
+            float acc[KERNEL_BANK_CHAINS][KERNEL_BANK_LANES] = {{0}};
+            int j = 0;
+            for (; j + KERNEL_BANK_CHAINS <= length; j += KERNEL_BANK_CHAINS) {
+                for (int r = 0; r < KERNEL_BANK_CHAINS; r++) {
+                    const float *wj = w + (size_t)(j + r) * K + c0;
+                    const float *xj = xt + (size_t)(j + r) * K + c0;
+                    for (int l = 0; l < KERNEL_BANK_LANES; l++) {
+                        acc[r][l] += wj[l] * xj[l];
+                    }
+                }
+            }
+            for (; j < length; j++) {
+                const float *wj = w + (size_t)j * K + c0;
+                const float *xj = xt + (size_t)j * K + c0;
+                for (int l = 0; l < KERNEL_BANK_LANES; l++) {
+                    acc[0][l] += wj[l] * xj[l];
+                }
+            }
+            for (int r = 1; r < KERNEL_BANK_CHAINS; r++) {
+                for (int l = 0; l < KERNEL_BANK_LANES; l++) {
+                    acc[0][l] += acc[r][l];
+                }
+            }
+            memcpy(yt + c0, acc[0], sizeof(acc[0]));
+        }
+        for (int c = c0; c < channels; c++) {
+            float acc = 0.0f;
+            for (int j = 0; j < length; j++) {
+                acc += w[(size_t)j * K + c] * xt[(size_t)j * K + c];
+            }
+            yt[c] = acc;
+        }
+
+        for (int c = 0; c < channels; c++) {
+            e[c] = mu * (d[t * K + c] - yt[c]);
+        }
+        // Обновление весов: по одной векторной операции на отвод
+        for (int j = 0; j < length; j++) {
+            const float *restrict xj = xt + (size_t)j * K;
+            float *restrict wj = w + (size_t)j * K;
+            for (int c = 0; c < channels; c++) {
+                wj[c] += e[c] * xj[c];
+            }
+        }
+    }
+}
+
+#if defined(DSP_SIMD_AVX2)
+// Комплексные произведения пар (re, im) в регистре: a * b и a * conj(b).
+// Отсчет считается одной и той же последовательностью команд в 256-, 128-
+// и 64-битных загрузках, поэтому результат не зависит от положения отсчета
+// в участке (автовекторизация сжимает сюда FMA только в основном цикле)
+static inline __m128 kernel_cmul(__m128 a, __m128 b) {
+    __m128 as = _mm_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_fmaddsub_ps(a, _mm_moveldup_ps(b), _mm_mul_ps(as, _mm_movehdup_ps(b)));
+}
+
+static inline __m128 kernel_cmul_conj(__m128 a, __m128 b) {
+    __m128 as = _mm_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_fmsubadd_ps(a, _mm_moveldup_ps(b), _mm_mul_ps(as, _mm_movehdup_ps(b)));
+}
+
+static inline __m256 kernel_cmul256(__m256 a, __m256 b) {
+    __m256 as = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm256_fmaddsub_ps(a, _mm256_moveldup_ps(b), _mm256_mul_ps(as, _mm256_movehdup_ps(b)));
+}
+
+static inline __m256 kernel_cmul256_conj(__m256 a, __m256 b) {
+    __m256 as = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm256_fmsubadd_ps(a, _mm256_moveldup_ps(b), _mm256_mul_ps(as, _mm256_movehdup_ps(b)));
+}
+
+// Участок с постоянным base: несущая rot[k] * base, затем перенос входа
+static void kernel_oscillator_segment(complex_float base, const complex_float *rot,
+                                      const complex_float *x, complex_float *y, int m,
+                                      int mode) {
+    const float *r = (const float *)rot;
+    const float *xf = (const float *)x;
+    float *yf = (float *)y;
+    __m256 b8 = _mm256_setr_ps(base.real, base.imag, base.real, base.imag,
+                               base.real, base.imag, base.real, base.imag);
+    __m128 b4 = _mm256_castps256_ps128(b8);
+    int k = 0;
+    for (; k + 4 <= m; k += 4) {
+        __m256 c = kernel_cmul256(_mm256_loadu_ps(r + 2 * k), b8);
+        if (mode > 0) {
+            c = kernel_cmul256(_mm256_loadu_ps(xf + 2 * k), c);
+        } else if (mode < 0) {
+            c = kernel_cmul256_conj(_mm256_loadu_ps(xf + 2 * k), c);
+        }
+        _mm256_storeu_ps(yf + 2 * k, c);
+    }
+    for (; k < m; k++) {
+        __m128 c = kernel_cmul(_mm_castpd_ps(_mm_load_sd((const double *)(r + 2 * k))), b4);
+        if (mode != 0) {
+            __m128 v = _mm_castpd_ps(_mm_load_sd((const double *)(xf + 2 * k)));
+            c = mode > 0 ? kernel_cmul(v, c) : kernel_cmul_conj(v, c);
+        }
+        _mm_store_sd((double *)(yf + 2 * k), _mm_castps_pd(c));
+    }
+}
+#endif
+
+// Проход по участкам внутри блоков генератора: на участке base постоянен,
+// поэтому циклы без зависимостей между отсчетами векторизуются компилятором
+// (AVX2 - явные комплексные умножения с FMA)
+static void kernel_oscillator(oscillator *osc, const complex_float *in,
+                              complex_float *restrict out, int n, int mode) {
+    int done = 0;
+    while (done < n) {
+        if (osc->offset == 0) {
+            oscillator_reseed(osc);
+        }
+        int m = OSC_BLOCK - osc->offset;
+        if (m > n - done) m = n - done;
+
+        const complex_float *restrict rot = &osc->rot[osc->offset];
+        const complex_float *x = in + done;
+        complex_float *restrict y = out + done;
+#if defined(DSP_SIMD_AVX2)
+        kernel_oscillator_segment(osc->base, rot, x, y, m, mode);
+#else
+        float br = osc->base.real, bi = osc->base.imag;
+        if (mode == 0) {
+            for (int k = 0; k < m; k++) {
+                y[k].real = br * rot[k].real - bi * rot[k].imag;
+                y[k].imag = br * rot[k].imag + bi * rot[k].real;
+            }
+        } else if (mode > 0) {
+            for (int k = 0; k < m; k++) {
+                float cr = br * rot[k].real - bi * rot[k].imag;
+                float ci = br * rot[k].imag + bi * rot[k].real;
+                float xr = x[k].real, xi = x[k].imag;
+                y[k].real = xr * cr - xi * ci;
+                y[k].imag = xr * ci + xi * cr;
+            }
+        } else {
+            for (int k = 0; k < m; k++) {
+                float cr = br * rot[k].real - bi * rot[k].imag;
+                float ci = br * rot[k].imag + bi * rot[k].real;
+                float xr = x[k].real, xi = x[k].imag;
+                y[k].real = xr * cr + xi * ci;
+                y[k].imag = xi * cr - xr * ci;
+            }
+        }
+#endif
+
+        done += m;
+        osc->offset += m;
+        if (osc->offset == OSC_BLOCK) {
+            osc->offset = 0;
+            osc->phase += osc->step * (uint32_t)OSC_BLOCK;
+        }
+    }
+}
+
+// 32 символа -> одно слово решений. Маска знаков идет в порядке (I, Q)
+// символа, а первый бит - знак Q, поэтому составляющие переставляются
+// внутри символа.
+static uint64_t kernel_demap_word(const complex_float *symbols) {
+    uint64_t word = 0;
+    const float *x = (const float *)symbols;
+#if defined(DSP_SIMD_AVX512)
+    for (int k = 0; k < 4; k++) {
+        __m512 v = _mm512_permute_ps(_mm512_loadu_ps(x + 16 * k), _MM_SHUFFLE(2, 3, 0, 1));
+        word |= (uint64_t)_mm512_movepi32_mask(_mm512_castps_si512(v)) << (16 * k);
+    }
+#elif defined(DSP_SIMD_AVX2)
+    for (int k = 0; k < 8; k++) {
+        __m256 v = _mm256_permute_ps(_mm256_loadu_ps(x + 8 * k), _MM_SHUFFLE(2, 3, 0, 1));
+        word |= (uint64_t)_mm256_movemask_ps(v) << (8 * k);
+    }
+#elif defined(DSP_SIMD_SSE)
+    for (int k = 0; k < 16; k++) {
+        __m128 v = _mm_loadu_ps(x + 4 * k);
+        v = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+        word |= (uint64_t)_mm_movemask_ps(v) << (4 * k);
+    }
+#else
+    for (int k = 0; k < 64; k++) {
+        word |= (uint64_t)(signbit(x[k ^ 1]) ? 1 : 0) << k;
+    }
+#endif
+    return word;
+}
+
+// LLR (Q, I) каждого символа, умноженные на scale
+static void kernel_demap_llr(const complex_float *symbols, int n, float scale, float *llr) {
+    int i = 0;
+    const float *x = (const float *)symbols;
+#if defined(DSP_SIMD_AVX512)
+    __m512 k = _mm512_set1_ps(scale);
+    for (; i + 8 <= n; i += 8) {
+        __m512 v = _mm512_permute_ps(_mm512_loadu_ps(x + 2 * i), _MM_SHUFFLE(2, 3, 0, 1));
+        _mm512_storeu_ps(llr + 2 * i, _mm512_mul_ps(v, k));
+    }
+    if (i < n) {
+        __mmask16 m = (__mmask16)((1u << (2 * (n - i))) - 1);
+        __m512 v = _mm512_permute_ps(_mm512_maskz_loadu_ps(m, x + 2 * i), _MM_SHUFFLE(2, 3, 0, 1));
+        _mm512_mask_storeu_ps(llr + 2 * i, m, _mm512_mul_ps(v, k));
+        i = n;
+    }
+#elif defined(DSP_SIMD_AVX2)
+    __m256 k = _mm256_set1_ps(scale);
+    for (; i + 4 <= n; i += 4) {
+        __m256 v = _mm256_permute_ps(_mm256_loadu_ps(x + 2 * i), _MM_SHUFFLE(2, 3, 0, 1));
+        _mm256_storeu_ps(llr + 2 * i, _mm256_mul_ps(v, k));
+    }
+#elif defined(DSP_SIMD_SSE)
+    __m128 k = _mm_set1_ps(scale);
+    for (; i + 2 <= n; i += 2) {
+        __m128 v = _mm_loadu_ps(x + 2 * i);
+        v = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_ps(llr + 2 * i, _mm_mul_ps(v, k));
+    }
+#endif
+    for (; i < n; i++) {
+        llr[2 * i] = scale * x[2 * i + 1];
+        llr[2 * i + 1] = scale * x[2 * i];
+    }
+}
+
+const dsp_kernels DSP_KERNELS_TABLE = {
+    .isa = DSP_KERNELS_ISA,
+    .dot = kernel_dot,
+    .axpy = kernel_axpy,
+    .dot_real_complex = kernel_dot_real_complex,
+    .cdot_conj = kernel_cdot_conj,
+    .caxpy = kernel_caxpy,
+    .fir_dot = {FIR_FIXED_TAPS_LIST(FIR_FIXED_DOT_ENTRY)},
+    .fir_block = {FIR_FIXED_TAPS_LIST(FIR_FIXED_BLOCK_ENTRY)},
+    .biquad = kernel_biquad,
+    .cbiquad = kernel_cbiquad,
+    .biquad_frames = kernel_biquad_frames,
+    .dot_q15 = kernel_dot_q15,
+    .fir_q15 = kernel_fir_q15,
+    .biquad_q15 = kernel_biquad_q15,
+    .bank_fir = kernel_bank_fir,
+    .bank_lms = kernel_bank_lms,
+    .oscillator = kernel_oscillator,
+    .demap_word = kernel_demap_word,
+    .demap_llr = kernel_demap_llr,
+};
@@ -0,0 +1,7 @@
+// Ядра без векторных команд (интринсики выключены, автовекторизация тоже -
+// см. Makefile): эталон для сравнения и запасной вариант
+#define DSP_SIMD_SCALAR
+#define DSP_KERNELS_TABLE dsp_kernels_scalar
+#define DSP_KERNELS_ISA DSP_ISA_SCALAR
+
+#include "dsp_kernels_impl.h"
@@ -0,0 +1,5 @@
+// Ядра SSE4.2 (-msse4.2): ветви SSE из dsp_simd.h
+#define DSP_KERNELS_TABLE dsp_kernels_sse4
+#define DSP_KERNELS_ISA DSP_ISA_SSE4
+
+#include "dsp_kernels_impl.h"
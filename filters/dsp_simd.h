@@ -0,0 +1,303 @@
+#ifndef DSP_SIMD_H
+#define DSP_SIMD_H
+
+#include <stdint.h>
+
+// Ветви ядер выбираются флагами компиляции единицы трансляции. Единицы
+// dsp_kernels_*.c (см. dsp_dispatch.h) собираются каждая со своими флагами
+// и получают свою копию ядер; DSP_SIMD_SCALAR отключает векторные ветви.
+#if !defined(DSP_SIMD_SCALAR)
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+#define DSP_SIMD_AVX512 1
+#endif
+#if defined(__AVX2__) && defined(__FMA__)
+#define DSP_SIMD_AVX2 1
+#endif
+#if defined(__SSE2__)
+#define DSP_SIMD_SSE2 1
+#endif
+#if defined(__SSE__)
+#define DSP_SIMD_SSE 1
+#endif
+#endif
+
+#if defined(DSP_SIMD_AVX2) || defined(DSP_SIMD_AVX512)
+#include <immintrin.h>
+#elif defined(DSP_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(DSP_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+// Скалярное произведение двух непрерывных массивов float.
+// Порядок суммирования зависит от выбранного ядра (AVX-512, AVX2/FMA, SSE,
+// скалярное), но для одного ядра он фиксирован, поэтому результаты повторяемы.
+static inline float dsp_dot(const float *a, const float *b, int n) {
+    int i = 0;
+    float sum;
+
+#if defined(DSP_SIMD_AVX512)
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+    }
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+    }
+    // Хвост - загрузкой по маске, без скалярного цикла
+    if (i < n) {
+        __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+        acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i), acc1);
+        i = n;
+    }
+    sum = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+#elif defined(DSP_SIMD_AVX2)
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    acc0 = _mm256_add_ps(acc0, acc1);
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    sum = _mm_cvtss_f32(s);
+#elif defined(DSP_SIMD_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps();
+    __m128 acc3 = _mm_setzero_ps();
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(a + i + 8), _mm_loadu_ps(b + i + 8)));
+        acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(a + i + 12), _mm_loadu_ps(b + i + 12)));
+    }
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    __m128 s = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    sum = _mm_cvtss_f32(s);
+#else
+    sum = 0.0f;
+#endif
+
+    for (; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// y[i] += a * x[i]; простой цикл компилятор векторизует сам
+static inline void dsp_axpy(float *y, const float *x, int n, float a) {
+    for (int i = 0; i < n; i++) {
+        y[i] += a * x[i];
+    }
+}
+
+// Ядра для комплексных сигналов работают с чередующимися массивами
+// (re, im, re, im, ...), совместимыми по раскладке с complex_float.
+// Для них используется AVX2/FMA, SSE (базовый набор x86-64) либо скалярный код.
+
+// Свертка комплексного сигнала с действительными коэффициентами за один проход.
+// h2 - коэффициенты, продублированные для re и im (h0, h0, h1, h1, ...),
+// x - n комплексных отсчетов; результат записывается в out[0] (re), out[1] (im).
+static inline void dsp_dot_real_complex(const float *h2, const float *x, int n, float *out) {
+    int i = 0;
+    float re = 0.0f, im = 0.0f;
+
+#if defined(DSP_SIMD_AVX2)
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(h2 + 2 * i), _mm256_loadu_ps(x + 2 * i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(h2 + 2 * i + 8), _mm256_loadu_ps(x + 2 * i + 8), acc1);
+    }
+    acc0 = _mm256_add_ps(acc0, acc1);
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    re = _mm_cvtss_f32(s);
+    im = _mm_cvtss_f32(_mm_shuffle_ps(s, s, 1));
+#elif defined(DSP_SIMD_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(h2 + 2 * i), _mm_loadu_ps(x + 2 * i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(h2 + 2 * i + 4), _mm_loadu_ps(x + 2 * i + 4)));
+    }
+    __m128 s = _mm_add_ps(acc0, acc1);
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    re = _mm_cvtss_f32(s);
+    im = _mm_cvtss_f32(_mm_shuffle_ps(s, s, 1));
+#endif
+
+    for (; i < n; i++) {
+        re += h2[2 * i] * x[2 * i];
+        im += h2[2 * i] * x[2 * i + 1];
+    }
+    out[0] = re;
+    out[1] = im;
+}
+
+// Комплексное скалярное произведение sum(conj(w[i]) * x[i]) для n отсчетов
+static inline void dsp_cdot_conj(const float *w, const float *x, int n, float *out) {
+    int i = 0;
+    float re = 0.0f, im = 0.0f;
+
+#if defined(DSP_SIMD_AVX2)
+    // acc_re накапливает (wr*xr, wi*xi), acc_im - (wr*xi, wi*xr)
+    __m256 acc_re = _mm256_setzero_ps();
+    __m256 acc_im = _mm256_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        __m256 wv = _mm256_loadu_ps(w + 2 * i);
+        __m256 xv = _mm256_loadu_ps(x + 2 * i);
+        __m256 xs = _mm256_permute_ps(xv, _MM_SHUFFLE(2, 3, 0, 1));
+        acc_re = _mm256_fmadd_ps(wv, xv, acc_re);
+        acc_im = _mm256_fmadd_ps(wv, xs, acc_im);
+    }
+    float r[4], m[4];
+    _mm_storeu_ps(r, _mm_add_ps(_mm256_castps256_ps128(acc_re), _mm256_extractf128_ps(acc_re, 1)));
+    _mm_storeu_ps(m, _mm_add_ps(_mm256_castps256_ps128(acc_im), _mm256_extractf128_ps(acc_im, 1)));
+    re = (r[0] + r[2]) + (r[1] + r[3]);
+    im = (m[0] + m[2]) - (m[1] + m[3]);
+#elif defined(DSP_SIMD_SSE)
+    // acc_re накапливает (wr*xr, wi*xi), acc_im - (wr*xi, wi*xr)
+    __m128 acc_re = _mm_setzero_ps();
+    __m128 acc_im = _mm_setzero_ps();
+    for (; i + 2 <= n; i += 2) {
+        __m128 wv = _mm_loadu_ps(w + 2 * i);
+        __m128 xv = _mm_loadu_ps(x + 2 * i);
+        __m128 xs = _mm_shuffle_ps(xv, xv, _MM_SHUFFLE(2, 3, 0, 1));
+        acc_re = _mm_add_ps(acc_re, _mm_mul_ps(wv, xv));
+        acc_im = _mm_add_ps(acc_im, _mm_mul_ps(wv, xs));
+    }
+    float r[4], m[4];
+    _mm_storeu_ps(r, acc_re);
+    _mm_storeu_ps(m, acc_im);
+    re = (r[0] + r[2]) + (r[1] + r[3]);
+    im = (m[0] + m[2]) - (m[1] + m[3]);
+#endif
+
+    for (; i < n; i++) {
+        re += w[2 * i] * x[2 * i] + w[2 * i + 1] * x[2 * i + 1];
+        im += w[2 * i] * x[2 * i + 1] - w[2 * i + 1] * x[2 * i];
+    }
+    out[0] = re;
+    out[1] = im;
+}
+
+// w[i] += a * x[i] для n комплексных отсчетов, a = ar + i*ai
+static inline void dsp_caxpy(float *w, const float *x, int n, float ar, float ai) {
+    int i = 0;
+
+#if defined(DSP_SIMD_AVX2)
+    __m256 va = _mm256_set1_ps(ar);
+    __m256 vb = _mm256_setr_ps(-ai, ai, -ai, ai, -ai, ai, -ai, ai);
+    for (; i + 4 <= n; i += 4) {
+        __m256 xv = _mm256_loadu_ps(x + 2 * i);
+        __m256 xs = _mm256_permute_ps(xv, _MM_SHUFFLE(2, 3, 0, 1));
+        __m256 wv = _mm256_loadu_ps(w + 2 * i);
+        wv = _mm256_fmadd_ps(va, xv, _mm256_fmadd_ps(vb, xs, wv));
+        _mm256_storeu_ps(w + 2 * i, wv);
+    }
+#elif defined(DSP_SIMD_SSE)
+    __m128 va = _mm_set1_ps(ar);
+    __m128 vb = _mm_setr_ps(-ai, ai, -ai, ai);
+    for (; i + 2 <= n; i += 2) {
+        __m128 xv = _mm_loadu_ps(x + 2 * i);
+        __m128 xs = _mm_shuffle_ps(xv, xv, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 wv = _mm_loadu_ps(w + 2 * i);
+        wv = _mm_add_ps(wv, _mm_add_ps(_mm_mul_ps(va, xv), _mm_mul_ps(vb, xs)));
+        _mm_storeu_ps(w + 2 * i, wv);
+    }
+#endif
+
+    for (; i < n; i++) {
+        float xr = x[2 * i], xi = x[2 * i + 1];
+        w[2 * i] += ar * xr - ai * xi;
+        w[2 * i + 1] += ar * xi + ai * xr;
+    }
+}
+
+// Скалярное произведение Q15: сумма a[i] * b[i] в 32-битных частичных суммах
+// (pmaddwd: 32 умножения int16 с попарным сложением за команду AVX-512BW,
+// 16 - AVX2, 8 - SSE2).
+// Переполнение не проверяется: вызывающий выбирает масштаб коэффициентов
+// так, чтобы сумма |a[i]| * 2^15 помещалась в int32 (см. fir_q15_filter).
+static inline int32_t dsp_dot_q15(const int16_t *a, const int16_t *b, int n) {
+    int i = 0;
+    int32_t sum = 0;
+
+#if defined(DSP_SIMD_AVX512) && defined(__AVX512BW__)
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+    for (; i + 64 <= n; i += 64) {
+        acc0 = _mm512_add_epi32(acc0, _mm512_madd_epi16(
+            _mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)));
+        acc1 = _mm512_add_epi32(acc1, _mm512_madd_epi16(
+            _mm512_loadu_si512(a + i + 32), _mm512_loadu_si512(b + i + 32)));
+    }
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm512_add_epi32(acc0, _mm512_madd_epi16(
+            _mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)));
+    }
+    // Хвост - загрузкой по маске, без скалярного цикла
+    if (i < n) {
+        __mmask32 m = (__mmask32)((1u << (n - i)) - 1);
+        acc1 = _mm512_add_epi32(acc1, _mm512_madd_epi16(
+            _mm512_maskz_loadu_epi16(m, a + i), _mm512_maskz_loadu_epi16(m, b + i)));
+        i = n;
+    }
+    sum = _mm512_reduce_add_epi32(_mm512_add_epi32(acc0, acc1));
+#elif defined(DSP_SIMD_AVX2)
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(
+            _mm256_loadu_si256((const __m256i *)(a + i)), _mm256_loadu_si256((const __m256i *)(b + i))));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(
+            _mm256_loadu_si256((const __m256i *)(a + i + 16)), _mm256_loadu_si256((const __m256i *)(b + i + 16))));
+    }
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(
+            _mm256_loadu_si256((const __m256i *)(a + i)), _mm256_loadu_si256((const __m256i *)(b + i))));
+    }
+    acc0 = _mm256_add_epi32(acc0, acc1);
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc0), _mm256_extracti128_si256(acc0, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    sum = _mm_cvtsi128_si32(s);
+#elif defined(DSP_SIMD_SSE2)
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(
+            _mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i))));
+        acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(
+            _mm_loadu_si128((const __m128i *)(a + i + 8)), _mm_loadu_si128((const __m128i *)(b + i + 8))));
+    }
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(
+            _mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i))));
+    }
+    __m128i s = _mm_add_epi32(acc0, acc1);
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    sum = _mm_cvtsi128_si32(s);
+#endif
+
+    for (; i < n; i++) {
+        sum += (int32_t)a[i] * b[i];
+    }
+    return sum;
+}
+
+#endif // DSP_SIMD_H
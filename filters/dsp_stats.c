@@ -0,0 +1,261 @@
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "dsp_stats.h"
+
+#define STATS_CALIBRATION_NS 20000000LL  // длительность калибровки TSC
+
+static const char* stats_stage_names[DSP_STAGE_COUNT] = {
+    "modulate", "noise", "fir", "iir", "lms", "rls", "ddc", "mix", "matched", "slice"
+};
+
+static dsp_stage_stats stats_stages[DSP_STAGE_COUNT];
+static int stats_hardware;
+static double stats_hz;
+
+// Аппаратные счетчики потока: группа (промахи кэша, промахи ветвлений),
+// читаемая одним вызовом read. -2 - еще не открыты, -1 - недоступны
+static __thread int stats_fd_cache = -2;
+static __thread int stats_fd_branch = -1;
+static pthread_key_t stats_key;
+static pthread_once_t stats_key_once = PTHREAD_ONCE_INIT;
+
+static inline uint64_t stats_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static uint64_t stats_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void stats_close_thread(void) {
+    if (stats_fd_branch >= 0) {
+        close(stats_fd_branch);
+    }
+    if (stats_fd_cache >= 0) {
+        close(stats_fd_cache);
+    }
+    stats_fd_cache = -2;
+    stats_fd_branch = -1;
+}
+
+// Деструктор ключа потока: закрытие его счетчиков при завершении
+static void stats_thread_exit(void* value) {
+    (void)value;
+    stats_close_thread();
+}
+
+static void stats_key_create(void) {
+    pthread_key_create(&stats_key, stats_thread_exit);
+}
+
+static int stats_open_event(uint64_t config, int group) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+// Открытие счетчиков вызывающего потока: 0 или -1
+static int stats_open_thread(void) {
+    if (stats_fd_cache != -2) {
+        return stats_fd_cache >= 0 ? 0 : -1;
+    }
+    stats_fd_cache = stats_open_event(PERF_COUNT_HW_CACHE_MISSES, -1);
+    if (stats_fd_cache >= 0) {
+        stats_fd_branch = stats_open_event(PERF_COUNT_HW_BRANCH_MISSES, stats_fd_cache);
+        if (stats_fd_branch < 0) {
+            close(stats_fd_cache);
+            stats_fd_cache = -1;
+        }
+    }
+    if (stats_fd_cache < 0) {
+        stats_fd_cache = -1;
+        return -1;
+    }
+    pthread_once(&stats_key_once, stats_key_create);
+    pthread_setspecific(stats_key, &stats_fd_cache);
+    return 0;
+}
+
+// Значения группы: число счетчиков и по значению на каждый
+static int stats_read_hw(uint64_t* cache_misses, uint64_t* branch_misses) {
+    uint64_t values[3];
+    if (read(stats_fd_cache, values, sizeof(values)) != (ssize_t)sizeof(values) ||
+        values[0] != 2) {
+        return -1;
+    }
+    *cache_misses = values[1];
+    *branch_misses = values[2];
+    return 0;
+}
+
+int dsp_stats_compiled(void) {
+#ifdef DSP_STATS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+int dsp_stats_init(int hardware) {
+    dsp_stats_reset();
+
+    uint64_t start_ns = stats_now_ns();
+    uint64_t start = stats_cycles();
+    uint64_t now_ns;
+    while ((now_ns = stats_now_ns()) - start_ns < STATS_CALIBRATION_NS) {
+    }
+    stats_hz = (double)(stats_cycles() - start) * 1e9 / (double)(now_ns - start_ns);
+
+    int status = 0;
+    if (hardware) {
+        status = stats_open_thread();
+    }
+    __atomic_store_n(&stats_hardware, hardware && status == 0, __ATOMIC_RELAXED);
+    return status;
+}
+
+void dsp_stats_shutdown(void) {
+    __atomic_store_n(&stats_hardware, 0, __ATOMIC_RELAXED);
+    stats_close_thread();
+}
+
+void dsp_stats_reset(void) {
+    for (int s = 0; s < DSP_STAGE_COUNT; s++) {
+        dsp_stage_stats* st = &stats_stages[s];
+        __atomic_store_n(&st->calls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&st->samples, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&st->cycles, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&st->hw_calls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&st->cache_misses, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&st->branch_misses, 0, __ATOMIC_RELAXED);
+    }
+}
+
+void dsp_stats_begin(dsp_stats_probe* probe) {
+    probe->hw = __atomic_load_n(&stats_hardware, __ATOMIC_RELAXED) && stats_open_thread() == 0 &&
+                stats_read_hw(&probe->cache_misses, &probe->branch_misses) == 0;
+    // Такты читаются последними, чтобы чтение счетчиков не попало в замер
+    probe->cycles = stats_cycles();
+}
+
+void dsp_stats_end(const dsp_stats_probe* probe, dsp_stage stage, long long samples) {
+    uint64_t cycles = stats_cycles() - probe->cycles;
+    dsp_stage_stats* st = &stats_stages[stage];
+    uint64_t cache_misses, branch_misses;
+    if (probe->hw && stats_read_hw(&cache_misses, &branch_misses) == 0) {
+        __atomic_fetch_add(&st->hw_calls, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&st->cache_misses, cache_misses - probe->cache_misses, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&st->branch_misses, branch_misses - probe->branch_misses,
+                           __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&st->calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&st->samples, samples, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&st->cycles, cycles, __ATOMIC_RELAXED);
+}
+
+void dsp_stats_get(dsp_stage stage, dsp_stage_stats* stats) {
+    const dsp_stage_stats* st = &stats_stages[stage];
+    stats->calls = __atomic_load_n(&st->calls, __ATOMIC_RELAXED);
+    stats->samples = __atomic_load_n(&st->samples, __ATOMIC_RELAXED);
+    stats->cycles = __atomic_load_n(&st->cycles, __ATOMIC_RELAXED);
+    stats->hw_calls = __atomic_load_n(&st->hw_calls, __ATOMIC_RELAXED);
+    stats->cache_misses = __atomic_load_n(&st->cache_misses, __ATOMIC_RELAXED);
+    stats->branch_misses = __atomic_load_n(&st->branch_misses, __ATOMIC_RELAXED);
+}
+
+const char* dsp_stats_stage_name(dsp_stage stage) {
+    return (stage >= 0 && stage < DSP_STAGE_COUNT) ? stats_stage_names[stage] : "unknown";
+}
+
+double dsp_stats_tsc_hz(void) {
+    return stats_hz;
+}
+
+static double stats_per_sample(double value, long long samples) {
+    return samples > 0 ? value / (double)samples : 0.0;
+}
+
+void dsp_stats_print(FILE* f) {
+    if (!dsp_stats_compiled()) {
+        fprintf(f, "Счетчики этапов не встроены в сборку (make STATS=1)\n");
+        return;
+    }
+    fprintf(f, "TSC %.3f ГГц, аппаратные счетчики: %s\n", stats_hz / 1e9,
+            stats_hardware ? "включены" : "выключены");
+    // Заголовок выровнен по символам, а не по байтам UTF-8
+    fprintf(f, "  этап         вызовов     отсчетов  тактов/отсч    нс/отсч"
+               "       кэш/1000     ветвл/1000\n");
+    for (int s = 0; s < DSP_STAGE_COUNT; s++) {
+        dsp_stage_stats st;
+        dsp_stats_get((dsp_stage)s, &st);
+        if (st.calls == 0) {
+            continue;
+        }
+        double cycles = stats_per_sample((double)st.cycles, st.samples);
+        fprintf(f, "  %-9s %10lld %12lld %12.3f %10.3f", stats_stage_names[s], st.calls,
+                st.samples, cycles, stats_hz > 0.0 ? cycles * 1e9 / stats_hz : 0.0);
+        if (st.hw_calls > 0) {
+            // Отсчеты пропорционально доле замеров с аппаратными счетчиками
+            double samples = (double)st.samples * st.hw_calls / st.calls;
+            fprintf(f, " %14.3f %14.3f\n", samples > 0.0 ? st.cache_misses * 1000.0 / samples : 0.0,
+                    samples > 0.0 ? st.branch_misses * 1000.0 / samples : 0.0);
+        } else {
+            fprintf(f, " %14s %14s\n", "-", "-");
+        }
+    }
+}
+
+int dsp_stats_write_json(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        return -1;
+    }
+    fprintf(f, "{\n  \"compiled\": %s,\n  \"tsc_hz\": %.0f,\n  \"hardware\": %s,\n"
+               "  \"stages\": [",
+            dsp_stats_compiled() ? "true" : "false", stats_hz, stats_hardware ? "true" : "false");
+    int first = 1;
+    for (int s = 0; s < DSP_STAGE_COUNT; s++) {
+        dsp_stage_stats st;
+        dsp_stats_get((dsp_stage)s, &st);
+        if (st.calls == 0) {
+            continue;
+        }
+        double cycles = stats_per_sample((double)st.cycles, st.samples);
+        fprintf(f, "%s\n    {\"stage\": \"%s\", \"calls\": %lld, \"samples\": %lld, "
+                   "\"cycles\": %llu, \"cycles_per_sample\": %.4f, \"ns_per_sample\": %.4f, "
+                   "\"hw_calls\": %lld, \"cache_misses\": %llu, \"branch_misses\": %llu}",
+                first ? "" : ",", stats_stage_names[s], st.calls, st.samples,
+                (unsigned long long)st.cycles, cycles,
+                stats_hz > 0.0 ? cycles * 1e9 / stats_hz : 0.0, st.hw_calls,
+                (unsigned long long)st.cache_misses, (unsigned long long)st.branch_misses);
+        first = 0;
+    }
+    fprintf(f, "\n  ]\n}\n");
+
+    int status = ferror(f) ? -2 : 0;
+    if (fclose(f) != 0) {
+        status = -2;
+    }
+    return status;
+}
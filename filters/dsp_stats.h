@@ -0,0 +1,89 @@
+#ifndef DSP_STATS_H
+#define DSP_STATS_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Счетчики горячего пути по этапам обработки. Блочные функции модулей
+// (модуляция, шум канала, фильтры, перенос в базовую полосу, согласованный
+// фильтр, решение по символам) отмечают число отсчетов и такты TSC, а при
+// включенных аппаратных счетчиках - еще промахи кэша и предсказания
+// ветвлений (perf_event_open, счет только вызывающего потока). Счетчики
+// этапов общие для всех потоков конвейера и складываются атомарно.
+//
+// Замеры встраиваются только при сборке с -DDSP_STATS (make STATS=1): без
+// него DSP_STATS_BEGIN / DSP_STATS_END пусты и горячий путь не меняется, а
+// функции ниже видят нулевые счетчики. Такты TSC стоят десятки тактов на
+// замер; аппаратные счетчики читаются системным вызовом (порядка
+// микросекунды), поэтому включаются только для диагностики.
+
+typedef enum {
+    DSP_STAGE_MODULATE = 0,  // qpsk_modulator, включая перенос на несущую
+    DSP_STAGE_NOISE,         // шум и помеха канала
+    DSP_STAGE_FIR,           // fir/cfir/fft_fir (отсчет вещественного фильтра - составляющая)
+    DSP_STAGE_IIR,
+    DSP_STAGE_LMS,
+    DSP_STAGE_RLS,
+    DSP_STAGE_DDC,           // ddc_filter: перенос, ФНЧ и децимация (отсчет - входной)
+    DSP_STAGE_MIX,           // перенос в базовую полосу демодулятора
+    DSP_STAGE_MATCHED,       // интегрирование / согласованный фильтр
+    DSP_STAGE_SLICE,         // жесткие решения и LLR демаппера (отсчет - символ)
+    DSP_STAGE_COUNT
+} dsp_stage;
+
+typedef struct {
+    long long calls;
+    long long samples;
+    uint64_t cycles;           // такты TSC
+    long long hw_calls;        // замеров с аппаратными счетчиками
+    uint64_t cache_misses;     // по hw_calls замерам
+    uint64_t branch_misses;
+} dsp_stage_stats;
+
+// Начало замера: значения счетчиков в момент входа в этап
+typedef struct {
+    uint64_t cycles;
+    uint64_t cache_misses;
+    uint64_t branch_misses;
+    int hw;                    // аппаратные значения прочитаны
+} dsp_stats_probe;
+
+#ifdef DSP_STATS
+#define DSP_STATS_BEGIN(probe) dsp_stats_probe probe; dsp_stats_begin(&probe)
+#define DSP_STATS_END(probe, stage, samples) dsp_stats_end(&probe, stage, samples)
+#else
+#define DSP_STATS_BEGIN(probe) ((void)0)
+#define DSP_STATS_END(probe, stage, samples) ((void)(samples))
+#endif
+
+// 1, если замеры встроены в сборку (-DDSP_STATS)
+int dsp_stats_compiled(void);
+
+// Обнуление счетчиков и калибровка частоты TSC; hardware != 0 включает
+// аппаратные счетчики. 0 - успех, -1 - аппаратные счетчики недоступны
+// (замеры тактов работают)
+int dsp_stats_init(int hardware);
+
+// Выключение аппаратных счетчиков и закрытие счетчиков текущего потока
+// (счетчики других потоков закрываются при их завершении)
+void dsp_stats_shutdown(void);
+
+void dsp_stats_reset(void);
+
+void dsp_stats_begin(dsp_stats_probe* probe);
+void dsp_stats_end(const dsp_stats_probe* probe, dsp_stage stage, long long samples);
+
+void dsp_stats_get(dsp_stage stage, dsp_stage_stats* stats);
+const char* dsp_stats_stage_name(dsp_stage stage);
+
+// Частота TSC, Гц (0 до dsp_stats_init)
+double dsp_stats_tsc_hz(void);
+
+// Таблица по этапам: вызовы, отсчеты, такты и нс на отсчет, промахи кэша и
+// ветвлений на 1000 отсчетов; этапы без вызовов пропускаются
+void dsp_stats_print(FILE* f);
+
+// То же в JSON: 0 - успех, -1 - файл не открыт, -2 - ошибка записи
+int dsp_stats_write_json(const char* path);
+
+#endif // DSP_STATS_H
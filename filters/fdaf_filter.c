@@ -0,0 +1,145 @@
+#include <stdlib.h>
+#include <string.h>
+#include "fdaf_filter.h"
+#include "dsp_stats.h"
+
+int fdaf_filter_init(fdaf_filter *filter, int length, float mu) {
+    if (!filter || length <= 0 || mu <= 0.0f) {
+        return -1;
+    }
+
+    memset(filter, 0, sizeof(*filter));
+    int size = 4;
+    while (size < 2 * length) size *= 2;
+
+    filter->length = length;
+    filter->fft_size = size;
+    filter->block_size = size - length;
+    filter->mu = mu;
+
+    if (fft_plan_init(&filter->plan, size / 2) != 0) {
+        return -2;
+    }
+    filter->W = (float*)calloc(size + 2, sizeof(float));
+    filter->X = (float*)calloc(size + 2, sizeof(float));
+    filter->time = (float*)calloc(size, sizeof(float));
+    filter->work = (float*)calloc(size + 2, sizeof(float));
+    filter->result = (float*)calloc(size, sizeof(float));
+    filter->errors = (float*)calloc(filter->block_size, sizeof(float));
+    if (!filter->W || !filter->X || !filter->time || !filter->work ||
+        !filter->result || !filter->errors) {
+        fdaf_filter_free(filter);
+        return -2;
+    }
+    return 0;
+}
+
+void fdaf_filter_free(fdaf_filter *filter) {
+    if (filter) {
+        fft_plan_free(&filter->plan);
+        free(filter->W);
+        free(filter->X);
+        free(filter->time);
+        free(filter->work);
+        free(filter->result);
+        free(filter->errors);
+        filter->W = NULL;
+        filter->X = NULL;
+        filter->time = NULL;
+        filter->work = NULL;
+        filter->result = NULL;
+        filter->errors = NULL;
+    }
+}
+
+// Выход блока: последние block_size отсчетов IFFT(X * W)
+static void fdaf_filter_output(fdaf_filter *filter) {
+    int bins = filter->fft_size / 2 + 1;
+    const float *X = filter->X;
+    const float *W = filter->W;
+    float *work = filter->work;
+
+    fft_real_forward(&filter->plan, filter->time, filter->X);
+    for (int k = 0; k < bins; k++) {
+        work[2 * k] = X[2 * k] * W[2 * k] - X[2 * k + 1] * W[2 * k + 1];
+        work[2 * k + 1] = X[2 * k] * W[2 * k + 1] + X[2 * k + 1] * W[2 * k];
+    }
+    fft_real_inverse(&filter->plan, work, filter->result);
+}
+
+// Обновление весов по ошибкам завершенного блока
+static void fdaf_filter_adapt(fdaf_filter *filter) {
+    int size = filter->fft_size;
+    int bins = size / 2 + 1;
+    int length = filter->length;
+    const float *X = filter->X;
+    float *work = filter->work;
+    float *result = filter->result;
+
+    // E = FFT([0 ... 0, e])
+    memset(result, 0, length * sizeof(float));
+    memcpy(result + length, filter->errors, filter->block_size * sizeof(float));
+    fft_real_forward(&filter->plan, result, work);
+
+    // conj(X) * E
+    for (int k = 0; k < bins; k++) {
+        float er = work[2 * k], ei = work[2 * k + 1];
+        work[2 * k] = X[2 * k] * er + X[2 * k + 1] * ei;
+        work[2 * k + 1] = X[2 * k] * ei - X[2 * k + 1] * er;
+    }
+    fft_real_inverse(&filter->plan, work, result);
+
+    // Ограничение градиента: остаются только первые length отсчетов
+    for (int i = length; i < size; i++) {
+        result[i] = 0.0f;
+    }
+    for (int i = 0; i < length; i++) {
+        result[i] *= filter->mu;
+    }
+    fft_real_forward(&filter->plan, result, work);
+    for (int k = 0; k < 2 * bins; k++) {
+        filter->W[k] += work[k];
+    }
+}
+
+static void fdaf_filter_run(fdaf_filter *filter, const float *in, const float *desired,
+                            float *out, int n) {
+    int length = filter->length;
+    int block = filter->block_size;
+
+    while (n > 0) {
+        int start = filter->fill;
+        int take = block - start;
+        if (take > n) take = n;
+
+        memcpy(filter->time + length + start, in, take * sizeof(float));
+        filter->fill += take;
+
+        // Как и в fft_fir_filter, незаполненный блок тоже прогоняется через
+        // БПФ, чтобы выдать выход без задержки; веса внутри блока не меняются
+        fdaf_filter_output(filter);
+        for (int i = 0; i < take; i++) {
+            float y = filter->result[length + start + i];
+            out[i] = y;
+            filter->errors[start + i] = desired[i] - y;
+        }
+
+        if (filter->fill == block) {
+            fdaf_filter_adapt(filter);
+            memmove(filter->time, filter->time + block, length * sizeof(float));
+            filter->fill = 0;
+        }
+
+        in += take;
+        desired += take;
+        out += take;
+        n -= take;
+    }
+}
+
+void fdaf_filter_process_block(fdaf_filter *filter, const float *in, const float *desired,
+                               float *out, int n) {
+    DSP_STATS_BEGIN(probe);
+    fdaf_filter_run(filter, in, desired, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_LMS, n);
+}
@@ -0,0 +1,36 @@
+#ifndef FDAF_FILTER_H
+#define FDAF_FILTER_H
+
+#include "fft.h"
+
+// Адаптивный фильтр в частотной области (overlap-save FDAF с ограничением
+// градиента). Блок из block_size новых отсчетов фильтруется через БПФ
+// размера fft_size = length + block_size, градиент считается как
+// взаимная корреляция в частотной области и после отбрасывания
+// некаузальной части добавляется к спектру весов:
+//   W += mu * FFT([IFFT(conj(X) * E)[0 .. length-1], 0 ...])
+// При том же mu это блочный LMS (lms_filter_init_block) с блоком block_size,
+// но стоимость на отсчет - O(log length) вместо O(length).
+typedef struct {
+    fft_plan plan;     // комплексное БПФ размера fft_size / 2
+    float *W;          // спектр весов, fft_size / 2 + 1 комплексных отсчетов
+    float *X;          // спектр текущего блока входа
+    float *time;       // входные отсчеты: length предыдущих + block_size новых
+    float *work;       // рабочий буфер спектра
+    float *result;     // рабочий буфер во временной области
+    float *errors;     // ошибки текущего блока
+    int length;        // длина фильтра
+    int block_size;    // новых отсчетов на блок
+    int fft_size;      // размер БПФ (степень двойки)
+    float mu;          // шаг адаптации
+    int fill;          // заполнено отсчетов в текущем блоке
+} fdaf_filter;
+
+// Размер БПФ - ближайшая степень двойки не меньше 2 * length,
+// block_size = fft_size - length
+int fdaf_filter_init(fdaf_filter *filter, int length, float mu);
+void fdaf_filter_free(fdaf_filter *filter);
+void fdaf_filter_process_block(fdaf_filter *filter, const float *in, const float *desired,
+                               float *out, int n);
+
+#endif // FDAF_FILTER_H
@@ -0,0 +1,171 @@
+#define _USE_MATH_DEFINES
+#include <stdlib.h>
+#include <math.h>
+#include "fft.h"
+
+int fft_plan_init(fft_plan *plan, int n) {
+    return fft_plan_init_ws(plan, n, NULL);
+}
+
+size_t fft_plan_workspace_size(int n) {
+    return workspace_align(n * sizeof(int)) + workspace_align(n * sizeof(float)) +
+           workspace_align(2 * n * sizeof(float));
+}
+
+int fft_plan_init_ws(fft_plan *plan, int n, workspace *ws) {
+    if (!plan || n < 2 || (n & (n - 1)) != 0) {
+        return -1;
+    }
+
+    plan->n = n;
+    plan->external = ws != NULL;
+    plan->bitrev = (int*)workspace_calloc(ws, n, sizeof(int));
+    plan->twiddles = (float*)workspace_calloc(ws, n, sizeof(float));
+    plan->rtwiddles = (float*)workspace_calloc(ws, 2 * n, sizeof(float));
+    if (!plan->bitrev || !plan->twiddles || !plan->rtwiddles) {
+        fft_plan_free(plan);
+        return -2;
+    }
+
+    int bits = 0;
+    while ((1 << bits) < n) bits++;
+    for (int i = 0; i < n; i++) {
+        int r = 0;
+        for (int b = 0; b < bits; b++) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        plan->bitrev[i] = r;
+    }
+
+    // Поворачивающие множители считаются в double, чтобы не накапливать ошибку
+    for (int k = 0; k < n / 2; k++) {
+        double angle = -2.0 * M_PI * k / n;
+        plan->twiddles[2 * k] = (float)cos(angle);
+        plan->twiddles[2 * k + 1] = (float)sin(angle);
+    }
+    for (int k = 0; k < n; k++) {
+        double angle = -M_PI * k / n;
+        plan->rtwiddles[2 * k] = (float)cos(angle);
+        plan->rtwiddles[2 * k + 1] = (float)sin(angle);
+    }
+    return 0;
+}
+
+void fft_plan_free(fft_plan *plan) {
+    if (plan) {
+        if (!plan->external) {
+            free(plan->bitrev);
+            free(plan->twiddles);
+            free(plan->rtwiddles);
+        }
+        plan->bitrev = NULL;
+        plan->twiddles = NULL;
+        plan->rtwiddles = NULL;
+    }
+}
+
+void fft_complex(const fft_plan *plan, float *data, int inverse) {
+    int n = plan->n;
+
+    for (int i = 0; i < n; i++) {
+        int j = plan->bitrev[i];
+        if (j > i) {
+            float re = data[2 * i], im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+
+    float sign = inverse ? -1.0f : 1.0f;
+    for (int half = 1; half < n; half *= 2) {
+        int stride = n / (2 * half);
+        for (int start = 0; start < n; start += 2 * half) {
+            for (int k = 0; k < half; k++) {
+                float wr = plan->twiddles[2 * k * stride];
+                float wi = sign * plan->twiddles[2 * k * stride + 1];
+                float *a = &data[2 * (start + k)];
+                float *b = &data[2 * (start + k + half)];
+                float tr = b[0] * wr - b[1] * wi;
+                float ti = b[0] * wi + b[1] * wr;
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+void fft_real_forward(const fft_plan *plan, const float *in, float *out) {
+    int n = plan->n;
+
+    // Четные отсчеты - в действительную часть, нечетные - в мнимую
+    for (int i = 0; i < 2 * n; i++) {
+        out[i] = in[i];
+    }
+    fft_complex(plan, out, 0);
+
+    // Разделение спектров: X[k] = E[k] + W^k * O[k]
+    float z0r = out[0], z0i = out[1];
+    out[0] = z0r + z0i;
+    out[1] = 0.0f;
+    out[2 * n] = z0r - z0i;
+    out[2 * n + 1] = 0.0f;
+
+    for (int k = 1; k <= n / 2; k++) {
+        int m = n - k;
+        float zkr = out[2 * k], zki = out[2 * k + 1];
+        float zmr = out[2 * m], zmi = out[2 * m + 1];
+
+        float er = 0.5f * (zkr + zmr), ei = 0.5f * (zki - zmi);
+        float or_ = 0.5f * (zki + zmi), oi = -0.5f * (zkr - zmr);
+
+        float wr = plan->rtwiddles[2 * k], wi = plan->rtwiddles[2 * k + 1];
+        float tr = wr * or_ - wi * oi;
+        float ti = wr * oi + wi * or_;
+        out[2 * k] = er + tr;
+        out[2 * k + 1] = ei + ti;
+
+        // X[n-k] = conj(E[k]) - conj(W^k * O[k])
+        out[2 * m] = er - tr;
+        out[2 * m + 1] = -(ei - ti);
+    }
+}
+
+void fft_real_inverse(const fft_plan *plan, float *in, float *out) {
+    int n = plan->n;
+
+    // Восстановление спектров четных и нечетных отсчетов: Z[k] = E[k] + i * O[k]
+    float x0r = in[0], xnr = in[2 * n];
+    out[0] = 0.5f * (x0r + xnr);
+    out[1] = 0.5f * (x0r - xnr);
+
+    for (int k = 1; k <= n / 2; k++) {
+        int m = n - k;
+        float xkr = in[2 * k], xki = in[2 * k + 1];
+        float xmr = in[2 * m], xmi = in[2 * m + 1];
+
+        float er = 0.5f * (xkr + xmr), ei = 0.5f * (xki - xmi);
+        float dr = 0.5f * (xkr - xmr), di = 0.5f * (xki + xmi);
+
+        // O[k] = D[k] * conj(W^k)
+        float wr = plan->rtwiddles[2 * k], wi = plan->rtwiddles[2 * k + 1];
+        float or_ = dr * wr + di * wi;
+        float oi = di * wr - dr * wi;
+
+        out[2 * k] = er - oi;
+        out[2 * k + 1] = ei + or_;
+        // Z[n-k] = conj(E[k]) + i * conj(O[k])
+        out[2 * m] = er + oi;
+        out[2 * m + 1] = -ei + or_;
+    }
+
+    fft_complex(plan, out, 1);
+
+    float scale = 1.0f / n;
+    for (int i = 0; i < 2 * n; i++) {
+        out[i] *= scale;
+    }
+}
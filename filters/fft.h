@@ -0,0 +1,34 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include "workspace.h"
+
+// План БПФ по основанию 2. Комплексное преобразование выполняется на месте
+// над массивом из n комплексных отсчетов (чередование re, im). Тот же план
+// используется для действительного БПФ размера 2n через упаковку четных и
+// нечетных отсчетов в один комплексный сигнал.
+typedef struct {
+    int n;             // размер комплексного БПФ (степень двойки)
+    int *bitrev;       // таблица бит-реверсной перестановки, n элементов
+    float *twiddles;   // exp(-2*pi*i*k/n), k = 0..n/2-1
+    float *rtwiddles;  // exp(-2*pi*i*k/(2n)), k = 0..n-1, для действительного БПФ
+    int external;      // таблицы в рабочей области (fft_plan_free их не освобождает)
+} fft_plan;
+
+int fft_plan_init(fft_plan *plan, int n);
+// Таблицы из рабочей области ws (NULL - из кучи)
+int fft_plan_init_ws(fft_plan *plan, int n, workspace *ws);
+size_t fft_plan_workspace_size(int n);
+void fft_plan_free(fft_plan *plan);
+
+// Комплексное БПФ на месте; inverse != 0 - обратное преобразование без нормировки
+void fft_complex(const fft_plan *plan, float *data, int inverse);
+
+// Прямое БПФ действительного сигнала из 2n отсчетов.
+// Результат - n + 1 комплексных отсчетов спектра (0 ... n).
+void fft_real_forward(const fft_plan *plan, const float *in, float *out);
+
+// Обратное преобразование к fft_real_forward с нормировкой (in портится)
+void fft_real_inverse(const fft_plan *plan, float *in, float *out);
+
+#endif // FFT_H
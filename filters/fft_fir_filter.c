@@ -0,0 +1,191 @@
+#include <stdlib.h>
+#include <string.h>
+#include "fft_fir_filter.h"
+#include "dsp_stats.h"
+
+int fft_fir_filter_init(fft_fir_filter *filter, const float *coefficients,
+                        int length, int block_size) {
+    return fft_fir_filter_init_mode(filter, coefficients, length, block_size,
+                                    FFT_FIR_AUTO);
+}
+
+int fft_fir_filter_init_mode(fft_fir_filter *filter, const float *coefficients,
+                             int length, int block_size, fft_fir_mode mode) {
+    return fft_fir_filter_init_ws(filter, coefficients, length, block_size, mode, NULL);
+}
+
+static fft_fir_mode fft_fir_select(int length, fft_fir_mode mode) {
+    if (mode == FFT_FIR_AUTO) {
+        return (length >= FFT_FIR_CROSSOVER_TAPS) ? FFT_FIR_FFT : FFT_FIR_DIRECT;
+    }
+    return mode;
+}
+
+static int fft_fir_size(int length, int block_size) {
+    int wanted = (block_size > 0) ? block_size + length - 1 : 4 * length;
+    int size = 4;
+    while (size < wanted) size *= 2;
+    return size;
+}
+
+size_t fft_fir_filter_workspace_size(int length, int block_size, fft_fir_mode mode) {
+    if (fft_fir_select(length, mode) == FFT_FIR_DIRECT) {
+        return fir_filter_workspace_size(length);
+    }
+    int size = fft_fir_size(length, block_size);
+    return fft_plan_workspace_size(size / 2) + 2 * workspace_align((size + 2) * sizeof(float)) +
+           2 * workspace_align(size * sizeof(float));
+}
+
+int fft_fir_filter_init_ws(fft_fir_filter *filter, const float *coefficients,
+                           int length, int block_size, fft_fir_mode mode, workspace *ws) {
+    if (!filter || !coefficients || length <= 0 || block_size < 0) {
+        return -1;
+    }
+
+    memset(filter, 0, sizeof(*filter));
+    filter->length = length;
+    filter->external = ws != NULL;
+    if (fft_fir_select(length, mode) == FFT_FIR_DIRECT) {
+        return fir_filter_init_ws(&filter->direct, coefficients, length, FIR_KERNEL_AUTO, ws);
+    }
+
+    int size = fft_fir_size(length, block_size);
+    filter->use_fft = 1;
+    filter->fft_size = size;
+    filter->step = size - length + 1;
+
+    if (fft_plan_init_ws(&filter->plan, size / 2, ws) != 0) {
+        return -2;
+    }
+    filter->spectrum = (float*)workspace_calloc(ws, size + 2, sizeof(float));
+    filter->time = (float*)workspace_calloc(ws, size, sizeof(float));
+    filter->freq = (float*)workspace_calloc(ws, size + 2, sizeof(float));
+    filter->result = (float*)workspace_calloc(ws, size, sizeof(float));
+    if (!filter->spectrum || !filter->time || !filter->freq || !filter->result) {
+        fft_fir_filter_free(filter);
+        return -2;
+    }
+
+    // Спектр коэффициентов, дополненных нулями до размера БПФ
+    memcpy(filter->time, coefficients, length * sizeof(float));
+    fft_real_forward(&filter->plan, filter->time, filter->spectrum);
+    memset(filter->time, 0, size * sizeof(float));
+
+    return 0;
+}
+
+void fft_fir_filter_free(fft_fir_filter *filter) {
+    if (!filter) {
+        return;
+    }
+    if (filter->use_fft) {
+        fft_plan_free(&filter->plan);
+        if (!filter->external) {
+            free(filter->spectrum);
+            free(filter->time);
+            free(filter->freq);
+            free(filter->result);
+        }
+        filter->spectrum = NULL;
+        filter->time = NULL;
+        filter->freq = NULL;
+        filter->result = NULL;
+    } else {
+        fir_filter_free(&filter->direct);
+    }
+}
+
+int fft_fir_filter_set_buffered(fft_fir_filter *filter, int buffered) {
+    if (!filter) {
+        return -1;
+    }
+    filter->buffered = buffered != 0;
+    if (filter->use_fft) {
+        memset(filter->time, 0, filter->fft_size * sizeof(float));
+        memset(filter->result, 0, filter->fft_size * sizeof(float));
+        filter->fill = 0;
+        filter->emitted = 0;
+    }
+    return 0;
+}
+
+int fft_fir_filter_latency(const fft_fir_filter *filter) {
+    return (filter->use_fft && filter->buffered) ? filter->step : 0;
+}
+
+// Круговая свертка текущего блока с коэффициентами
+static void fft_fir_run_block(fft_fir_filter *filter) {
+    int bins = filter->fft_size / 2 + 1;
+    float *freq = filter->freq;
+    const float *h = filter->spectrum;
+
+    fft_real_forward(&filter->plan, filter->time, freq);
+    for (int k = 0; k < bins; k++) {
+        float re = freq[2 * k] * h[2 * k] - freq[2 * k + 1] * h[2 * k + 1];
+        float im = freq[2 * k] * h[2 * k + 1] + freq[2 * k + 1] * h[2 * k];
+        freq[2 * k] = re;
+        freq[2 * k + 1] = im;
+    }
+    fft_real_inverse(&filter->plan, freq, filter->result);
+}
+
+void fft_fir_filter_process_block(fft_fir_filter *filter, const float *in,
+                                  float *out, int n) {
+    // Прямая свертка учитывается в fir_filter_process_block
+    if (!filter->use_fft) {
+        fir_filter_process_block(&filter->direct, in, out, n);
+        return;
+    }
+
+    DSP_STATS_BEGIN(probe);
+    int total = n;
+    int history = filter->length - 1;
+
+    // Буферизация: на место каждого входного отсчета выдается выход
+    // предыдущего блока, БПФ - когда блок заполнен
+    while (filter->buffered && n > 0) {
+        int take = filter->step - filter->fill;
+        if (take > n) take = n;
+
+        // Вход читается до записи выхода: in и out могут совпадать
+        memcpy(filter->time + history + filter->fill, in, take * sizeof(float));
+        memcpy(out, filter->result + history + filter->fill, take * sizeof(float));
+        filter->fill += take;
+        in += take;
+        out += take;
+        n -= take;
+
+        if (filter->fill == filter->step) {
+            fft_fir_run_block(filter);
+            memmove(filter->time, filter->time + filter->step, history * sizeof(float));
+            filter->fill = 0;
+        }
+    }
+
+    while (n > 0) {
+        int take = filter->step - filter->fill;
+        if (take > n) take = n;
+
+        memcpy(filter->time + history + filter->fill, in, take * sizeof(float));
+        filter->fill += take;
+        in += take;
+        n -= take;
+
+        // Незаполненный блок тоже обрабатывается: отсчеты за пределами
+        // fill на достоверную часть круговой свертки не влияют
+        fft_fir_run_block(filter);
+
+        int ready = filter->fill - filter->emitted;
+        memcpy(out, filter->result + history + filter->emitted, ready * sizeof(float));
+        out += ready;
+        filter->emitted = filter->fill;
+
+        if (filter->fill == filter->step) {
+            memmove(filter->time, filter->time + filter->step, history * sizeof(float));
+            filter->fill = 0;
+            filter->emitted = 0;
+        }
+    }
+    DSP_STATS_END(probe, DSP_STAGE_FIR, total);
+}
@@ -0,0 +1,71 @@
+#ifndef FFT_FIR_FILTER_H
+#define FFT_FIR_FILTER_H
+
+#include "fir_filter.h"
+#include "fft.h"
+
+// Число отводов, начиная с которого быстрая свертка через БПФ выгоднее прямой.
+// По замерам report_fft_crossover (общее ядро прямой свертки против
+// overlap-save, медиана после прогрева, блоки по 4096) на AVX-512 прямая
+// свертка быстрее до 768 отводов, при 1024 они равны, с 1536 быстрее БПФ.
+// Отчет печатает точку перехода для текущей машины; ее можно задать при
+// сборке (-DFFT_FIR_CROSSOVER_TAPS=...).
+#ifndef FFT_FIR_CROSSOVER_TAPS
+#define FFT_FIR_CROSSOVER_TAPS 1024
+#endif
+
+typedef enum {
+    FFT_FIR_AUTO = 0,   // выбор по числу отводов
+    FFT_FIR_DIRECT,     // прямая свертка (fir_filter)
+    FFT_FIR_FFT         // overlap-save через БПФ
+} fft_fir_mode;
+
+// КИХ фильтр с быстрой сверткой методом overlap-save. Входные отсчеты
+// накапливаются в блоке из fft_size точек: первые length - 1 точек - хвост
+// предыдущего блока, далее step новых отсчетов. По умолчанию выход
+// выдается без задержки: незаполненный блок тоже прогоняется через БПФ, а
+// при его дозаполнении выдаются только еще не выданные отсчеты, поэтому
+// вызовы короче step платят полное БПФ каждый. В режиме буферизации
+// (fft_fir_filter_set_buffered) БПФ считается только по полному блоку, а
+// выход запаздывает на step отсчетов.
+typedef struct {
+    fir_filter direct;  // используется в режиме прямой свертки
+    fft_plan plan;      // комплексное БПФ размера fft_size / 2
+    float *spectrum;    // спектр коэффициентов, fft_size / 2 + 1 комплексных отсчетов
+    float *time;        // текущий блок входных отсчетов, fft_size
+    float *freq;        // рабочий буфер спектра, fft_size + 2
+    float *result;      // результат обратного БПФ, fft_size
+    int use_fft;        // 1 - overlap-save, 0 - прямая свертка
+    int length;         // число отводов
+    int fft_size;       // размер БПФ (степень двойки)
+    int step;           // новых отсчетов на блок: fft_size - length + 1
+    int fill;           // заполнено новых отсчетов в текущем блоке
+    int emitted;        // уже выданных выходных отсчетов текущего блока
+    int buffered;       // выход с задержкой на блок, БПФ только по полному блоку
+    int external;       // буферы в рабочей области (fft_fir_filter_free их не освобождает)
+} fft_fir_filter;
+
+// block_size - желаемое число новых отсчетов на один блок БПФ;
+// 0 - размер БПФ выбирается автоматически (около 4 * length)
+int fft_fir_filter_init(fft_fir_filter *filter, const float *coefficients,
+                        int length, int block_size);
+int fft_fir_filter_init_mode(fft_fir_filter *filter, const float *coefficients,
+                             int length, int block_size, fft_fir_mode mode);
+// План БПФ и буферы из рабочей области ws (NULL - из кучи)
+int fft_fir_filter_init_ws(fft_fir_filter *filter, const float *coefficients,
+                           int length, int block_size, fft_fir_mode mode, workspace *ws);
+size_t fft_fir_filter_workspace_size(int length, int block_size, fft_fir_mode mode);
+void fft_fir_filter_free(fft_fir_filter *filter);
+
+// Включение (buffered != 0) или выключение буферизации по блокам; состояние
+// сбрасывается. В режиме прямой свертки ни на что не влияет. 0 - успех
+int fft_fir_filter_set_buffered(fft_fir_filter *filter, int buffered);
+
+// Дополнительная задержка выхода в отсчетах: step в режиме буферизации,
+// иначе 0 (к задержке самого фильтра, length / 2, прибавляется)
+int fft_fir_filter_latency(const fft_fir_filter *filter);
+// in и out могут совпадать
+void fft_fir_filter_process_block(fft_fir_filter *filter, const float *in,
+                                  float *out, int n);
+
+#endif // FFT_FIR_FILTER_H
@@ -0,0 +1,174 @@
+#include <stdlib.h>
+#include <string.h>
+#include "filter_bank.h"
+#include "dsp_dispatch.h"
+#include "dsp_stats.h"
+
+static int filter_bank_alloc(filter_bank* bank, filter_bank_type type, int channels, int length) {
+    memset(bank, 0, sizeof(*bank));
+    bank->type = type;
+    bank->channels = channels;
+    bank->length = length;
+
+    // Для LMS вторая половина рабочего блока занята опорными кадрами
+    int blocks = (type == FILTER_BANK_LMS) ? 2 : 1;
+    bank->frames = (float*)malloc((size_t)blocks * FILTER_BANK_CHUNK * channels * sizeof(float));
+    if (!bank->frames) {
+        return -2;
+    }
+    if (type == FILTER_BANK_IIR) {
+        return 0;
+    }
+    bank->history = (float*)calloc((size_t)(length - 1 + FILTER_BANK_CHUNK) * channels,
+                                   sizeof(float));
+    if (!bank->history) {
+        filter_bank_free(bank);
+        return -2;
+    }
+    return 0;
+}
+
+int filter_bank_init_fir(filter_bank* bank, int channels, const float* coeffs, int length) {
+    if (!bank || !coeffs || channels <= 0 || length <= 0) {
+        return -1;
+    }
+    if (filter_bank_alloc(bank, FILTER_BANK_FIR, channels, length) != 0) {
+        return -2;
+    }
+    bank->coeffs = (float*)malloc(length * sizeof(float));
+    if (!bank->coeffs) {
+        filter_bank_free(bank);
+        return -2;
+    }
+    // Обратный порядок, как в fir_filter: проход от старых кадров к новым
+    for (int i = 0; i < length; i++) {
+        bank->coeffs[i] = coeffs[length - 1 - i];
+    }
+    return 0;
+}
+
+int filter_bank_init_iir_sos(filter_bank* bank, int channels, const float* sos, int num_sections) {
+    if (!bank || !sos || channels <= 0 || num_sections <= 0) {
+        return -1;
+    }
+    if (filter_bank_alloc(bank, FILTER_BANK_IIR, channels, 0) != 0) {
+        return -2;
+    }
+    if (iir_filter_init_sos(&bank->iir, sos, num_sections) != 0 ||
+        iir_filter_set_channels(&bank->iir, channels) != 0) {
+        filter_bank_free(bank);
+        return -2;
+    }
+    return 0;
+}
+
+int filter_bank_init_lms(filter_bank* bank, int channels, int length, float mu) {
+    if (!bank || channels <= 0 || length <= 0 || mu <= 0.0f) {
+        return -1;
+    }
+    if (filter_bank_alloc(bank, FILTER_BANK_LMS, channels, length) != 0) {
+        return -2;
+    }
+    bank->mu = mu;
+    bank->weights = (float*)calloc((size_t)length * channels, sizeof(float));
+    bank->errors = (float*)malloc(channels * sizeof(float));
+    if (!bank->weights || !bank->errors) {
+        filter_bank_free(bank);
+        return -2;
+    }
+    return 0;
+}
+
+void filter_bank_free(filter_bank* bank) {
+    if (!bank) {
+        return;
+    }
+    if (bank->type == FILTER_BANK_IIR) {
+        iir_filter_free(&bank->iir);
+    }
+    free(bank->coeffs);
+    free(bank->weights);
+    free(bank->history);
+    free(bank->frames);
+    free(bank->errors);
+    bank->coeffs = NULL;
+    bank->weights = NULL;
+    bank->history = NULL;
+    bank->frames = NULL;
+    bank->errors = NULL;
+}
+
+// Транспонирование m отсчетов каналов (начиная с offset) в кадры dst[t * K + c]
+static void filter_bank_gather(const float* const* src, int channels, int offset, int m, float* dst) {
+    for (int c = 0; c < channels; c++) {
+        const float* s = src[c] + offset;
+        for (int t = 0; t < m; t++) {
+            dst[(size_t)t * channels + c] = s[t];
+        }
+    }
+}
+
+static void filter_bank_scatter(const float* src, int channels, int offset, int m, float* const* dst) {
+    for (int c = 0; c < channels; c++) {
+        float* d = dst[c] + offset;
+        for (int t = 0; t < m; t++) {
+            d[t] = src[(size_t)t * channels + c];
+        }
+    }
+}
+
+// Кадры блока дописываются после length - 1 кадров предыдущей истории;
+// после обработки хвост переносится в начало
+static void filter_bank_shift_history(filter_bank* bank, int m) {
+    size_t keep = (size_t)(bank->length - 1) * bank->channels;
+    memmove(bank->history, bank->history + (size_t)m * bank->channels, keep * sizeof(float));
+}
+
+int filter_bank_process(filter_bank* bank, const float* const* in, float* const* out, int n) {
+    return filter_bank_process_adaptive(bank, in, NULL, out, n);
+}
+
+static int filter_bank_run(filter_bank* bank, const float* const* in,
+                           const float* const* desired, float* const* out, int n) {
+    if (bank->type == FILTER_BANK_LMS && !desired) {
+        return -1;
+    }
+    const dsp_kernels* kernels = dsp_dispatch();
+    int K = bank->channels;
+
+    for (int offset = 0; offset < n; offset += FILTER_BANK_CHUNK) {
+        int m = (n - offset < FILTER_BANK_CHUNK) ? n - offset : FILTER_BANK_CHUNK;
+
+        if (bank->type == FILTER_BANK_IIR) {
+            filter_bank_gather(in, K, offset, m, bank->frames);
+            iir_filter_process_interleaved(&bank->iir, bank->frames, bank->frames, m);
+        } else {
+            float* tail = bank->history + (size_t)(bank->length - 1) * K;
+            filter_bank_gather(in, K, offset, m, tail);
+            if (bank->type == FILTER_BANK_FIR) {
+                kernels->bank_fir(bank->coeffs, bank->history, K, bank->length, bank->frames, m);
+            } else {
+                float* reference = bank->frames + (size_t)FILTER_BANK_CHUNK * K;
+                filter_bank_gather(desired, K, offset, m, reference);
+                kernels->bank_lms(bank->weights, bank->history, reference, bank->mu, K,
+                                  bank->length, bank->errors, bank->frames, m);
+            }
+            filter_bank_shift_history(bank, m);
+        }
+
+        filter_bank_scatter(bank->frames, K, offset, m, out);
+    }
+    return 0;
+}
+
+int filter_bank_process_adaptive(filter_bank* bank, const float* const* in,
+                                 const float* const* desired, float* const* out, int n) {
+    DSP_STATS_BEGIN(probe);
+    int status = filter_bank_run(bank, in, desired, out, n);
+    // IIR банка учитывается в iir_filter_process_interleaved
+    if (status == 0 && bank->type != FILTER_BANK_IIR) {
+        DSP_STATS_END(probe, bank->type == FILTER_BANK_FIR ? DSP_STAGE_FIR : DSP_STAGE_LMS,
+                      (long long)n * bank->channels);
+    }
+    return status;
+}
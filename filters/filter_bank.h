@@ -0,0 +1,49 @@
+#ifndef FILTER_BANK_H
+#define FILTER_BANK_H
+
+#include "iir_filter.h"
+
+// Блок кадров, на который разбивается обработка (транспонирование и история)
+#define FILTER_BANK_CHUNK 256
+
+typedef enum {
+    FILTER_BANK_FIR = 0,
+    FILTER_BANK_IIR,
+    FILTER_BANK_LMS
+} filter_bank_type;
+
+// Банк из channels независимых каналов с одинаковой конфигурацией фильтра.
+// Состояние хранится в раскладке SoA: для каждого отвода (или секции) подряд
+// лежат значения всех каналов, поэтому каждый шаг по отводам - одна векторная
+// операция над всеми каналами. Особенно это важно для IIR, рекурсия которого
+// внутри одного канала не векторизуется. Циклы по отводам FIR и LMS - ядра
+// bank_fir и bank_lms таблицы dsp_kernels, IIR - biquad_frames.
+typedef struct {
+    filter_bank_type type;
+    int channels;      // число каналов K
+    int length;        // число отводов (FIR, LMS)
+    float mu;          // шаг адаптации (LMS)
+    float* coeffs;     // коэффициенты в обратном порядке (FIR)
+    float* weights;    // веса weights[j * K + c] (LMS, порядок линии задержки)
+    float* history;    // (length - 1 + FILTER_BANK_CHUNK) кадров по K отсчетов
+    float* frames;     // рабочий блок FILTER_BANK_CHUNK кадров (LMS: два блока)
+    float* errors;     // ошибки текущего кадра (LMS)
+    iir_filter iir;    // каскад SOS в многоканальном режиме (IIR)
+} filter_bank;
+
+int filter_bank_init_fir(filter_bank* bank, int channels, const float* coeffs, int length);
+int filter_bank_init_iir_sos(filter_bank* bank, int channels, const float* sos, int num_sections);
+int filter_bank_init_lms(filter_bank* bank, int channels, int length, float mu);
+void filter_bank_free(filter_bank* bank);
+
+// Обработка n отсчетов каждого канала: in[c] и out[c] - массивы по n отсчетов.
+// Для LMS используется filter_bank_process_adaptive.
+// 0 - успех, -1 - банк LMS без опорного сигнала (out не изменяется)
+int filter_bank_process(filter_bank* bank, const float* const* in, float* const* out, int n);
+
+// То же для LMS с опорными сигналами desired[c]; для FIR и IIR desired
+// не используется и может быть NULL. 0 - успех, -1 - LMS и desired == NULL
+int filter_bank_process_adaptive(filter_bank* bank, const float* const* in,
+                                 const float* const* desired, float* const* out, int n);
+
+#endif // FILTER_BANK_H
@@ -0,0 +1,270 @@
+#define _USE_MATH_DEFINES
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include <pthread.h>
+#include "filter_design.h"
+
+typedef struct {
+    filter_design_spec spec;
+    float* coeffs;
+    int count;
+} design_cache_entry;
+
+static design_cache_entry design_cache[FILTER_DESIGN_CACHE_SIZE];
+static int design_cache_next;  // запись, вытесняемая следующей (по кругу)
+static long long design_cache_hits;
+static long long design_cache_misses;
+static pthread_mutex_t design_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Модифицированная функция Бесселя I0 (ряд), точность double
+static double design_bessel_i0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 200; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < 1e-17 * sum) break;
+    }
+    return sum;
+}
+
+// sin(pi x) / (pi x), как numpy.sinc
+static double design_sinc(double x) {
+    return (x == 0.0) ? 1.0 : sin(M_PI * x) / (M_PI * x);
+}
+
+static int design_band_valid(const filter_band* band) {
+    return band && band->fs > 0.0 && band->f_low > 0.0 && band->f_low < band->f_high &&
+           band->f_high < band->fs / 2.0;
+}
+
+int filter_design_band(const qpsk_params* params, filter_band* band) {
+    if (!params || !band || params->samples_per_sym <= 0 || !(params->fs > 0.0f)) {
+        return -1;
+    }
+    double rs = (double)params->fs / params->samples_per_sym;
+    double half = (params->pulse == QPSK_PULSE_RRC) ? 0.5 * (1.0 + params->rolloff) * rs
+                                                    : FILTER_DESIGN_RECT_HALF_BAND * rs;
+    band->fs = params->fs;
+    band->f_low = params->f_center - half;
+    band->f_high = params->f_center + half;
+    return design_band_valid(band) ? 0 : -1;
+}
+
+// Отвод n оконной идеальной полосовой характеристики до нормировки
+static double design_fir_tap(int n, int numtaps, double left, double right,
+                             double beta, double i0_beta) {
+    double m = n - 0.5 * (numtaps - 1);
+    double r = (numtaps > 1) ? 2.0 * n / (numtaps - 1) - 1.0 : 0.0;
+    double ideal = right * design_sinc(right * m) - left * design_sinc(left * m);
+    return ideal * design_bessel_i0(beta * sqrt(1.0 - r * r)) / i0_beta;
+}
+
+// Полоса (left, right) относительно Найквиста; отклик на частоте center
+// (тоже от Найквиста) нормируется к 1, как scale=True в firwin
+static void design_fir_window(float* h, int numtaps, double left, double right, double center,
+                              double beta) {
+    double i0_beta = design_bessel_i0(beta);
+    double scale = 0.0;
+    for (int n = 0; n < numtaps; n++) {
+        double m = n - 0.5 * (numtaps - 1);
+        scale += design_fir_tap(n, numtaps, left, right, beta, i0_beta) * cos(M_PI * m * center);
+    }
+    for (int n = 0; n < numtaps; n++) {
+        h[n] = (float)(design_fir_tap(n, numtaps, left, right, beta, i0_beta) / scale);
+    }
+}
+
+int filter_design_fir_bandpass(float* h, int numtaps, const filter_band* band, double beta) {
+    if (!h || numtaps <= 0 || !design_band_valid(band) || !(beta >= 0.0)) {
+        return -1;
+    }
+    // Частоты относительно Найквиста, как в firwin; единица в центре полосы
+    double nyq = band->fs / 2.0;
+    double left = band->f_low / nyq, right = band->f_high / nyq;
+    design_fir_window(h, numtaps, left, right, 0.5 * (left + right), beta);
+    return 0;
+}
+
+int filter_design_fir_lowpass(float* h, int numtaps, double cutoff, double fs, double beta) {
+    if (!h || numtaps <= 0 || !(fs > 0.0) || !(cutoff > 0.0) || !(cutoff < fs / 2.0) ||
+        !(beta >= 0.0)) {
+        return -1;
+    }
+    design_fir_window(h, numtaps, 0.0, cutoff / (fs / 2.0), 0.0, beta);
+    return 0;
+}
+
+int filter_design_butter_bandpass(float* sos, int order, const filter_band* band) {
+    if (!sos || order <= 0 || order > FILTER_DESIGN_MAX_ORDER || !design_band_valid(band)) {
+        return -1;
+    }
+    // Предыскажение границ полосы; расчет при fs = 2 (частоты от Найквиста),
+    // билинейное преобразование s = 4 (z - 1) / (z + 1)
+    const double fs2 = 4.0;
+    double w1 = fs2 * tan(M_PI * band->f_low / band->fs);
+    double w2 = fs2 * tan(M_PI * band->f_high / band->fs);
+    double bw = w2 - w1, wo = sqrt(w1 * w2);
+
+    // Полюсы аналогового прототипа -exp(j pi k / (2 order)), k = -order + 1, ..., order - 1
+    // с шагом 2; переход ФНЧ -> ПФ дает пару полюсов на каждый, нули - order
+    // в s = 0 и order в бесконечности, то есть по order в z = 1 и z = -1
+    double complex poles[2 * FILTER_DESIGN_MAX_ORDER];
+    double complex denominator = 1.0;
+    for (int i = 0; i < order; i++) {
+        int k = 2 * i - order + 1;
+        double complex p = -cexp(I * M_PI * k / (2.0 * order)) * (bw / 2.0);
+        double complex root = csqrt(p * p - wo * wo);
+        poles[2 * i] = p + root;
+        poles[2 * i + 1] = p - root;
+    }
+    for (int i = 0; i < 2 * order; i++) {
+        denominator *= fs2 - poles[i];
+        poles[i] = (fs2 + poles[i]) / (fs2 - poles[i]);
+    }
+    double gain = pow(bw * fs2, order) / creal(denominator);
+
+    // Секции: сопряженная пара (по полюсу из верхней полуплоскости) или два
+    // вещественных полюса подряд
+    double complex upper[FILTER_DESIGN_MAX_ORDER];
+    double real[2 * FILTER_DESIGN_MAX_ORDER];
+    int num_upper = 0, num_real = 0;
+    for (int i = 0; i < 2 * order; i++) {
+        double im = cimag(poles[i]);
+        if (fabs(im) <= 1e-12 * cabs(poles[i])) {
+            real[num_real++] = creal(poles[i]);
+        } else if (im > 0.0) {
+            if (num_upper == order) return -1;
+            upper[num_upper++] = poles[i];
+        }
+    }
+    if (num_upper + num_real / 2 != order || num_real % 2 != 0) {
+        return -1;
+    }
+
+    double a1[FILTER_DESIGN_MAX_ORDER], a2[FILTER_DESIGN_MAX_ORDER];
+    double radius[FILTER_DESIGN_MAX_ORDER];
+    int sections = 0;
+    for (int i = 0; i < num_upper; i++, sections++) {
+        a1[sections] = -2.0 * creal(upper[i]);
+        a2[sections] = creal(upper[i]) * creal(upper[i]) + cimag(upper[i]) * cimag(upper[i]);
+        radius[sections] = cabs(upper[i]);
+    }
+    for (int i = 0; i < num_real; i += 2, sections++) {
+        a1[sections] = -(real[i] + real[i + 1]);
+        a2[sections] = real[i] * real[i + 1];
+        radius[sections] = fmax(fabs(real[i]), fabs(real[i + 1]));
+    }
+
+    // Секции по удалению полюсов от единичной окружности (вставками,
+    // секций не больше FILTER_DESIGN_MAX_ORDER)
+    int index[FILTER_DESIGN_MAX_ORDER];
+    for (int i = 0; i < sections; i++) {
+        int j = i;
+        for (; j > 0 && radius[index[j - 1]] > radius[i]; j--) {
+            index[j] = index[j - 1];
+        }
+        index[j] = i;
+    }
+    for (int s = 0; s < sections; s++) {
+        float* row = &sos[6 * s];
+        double b0 = (s == 0) ? gain : 1.0;
+        row[0] = (float)b0;
+        row[1] = 0.0f;
+        row[2] = (float)-b0;
+        row[3] = 1.0f;
+        row[4] = (float)a1[index[s]];
+        row[5] = (float)a2[index[s]];
+    }
+    return 0;
+}
+
+int filter_design_count(const filter_design_spec* spec) {
+    if (!spec || spec->size <= 0) {
+        return -1;
+    }
+    switch (spec->kind) {
+    case FILTER_DESIGN_FIR: return spec->size;
+    case FILTER_DESIGN_BUTTER: return spec->size <= FILTER_DESIGN_MAX_ORDER ? 6 * spec->size : -1;
+    default: return -1;
+    }
+}
+
+static int design_compute(const filter_design_spec* spec, float* out) {
+    if (spec->kind == FILTER_DESIGN_FIR) {
+        return filter_design_fir_bandpass(out, spec->size, &spec->band, spec->beta);
+    }
+    return filter_design_butter_bandpass(out, spec->size, &spec->band);
+}
+
+// Сравнение по полям: в структуре могут быть байты выравнивания
+static int design_spec_equal(const filter_design_spec* a, const filter_design_spec* b) {
+    return a->kind == b->kind && a->size == b->size && a->band.f_low == b->band.f_low &&
+           a->band.f_high == b->band.f_high && a->band.fs == b->band.fs &&
+           (a->kind != FILTER_DESIGN_FIR || a->beta == b->beta);
+}
+
+int filter_design_get(const filter_design_spec* spec, float* out, int capacity) {
+    int count = filter_design_count(spec);
+    if (count < 0 || !out) {
+        return -1;
+    }
+    if (capacity < count) {
+        return -2;
+    }
+
+    pthread_mutex_lock(&design_cache_lock);
+    for (int i = 0; i < FILTER_DESIGN_CACHE_SIZE; i++) {
+        design_cache_entry* entry = &design_cache[i];
+        if (entry->coeffs && design_spec_equal(&entry->spec, spec)) {
+            memcpy(out, entry->coeffs, (size_t)count * sizeof(float));
+            design_cache_hits++;
+            pthread_mutex_unlock(&design_cache_lock);
+            return count;
+        }
+    }
+    design_cache_misses++;
+    pthread_mutex_unlock(&design_cache_lock);
+
+    // Расчет вне блокировки: параллельный промах по тем же параметрам
+    // посчитает фильтр еще раз, но не задержит остальные запросы
+    if (design_compute(spec, out) != 0) {
+        return -1;
+    }
+    float* copy = malloc((size_t)count * sizeof(float));
+    if (!copy) {
+        return count;
+    }
+    memcpy(copy, out, (size_t)count * sizeof(float));
+
+    pthread_mutex_lock(&design_cache_lock);
+    design_cache_entry* entry = &design_cache[design_cache_next];
+    design_cache_next = (design_cache_next + 1) % FILTER_DESIGN_CACHE_SIZE;
+    free(entry->coeffs);
+    entry->spec = *spec;
+    entry->coeffs = copy;
+    entry->count = count;
+    pthread_mutex_unlock(&design_cache_lock);
+    return count;
+}
+
+void filter_design_cache_clear(void) {
+    pthread_mutex_lock(&design_cache_lock);
+    for (int i = 0; i < FILTER_DESIGN_CACHE_SIZE; i++) {
+        free(design_cache[i].coeffs);
+        design_cache[i].coeffs = NULL;
+        design_cache[i].count = 0;
+    }
+    design_cache_next = 0;
+    design_cache_hits = 0;
+    design_cache_misses = 0;
+    pthread_mutex_unlock(&design_cache_lock);
+}
+
+void filter_design_cache_stats(long long* hits, long long* misses) {
+    pthread_mutex_lock(&design_cache_lock);
+    *hits = design_cache_hits;
+    *misses = design_cache_misses;
+    pthread_mutex_unlock(&design_cache_lock);
+}
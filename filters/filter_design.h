@@ -0,0 +1,74 @@
+#ifndef FILTER_DESIGN_H
+#define FILTER_DESIGN_H
+
+#include "../qpsk/qpsk_modem.h"
+
+// Синтез фильтров без Python: те же расчеты, что в filters_calculation.py
+// (firwin с окном Кайзера и butter(..., output='sos')), но во время работы,
+// поэтому смена полосы или частоты дискретизации не требует пересборки.
+// Расчет идет в double, коэффициенты выдаются во float в формате coeffs.h.
+// Результаты запоминаются по параметрам: повторный запрос с теми же
+// параметрами - копирование из кэша.
+#define FILTER_DESIGN_KAISER_BETA 8.0     // как window=('kaiser', 8)
+#define FILTER_DESIGN_RECT_HALF_BAND 0.6  // полуширина полосы для PULSE_RECT, в долях Rs
+#define FILTER_DESIGN_MAX_ORDER 16        // порядок прототипа Баттерворта
+#define FILTER_DESIGN_CACHE_SIZE 16       // записей в кэше
+
+// Полоса пропускания, Гц
+typedef struct {
+    double f_low;
+    double f_high;
+    double fs;
+} filter_band;
+
+typedef enum {
+    FILTER_DESIGN_FIR = 0,     // полосовой КИХ методом окон, size - число отводов
+    FILTER_DESIGN_BUTTER       // полосовой Баттерворт секциями, size - порядок прототипа
+} filter_design_kind;
+
+typedef struct {
+    filter_design_kind kind;
+    int size;
+    filter_band band;
+    double beta;               // окно Кайзера (только FILTER_DESIGN_FIR)
+} filter_design_spec;
+
+// Полоса сигнала по параметрам модема: f_center +- (1 + rolloff) / 2 * Rs
+// для PULSE_RRC и f_center +- FILTER_DESIGN_RECT_HALF_BAND * Rs для
+// PULSE_RECT (2110-2170 МГц при параметрах по умолчанию, как в
+// filters_calculation.py). 0 - успех, -1 - полоса выходит за (0, fs / 2)
+int filter_design_band(const qpsk_params* params, filter_band* band);
+
+// Полосовой КИХ из numtaps отводов (аналог firwin(numtaps, [f_low, f_high],
+// window=('kaiser', beta), pass_zero='bandpass')): единичное усиление в
+// центре полосы. 0 - успех, -1 - неверные параметры
+int filter_design_fir_bandpass(float* h, int numtaps, const filter_band* band, double beta);
+
+// ФНЧ из numtaps отводов с частотой среза cutoff, Гц (аналог firwin(numtaps,
+// cutoff, window=('kaiser', beta), fs=fs)): единичное усиление на нулевой
+// частоте. 0 - успех, -1 - неверные параметры (cutoff вне (0, fs / 2))
+int filter_design_fir_lowpass(float* h, int numtaps, double cutoff, double fs, double beta);
+
+// Полосовой фильтр Баттерворта порядка 2 * order (аналог butter(order, ...,
+// btype='bandpass', output='sos')) через билинейное преобразование с
+// предыскажением частот. order секций по строкам b0 b1 b2 a0 a1 a2, как
+// iir_sos в coeffs.h; каждая секция - пара сопряженных полюсов с нулями в
+// z = 1 и z = -1, усиление в первой, секции с полюсами ближе к единичной
+// окружности - последние. 0 - успех, -1 - неверные параметры
+int filter_design_butter_bandpass(float* sos, int order, const filter_band* band);
+
+// Число коэффициентов результата: numtaps или 6 * order; -1 - неверный вид
+int filter_design_count(const filter_design_spec* spec);
+
+// Синтез с кэшем: коэффициенты копируются в out. Число коэффициентов -
+// успех; -1 - неверные параметры, -2 - out меньше filter_design_count.
+// Потокобезопасна; при нехватке памяти результат просто не кэшируется
+int filter_design_get(const filter_design_spec* spec, float* out, int capacity);
+
+// Очистка кэша и обнуление счетчиков попаданий
+void filter_design_cache_clear(void);
+
+// Попадания и промахи кэша с последней очистки
+void filter_design_cache_stats(long long* hits, long long* misses);
+
+#endif // FILTER_DESIGN_H
@@ -1,43 +1,112 @@
 #include "fir_filter.h"
+#include "dsp_dispatch.h"
+#include "dsp_stats.h"
+
+// Длины ядер фиксированной длины в порядке таблиц dsp_kernels
+#define FIR_FIXED_LENGTH(N) N,
+static const int fir_fixed_lengths[FIR_FIXED_COUNT] = {FIR_FIXED_TAPS_LIST(FIR_FIXED_LENGTH)};
 
 int fir_filter_init(fir_filter *fir, const float *coefficients, int length) {
+    return fir_filter_init_mode(fir, coefficients, length, FIR_KERNEL_AUTO);
+}
+
+int fir_filter_init_mode(fir_filter *fir, const float *coefficients, int length,
+                         fir_kernel_mode mode) {
+    return fir_filter_init_ws(fir, coefficients, length, mode, NULL);
+}
+
+size_t fir_filter_workspace_size(int length) {
+    return workspace_align(length * sizeof(float)) + workspace_align(2 * length * sizeof(float));
+}
+
+int fir_filter_init_ws(fir_filter *fir, const float *coefficients, int length,
+                       fir_kernel_mode mode, workspace *ws) {
     if(length <= 0 || !coefficients) {
         return -1;
     }
     
     fir->length = length;
-    fir->coefficients = (float*)malloc(length * sizeof(float));
+    fir->external = ws != NULL;
+    fir->coefficients = (float*)workspace_calloc(ws, length, sizeof(float));
     if(!fir->coefficients) {
         return -2;
     }
     
-    fir->buffer = (float*)calloc(length, sizeof(float));
+    fir->buffer = (float*)workspace_calloc(ws, 2 * length, sizeof(float));
     if(!fir->buffer) {
-        free(fir->coefficients);
+        if (!ws) free(fir->coefficients);
         return -3;
     }
     
     fir->position = 0;
-    memcpy(fir->coefficients, coefficients, length * sizeof(float));
+    // Обратный порядок позволяет идти по линии задержки от старых отсчетов к новым
+    for (int i = 0; i < length; i++) {
+        fir->coefficients[i] = coefficients[length - 1 - i];
+    }
+
+    fir->dot = NULL;
+    fir->block = NULL;
+    if (mode == FIR_KERNEL_AUTO) {
+        const dsp_kernels *k = dsp_dispatch();
+        for (int i = 0; i < FIR_FIXED_COUNT; i++) {
+            if (fir_fixed_lengths[i] == length) {
+                fir->dot = k->fir_dot[i];
+                fir->block = k->fir_block[i];
+                break;
+            }
+        }
+    }
     return 0;
 }
 
 void fir_filter_free(fir_filter *fir) {
-    free(fir->coefficients);
-    free(fir->buffer);
+    if (!fir->external) {
+        free(fir->coefficients);
+        free(fir->buffer);
+    }
 }
 
 float fir_filter_process(fir_filter *fir, float input) {
     fir->buffer[fir->position] = input;
-    fir->position = (fir->position + 1) % fir->length;
+    fir->buffer[fir->position + fir->length] = input;
+    fir->position++;
+    if (fir->position == fir->length) {
+        fir->position = 0;
+    }
 
-    float output = 0.0f;
-    int index = fir->position;
+    if (fir->dot) {
+        return fir->dot(fir->coefficients, fir->buffer + fir->position);
+    }
+    return dsp_dispatch()->dot(fir->coefficients, fir->buffer + fir->position, fir->length);
+}
 
-    for (int i = 0; i < fir->length; i++) {
-        index = (index == 0) ? fir->length - 1 : index - 1;
-        output += fir->coefficients[i] * fir->buffer[index];
+static void fir_filter_run(fir_filter *fir, const float *in, float *out, int n) {
+    if (fir->block) {
+        fir->position = fir->block(fir->coefficients, fir->buffer, fir->position, in, out, n);
+        return;
     }
 
-    return output;
-} 
\ No newline at end of file
+    float (*dot)(const float *, const float *, int) = dsp_dispatch()->dot;
+    const float *coeffs = fir->coefficients;
+    float *buffer = fir->buffer;
+    int length = fir->length;
+    int position = fir->position;
+
+    for (int i = 0; i < n; i++) {
+        buffer[position] = in[i];
+        buffer[position + length] = in[i];
+        position++;
+        if (position == length) {
+            position = 0;
+        }
+        out[i] = dot(coeffs, buffer + position, length);
+    }
+
+    fir->position = position;
+}
+
+void fir_filter_process_block(fir_filter *fir, const float *in, float *out, int n) {
+    DSP_STATS_BEGIN(probe);
+    fir_filter_run(fir, in, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_FIR, n);
+}
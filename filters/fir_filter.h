@@ -3,17 +3,57 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include "workspace.h"
 
+// Ядра с длиной - константой времени компиляции. Список задается X-макросом,
+// при сборке его можно заменить (-DFIR_FIXED_TAPS_LIST=...); длины, не
+// входящие в список, обрабатываются общим ядром dsp_dot. Сами ядра
+// собираются под каждый набор команд (dsp_kernels_*.c) и берутся из
+// активной таблицы dsp_dispatch при инициализации фильтра.
+#ifndef FIR_FIXED_TAPS_LIST
+#define FIR_FIXED_TAPS_LIST(X) X(16) X(32) X(64) X(128) X(256) X(501)
+#endif
+#define FIR_FIXED_ONE(N) + 1
+#define FIR_FIXED_COUNT (0 FIR_FIXED_TAPS_LIST(FIR_FIXED_ONE))
+
+typedef enum {
+    FIR_KERNEL_AUTO = 0,  // специализированное ядро, если длина есть в списке
+    FIR_KERNEL_GENERIC    // всегда общее ядро
+} fir_kernel_mode;
+
+// Линия задержки хранится в зеркальном виде (2 * length отсчетов): каждый
+// входной отсчет записывается в buffer[position] и buffer[position + length],
+// поэтому последние length отсчетов всегда лежат непрерывно, начиная с
+// buffer[position], и свертка сводится к одному скалярному произведению.
 typedef struct {
-    float *coefficients;  
-    float *buffer;       
+    float *coefficients;  // коэффициенты в обратном порядке (h[length-1] ... h[0])
+    float *buffer;        // зеркальная линия задержки, 2 * length отсчетов
     int length;           
     int position;         
+    int external;         // массивы в рабочей области (fir_filter_free их не освобождает)
+    // Специализированное ядро для длины length (NULL - общее ядро):
+    // dot - одно скалярное произведение, block - блочная обработка целиком
+    float (*dot)(const float *coeffs, const float *x);
+    int (*block)(const float *coeffs, float *buffer, int position,
+                 const float *in, float *out, int n);
 } fir_filter;
 
 // Объявления функций
 int fir_filter_init(fir_filter *fir, const float *coefficients, int length);
+int fir_filter_init_mode(fir_filter *fir, const float *coefficients, int length,
+                         fir_kernel_mode mode);
+// Массивы из рабочей области ws (NULL - из кучи)
+int fir_filter_init_ws(fir_filter *fir, const float *coefficients, int length,
+                       fir_kernel_mode mode, workspace *ws);
+size_t fir_filter_workspace_size(int length);
 void fir_filter_free(fir_filter *fir);
 float fir_filter_process(fir_filter *fir, float input);
 
+// Блочная обработка n отсчетов (in и out могут совпадать). Состояние сохраняется между вызовами, и
+// результат побитово совпадает с последовательными вызовами
+// fir_filter_process (оба пути используют одно и то же ядро: dsp_dot или
+// специализированное). Относительно прямого суммирования в порядке
+// h[0]..h[length-1] расхождение ограничено length * 2^-24 * sum|h[i] * x[n-i]|.
+void fir_filter_process_block(fir_filter *fir, const float *in, float *out, int n);
+
 #endif // FIR_FILTER_H
@@ -0,0 +1,128 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fir_q15_filter.h"
+#include "dsp_dispatch.h"
+#include "dsp_stats.h"
+
+#define FIR_Q15_MAX_FRAC 30
+#define FIR_Q15_L1_LIMIT 65535.0  // sum|h_q| * 2^15 < 2^31
+
+int fir_q15_filter_init(fir_q15_filter *fir, const float *coefficients, int length,
+                        fixed_rounding rounding) {
+    if (length <= 0 || !coefficients) {
+        return -1;
+    }
+
+    double l1 = 0.0;
+    for (int i = 0; i < length; i++) {
+        l1 += fabs(coefficients[i]);
+    }
+    int frac = fixed_frac_bits(coefficients, length, 16, FIR_Q15_MAX_FRAC);
+    while (frac > 0 && l1 * ldexp(1.0, frac) > FIR_Q15_L1_LIMIT) {
+        frac--;
+    }
+
+    int padded = (length + FIR_Q15_PAD - 1) / FIR_Q15_PAD * FIR_Q15_PAD;
+    int16_t *quantized = malloc(length * sizeof(int16_t));
+    fir->coefficients = calloc(padded, sizeof(int16_t));
+    fir->buffer = calloc(2 * padded, sizeof(int16_t));
+    fir->history = malloc(2 * (padded - 1) * sizeof(int16_t));
+    if (!quantized || !fir->coefficients || !fir->buffer || !fir->history) {
+        free(quantized);
+        fir_q15_filter_free(fir);
+        return -2;
+    }
+
+    fixed_quantize16(coefficients, quantized, length, frac, rounding, &fir->coeff_error);
+    // Обратный порядок, как в fir_filter; нули дополнения приходятся на
+    // самые старые отсчеты окна
+    for (int i = 0; i < length; i++) {
+        fir->coefficients[padded - 1 - i] = quantized[i];
+    }
+    free(quantized);
+
+    fir->length = length;
+    fir->padded = padded;
+    fir->position = 0;
+    fir->frac_bits = frac;
+    fir->rounding = rounding;
+    fir->saturations = 0;
+    return 0;
+}
+
+void fir_q15_filter_free(fir_q15_filter *fir) {
+    free(fir->coefficients);
+    free(fir->buffer);
+    free(fir->history);
+    fir->coefficients = NULL;
+    fir->buffer = NULL;
+    fir->history = NULL;
+}
+
+static inline int16_t fir_q15_output(fir_q15_filter *fir, int32_t acc) {
+    int64_t y = fixed_round_shift(acc, fir->frac_bits, fir->rounding);
+    if (y > INT16_MAX || y < INT16_MIN) {
+        fir->saturations++;
+    }
+    return fixed_sat16(y);
+}
+
+int16_t fir_q15_filter_process(fir_q15_filter *fir, int16_t input) {
+    fir->buffer[fir->position] = input;
+    fir->buffer[fir->position + fir->padded] = input;
+    fir->position++;
+    if (fir->position == fir->padded) {
+        fir->position = 0;
+    }
+    return fir_q15_output(fir, dsp_dispatch()->dot_q15(fir->coefficients,
+                                                       fir->buffer + fir->position, fir->padded));
+}
+
+static void fir_q15_filter_run(fir_q15_filter *fir, const int16_t *in, int16_t *out, int n) {
+    if (n <= 0) {
+        return;
+    }
+    const dsp_kernels *k = dsp_dispatch();
+    const int16_t *coeffs = fir->coefficients;
+    int16_t *history = fir->history;
+    int32_t acc[FIR_Q15_CHUNK];
+    int padded = fir->padded;
+    int keep = padded - 1;
+    int head = (n < keep) ? n : keep;
+
+    // Последние padded - 1 отсчетов лежат непрерывно после самого старого;
+    // за ними - начало блока. Окна первых head выходов захватывают прошлые
+    // отсчеты и берутся из истории, остальные лежат целиком во входе
+    memcpy(history, fir->buffer + fir->position + 1, keep * sizeof(int16_t));
+    memcpy(history + keep, in, head * sizeof(int16_t));
+    for (int offset = 0; offset < n; offset += FIR_Q15_CHUNK) {
+        int chunk = (n - offset < FIR_Q15_CHUNK) ? n - offset : FIR_Q15_CHUNK;
+        int from_history = head - offset;
+        if (from_history > chunk) from_history = chunk;
+        if (from_history > 0) {
+            k->fir_q15(coeffs, history + offset, padded, acc, from_history);
+        } else {
+            from_history = 0;
+        }
+        if (from_history < chunk) {
+            k->fir_q15(coeffs, in + offset + from_history - keep, padded, acc + from_history,
+                       chunk - from_history);
+        }
+        for (int i = 0; i < chunk; i++) {
+            out[offset + i] = fir_q15_output(fir, acc[i]);
+        }
+    }
+    // Окно следующего отсчета начинается с buffer[1]
+    const int16_t *last = (n >= keep) ? in + n - keep : history + n;
+    fir->buffer[0] = fir->buffer[padded] = 0;
+    memcpy(fir->buffer + 1, last, keep * sizeof(int16_t));
+    memcpy(fir->buffer + padded + 1, last, keep * sizeof(int16_t));
+    fir->position = 0;
+}
+
+void fir_q15_filter_process_block(fir_q15_filter *fir, const int16_t *in, int16_t *out, int n) {
+    DSP_STATS_BEGIN(probe);
+    fir_q15_filter_run(fir, in, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_FIR, n);
+}
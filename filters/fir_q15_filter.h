@@ -0,0 +1,41 @@
+#ifndef FIR_Q15_FILTER_H
+#define FIR_Q15_FILTER_H
+
+#include <stdint.h>
+#include "fixed_point.h"
+
+// Длина свертки дополняется нулевыми коэффициентами до кратной этому числу,
+// чтобы ядро dot_q15 (dsp_dispatch.h) шло целыми векторами без скалярного хвоста
+#define FIR_Q15_PAD 16
+#define FIR_Q15_CHUNK 256  // выходов на проход ядра fir_q15 в блочной обработке
+
+// КИХ фильтр в фиксированной точке: отсчеты Q15, накопление в int32.
+// Линия задержки зеркальная, как в fir_filter. Коэффициенты квантуются в
+// int16 с frac_bits дробными битами; frac_bits выбирается наибольшим, при
+// котором max|h| помещается в int16, а sum|h| * 2^frac_bits <= 2^16 - 1.
+// Второе условие гарантирует |сумма| < 2^31 для любого входа Q15, поэтому
+// накопитель не переполняется и не требует насыщения; насыщение
+// выполняется один раз при округлении суммы до выхода Q15.
+// Блочная обработка идет по линейным окнам и дает тот же результат, что и
+// поотсчетная: первые padded - 1 выходов - по истории (прошлые отсчеты и
+// начало блока), остальные - прямо по входу, без перекладывания истории.
+typedef struct {
+    int16_t *coefficients;  // в обратном порядке, в начале - нули до padded
+    int16_t *buffer;        // зеркальная линия задержки, 2 * padded
+    int16_t *history;       // рабочий буфер блока, 2 * (padded - 1)
+    int length;             // число отводов
+    int padded;             // длина свертки, кратная FIR_Q15_PAD
+    int position;
+    int frac_bits;          // дробных бит коэффициентов (сдвиг выхода)
+    fixed_rounding rounding;
+    float coeff_error;      // наибольшая ошибка квантования коэффициента
+    long long saturations;  // число насыщенных выходных отсчетов
+} fir_q15_filter;
+
+int fir_q15_filter_init(fir_q15_filter *fir, const float *coefficients, int length,
+                        fixed_rounding rounding);
+void fir_q15_filter_free(fir_q15_filter *fir);
+int16_t fir_q15_filter_process(fir_q15_filter *fir, int16_t input);
+void fir_q15_filter_process_block(fir_q15_filter *fir, const int16_t *in, int16_t *out, int n);
+
+#endif // FIR_Q15_FILTER_H
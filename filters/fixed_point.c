@@ -0,0 +1,88 @@
+#include <math.h>
+#include "fixed_point.h"
+
+static double fixed_round(double v, fixed_rounding rounding) {
+    switch (rounding) {
+    case FIXED_ROUND_NEAREST:
+        return floor(v + 0.5);
+    case FIXED_ROUND_CONVERGENT:
+        return nearbyint(v);  // режим FE_TONEAREST: половина - к четному
+    default:
+        return floor(v);
+    }
+}
+
+// Квантование одного значения; *saturated увеличивается при насыщении
+static int64_t fixed_quantize_one(float x, double scale, fixed_rounding rounding,
+                                  int64_t lo, int64_t hi, int* saturated) {
+    double v = fixed_round((double)x * scale, rounding);
+    if (v > (double)hi) {
+        (*saturated)++;
+        return hi;
+    }
+    if (v < (double)lo) {
+        (*saturated)++;
+        return lo;
+    }
+    return (int64_t)v;
+}
+
+int fixed_quantize16(const float* in, int16_t* out, int n, int frac_bits,
+                     fixed_rounding rounding, float* max_error) {
+    double scale = ldexp(1.0, frac_bits);
+    int saturated = 0;
+    double err = 0.0;
+    for (int i = 0; i < n; i++) {
+        out[i] = (int16_t)fixed_quantize_one(in[i], scale, rounding, INT16_MIN, INT16_MAX,
+                                             &saturated);
+        double e = fabs(out[i] / scale - in[i]);
+        if (e > err) err = e;
+    }
+    if (max_error) *max_error = (float)err;
+    return saturated;
+}
+
+int fixed_quantize32(const float* in, int32_t* out, int n, int frac_bits,
+                     fixed_rounding rounding, float* max_error) {
+    double scale = ldexp(1.0, frac_bits);
+    int saturated = 0;
+    double err = 0.0;
+    for (int i = 0; i < n; i++) {
+        out[i] = (int32_t)fixed_quantize_one(in[i], scale, rounding, INT32_MIN, INT32_MAX,
+                                             &saturated);
+        double e = fabs(out[i] / scale - in[i]);
+        if (e > err) err = e;
+    }
+    if (max_error) *max_error = (float)err;
+    return saturated;
+}
+
+int fixed_frac_bits(const float* in, int n, int bits, int max_frac) {
+    float peak = 0.0f;
+    for (int i = 0; i < n; i++) {
+        if (fabsf(in[i]) > peak) peak = fabsf(in[i]);
+    }
+    int frac = max_frac;
+    // После округления значение не должно превысить 2^(bits-1) - 1
+    while (frac > 0 && (double)peak * ldexp(1.0, frac) + 0.5 > ldexp(1.0, bits - 1) - 1.0) {
+        frac--;
+    }
+    return frac;
+}
+
+int fixed_float_to_q15(const float* in, int16_t* out, int n, float scale,
+                       fixed_rounding rounding) {
+    double s = (double)scale * 32768.0;
+    int saturated = 0;
+    for (int i = 0; i < n; i++) {
+        out[i] = (int16_t)fixed_quantize_one(in[i], s, rounding, INT16_MIN, INT16_MAX, &saturated);
+    }
+    return saturated;
+}
+
+void fixed_q15_to_float(const int16_t* in, float* out, int n, float scale) {
+    float s = 1.0f / (32768.0f * scale);
+    for (int i = 0; i < n; i++) {
+        out[i] = in[i] * s;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+
+// Общие средства фиксированной точки для fir_q15_filter и iir_q15_filter.
+// Q15 - int16 со значением x / 2^15 в [-1, 1); Q31 - то же для int32.
+// Формат коэффициентов задается числом дробных бит frac_bits: значение
+// равно q / 2^frac_bits.
+
+typedef enum {
+    FIXED_ROUND_NEAREST = 0,  // к ближайшему, половина - вверх
+    FIXED_ROUND_TRUNCATE,     // отбрасывание младших бит (к минус бесконечности)
+    FIXED_ROUND_CONVERGENT    // к ближайшему, половина - к четному (без смещения)
+} fixed_rounding;
+
+static inline int16_t fixed_sat16(int64_t v) {
+    return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (int16_t)v;
+}
+
+static inline int32_t fixed_sat32(int64_t v) {
+    return v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : (int32_t)v;
+}
+
+// Сдвиг вправо на shift бит с округлением (shift <= 0 - без изменений)
+static inline int64_t fixed_round_shift(int64_t v, int shift, fixed_rounding rounding) {
+    if (shift <= 0) {
+        return v;
+    }
+    int64_t half = (int64_t)1 << (shift - 1);
+    switch (rounding) {
+    case FIXED_ROUND_NEAREST:
+        return (v + half) >> shift;
+    case FIXED_ROUND_CONVERGENT: {
+        // r > half или r == half при нечетном q - без ветвлений
+        int64_t q = v >> shift;
+        int64_t r = v - (q << shift);
+        return q + (r + (q & 1) > half);
+    }
+    default:
+        return v >> shift;
+    }
+}
+
+// Квантование n значений float в формат с frac_bits дробными битами.
+// Возвращает число насыщенных значений; max_error (если не NULL) -
+// наибольшая абсолютная ошибка квантования в единицах исходных значений.
+int fixed_quantize16(const float* in, int16_t* out, int n, int frac_bits,
+                     fixed_rounding rounding, float* max_error);
+int fixed_quantize32(const float* in, int32_t* out, int n, int frac_bits,
+                     fixed_rounding rounding, float* max_error);
+
+// Наибольшее число дробных бит, при котором все |in[i]| помещаются в
+// разрядность bits (16 или 32) со знаком, но не больше max_frac
+int fixed_frac_bits(const float* in, int n, int bits, int max_frac);
+
+// Перевод сигнала в Q15 с масштабом scale (x * scale должно лежать в
+// [-1, 1)); возвращает число насыщенных отсчетов
+int fixed_float_to_q15(const float* in, int16_t* out, int n, float scale,
+                       fixed_rounding rounding);
+
+// Обратный перевод: out = in / 2^15 / scale
+void fixed_q15_to_float(const int16_t* in, float* out, int n, float scale);
+
+#endif // FIXED_POINT_H
@@ -1,101 +1,196 @@
+#define _USE_MATH_DEFINES
 #include "iir_filter.h"
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include "dsp_dispatch.h"
+#include "dsp_stats.h"
+
+static int iir_filter_alloc(iir_filter* filter, int num_sections) {
+    filter->num_sections = num_sections;
+    filter->channels = 1;
+    filter->coeffs = (float*)calloc(5 * num_sections, sizeof(float));
+    filter->state = (float*)calloc(2 * num_sections, sizeof(float));
+    if (!filter->coeffs || !filter->state) {
+        iir_filter_free(filter);
+        return -1;
+    }
+    return 0;
+}
 
 int iir_filter_init(iir_filter* filter, const float* b_coeffs, int b_length, 
                    const float* a_coeffs, int a_length) {
     // Проверка корректности длин коэффициентов
-    if (b_length % 3 != 0 || a_length % 3 != 0 || b_length != a_length) {
+    if (b_length <= 0 || b_length % 3 != 0 || b_length != a_length) {
         return -1; // Некорректные длины
     }
     int num_sections = b_length / 3;
 
-    // Выделение памяти под коэффициенты
-    filter->b_coeffs = (float*)malloc(b_length * sizeof(float));
-    filter->a_coeffs = (float*)malloc(a_length * sizeof(float));
-    if (!filter->b_coeffs || !filter->a_coeffs) {
-        iir_filter_free(filter);
+    if (iir_filter_alloc(filter, num_sections) != 0) {
         return -1;
     }
 
     // Копирование коэффициентов, если предоставлены
-    if (b_coeffs) {
-        memcpy(filter->b_coeffs, b_coeffs, b_length * sizeof(float));
-    }
-    if (a_coeffs) {
-        memcpy(filter->a_coeffs, a_coeffs, a_length * sizeof(float));
+    if (b_coeffs && a_coeffs) {
+        for (int i = 0; i < num_sections; ++i) {
+            const float* b = &b_coeffs[i * 3];
+            const float* a = &a_coeffs[i * 3];
+            if (iir_filter_set_section(filter, i, b[0], b[1], b[2], a[0], a[1], a[2]) != 0) {
+                iir_filter_free(filter);
+                return -1;
+            }
+        }
     }
 
-    filter->b_length = b_length;
-    filter->a_length = a_length;
+    return 0;
+}
 
-    // Выделение памяти под буферы состояний (инициализация нулями)
-    filter->x_buffer = (float*)calloc(2 * num_sections, sizeof(float));
-    filter->y_buffer = (float*)calloc(2 * num_sections, sizeof(float));
-    if (!filter->x_buffer || !filter->y_buffer) {
-        iir_filter_free(filter);
+int iir_filter_init_sos(iir_filter* filter, const float* sos, int num_sections) {
+    if (!sos || num_sections <= 0) {
         return -1;
     }
 
-    filter->x_pos = 0;
-    filter->y_pos = 0;
+    if (iir_filter_alloc(filter, num_sections) != 0) {
+        return -1;
+    }
+
+    for (int i = 0; i < num_sections; ++i) {
+        const float* row = &sos[i * 6];
+        if (iir_filter_set_section(filter, i, row[0], row[1], row[2],
+                                   row[3], row[4], row[5]) != 0) {
+            iir_filter_free(filter);
+            return -1;
+        }
+    }
 
     return 0;
 }
 
+// Фаза и групповая задержка многочлена c0 + c1 z^-1 + c2 z^-2 на частоте w;
+// задержка - Re(sum k c_k e^{-jwk} / sum c_k e^{-jwk})
+static double iir_poly_response(const float* c, double w, double* delay) {
+    double re = 0.0, im = 0.0, kre = 0.0, kim = 0.0;
+    for (int k = 0; k < 3; k++) {
+        double cr = c[k] * cos(w * k), ci = -c[k] * sin(w * k);
+        re += cr;
+        im += ci;
+        kre += k * cr;
+        kim += k * ci;
+    }
+    *delay = (kre * re + kim * im) / (re * re + im * im);
+    return atan2(im, re);
+}
+
+int iir_filter_sos_delay(const float* sos, int num_sections, float f, float fs) {
+    if (!sos || num_sections <= 0 || !(fs > 0.0f)) {
+        return -1;
+    }
+    double w = 2.0 * M_PI * f / fs;
+    double group = 0.0, phase = 0.0;
+    for (int i = 0; i < num_sections; ++i) {
+        const float* row = &sos[i * 6];
+        double b_delay, a_delay;
+        phase += iir_poly_response(row, w, &b_delay) - iir_poly_response(row + 3, w, &a_delay);
+        group += b_delay - a_delay;
+    }
+    if (!(group >= 0.0)) {
+        return -1;
+    }
+
+    // Кандидаты по удалению от групповой задержки: 0, -1, +1, -2, ...
+    int center = (int)lround(group);
+    int best = center;
+    double best_error = 2.0 * M_PI;
+    for (int k = 0; k <= 2 * IIR_DELAY_SEARCH; k++) {
+        int d = center + ((k & 1) ? -(k + 1) / 2 : k / 2);
+        if (d < 0) {
+            continue;
+        }
+        double error = fabs(remainder(w * d + phase, 2.0 * M_PI));
+        if (error < best_error - 1e-9) {
+            best_error = error;
+            best = d;
+        }
+    }
+    return best;
+}
+
 int iir_filter_set_section(iir_filter* filter, int section, 
                           float b0, float b1, float b2,
                           float a0, float a1, float a2) {
-    int num_sections = filter->b_length / 3;
-    if (section < 0 || section >= num_sections) {
+    if (section < 0 || section >= filter->num_sections || a0 == 0.0f) {
         return -1;
     }
-    filter->b_coeffs[section * 3] = b0;
-    filter->b_coeffs[section * 3 + 1] = b1;
-    filter->b_coeffs[section * 3 + 2] = b2;
-    filter->a_coeffs[section * 3] = a0;
-    filter->a_coeffs[section * 3 + 1] = a1;
-    filter->a_coeffs[section * 3 + 2] = a2;
+    // Нормировка на a0 выполняется один раз, а не на каждом отсчете
+    float* c = &filter->coeffs[section * 5];
+    c[0] = b0 / a0;
+    c[1] = b1 / a0;
+    c[2] = b2 / a0;
+    c[3] = a1 / a0;
+    c[4] = a2 / a0;
     return 0;
 }
 
 void iir_filter_free(iir_filter* filter) {
-    free(filter->b_coeffs);
-    free(filter->a_coeffs);
-    free(filter->x_buffer);
-    free(filter->y_buffer);
-    filter->b_coeffs = NULL;
-    filter->a_coeffs = NULL;
-    filter->x_buffer = NULL;
-    filter->y_buffer = NULL;
-    filter->b_length = 0;
-    filter->a_length = 0;
-    filter->x_pos = 0;
-    filter->y_pos = 0;
+    free(filter->coeffs);
+    free(filter->state);
+    filter->coeffs = NULL;
+    filter->state = NULL;
+    filter->num_sections = 0;
+    filter->channels = 0;
 }
 
 float iir_filter_process(iir_filter* filter, float input) {
+    if (filter->channels != 1) {
+        return 0.0f;
+    }
+    // То же ядро, что у блочной обработки, поэтому результаты совпадают побитово
     float output = input;
-    int num_sections = filter->b_length / 3;
-
-    for (int i = 0; i < num_sections; ++i) {
-        const float* b = &filter->b_coeffs[i * 3];
-        const float* a = &filter->a_coeffs[i * 3];
-        float* x_buf = &filter->x_buffer[i * 2];
-        float* y_buf = &filter->y_buffer[i * 2];
+    dsp_dispatch()->biquad(filter->coeffs, filter->state, filter->num_sections, &output, 1);
+    return output;
+}
 
-        float x = output;
+static void iir_filter_run(iir_filter* filter, const float* in, float* out, int n) {
+    if (in != out) {
+        memmove(out, in, n * sizeof(float));
+    }
+    dsp_dispatch()->biquad(filter->coeffs, filter->state, filter->num_sections, out, n);
+}
 
-        float y = (b[0] * x + b[1] * x_buf[0] + b[2] * x_buf[1]
-                 - a[1] * y_buf[0] - a[2] * y_buf[1]) / a[0];
-        x_buf[1] = x_buf[0];
-        x_buf[0] = x;
+void iir_filter_process_block(iir_filter* filter, const float* in, float* out, int n) {
+    if (filter->channels != 1) {
+        return;
+    }
+    DSP_STATS_BEGIN(probe);
+    iir_filter_run(filter, in, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_IIR, n);
+}
 
-        y_buf[1] = y_buf[0];
-        y_buf[0] = y;
+int iir_filter_set_channels(iir_filter* filter, int channels) {
+    if (channels <= 0) {
+        return -1;
+    }
+    float* state = (float*)calloc(2 * filter->num_sections * channels, sizeof(float));
+    if (!state) {
+        return -1;
+    }
+    free(filter->state);
+    filter->state = state;
+    filter->channels = channels;
+    return 0;
+}
 
-        output = y;
+static void iir_filter_run_interleaved(iir_filter* filter, const float* in, float* out, int n) {
+    int channels = filter->channels;
+    if (in != out) {
+        memmove(out, in, (size_t)n * channels * sizeof(float));
     }
+    dsp_dispatch()->biquad_frames(filter->coeffs, filter->state, filter->num_sections,
+                                  channels, out, n);
+}
 
-    return output;
-}
\ No newline at end of file
+void iir_filter_process_interleaved(iir_filter* filter, const float* in, float* out, int n) {
+    DSP_STATS_BEGIN(probe);
+    iir_filter_run_interleaved(filter, in, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_IIR, (long long)n * filter->channels);
+}
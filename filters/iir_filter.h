@@ -2,21 +2,37 @@
 #ifndef IIR_FILTER_H
 #define IIR_FILTER_H
 
+// Каскад биквадратных секций (SOS). Коэффициенты нормируются на a0 при
+// инициализации, состояние секции - два отсчета транспонированной прямой
+// формы II:
+//   y  = b0 * x + s1
+//   s1 = b1 * x - a1 * y + s2
+//   s2 = b2 * x - a2 * y
 typedef struct {
-    float* b_coeffs;  // Коэффициенты числителя
-    float* a_coeffs;  // Коэффициенты знаменателя
-    float* x_buffer;  // Буфер входных отсчетов
-    float* y_buffer;  // Буфер выходных отсчетов
-    int b_length;     // Длина числителя
-    int a_length;     // Длина знаменателя
-    int x_pos;        // Позиция в буфере входных отсчетов
-    int y_pos;        // Позиция в буфере выходных отсчетов
+    float* coeffs;     // b0, b1, b2, a1, a2 для каждой секции
+    float* state;      // s1[channels], s2[channels] для каждой секции
+    int num_sections;  // Число секций
+    int channels;      // Число каналов в чередующемся режиме (по умолчанию 1)
 } iir_filter;
 
-// Инициализация IIR фильтра
+// Инициализация IIR фильтра: коэффициенты задаются тройками
+// (b0, b1, b2) и (a0, a1, a2) на секцию
 int iir_filter_init(iir_filter* filter, const float* b_coeffs, int b_length, 
                    const float* a_coeffs, int a_length);
 
+// Инициализация по матрице SOS (строки b0, b1, b2, a0, a1, a2, как
+// scipy.signal.butter(..., output='sos'))
+int iir_filter_init_sos(iir_filter* filter, const float* sos, int num_sections);
+
+// Задержка демодулятора после каскада SOS (строки как в
+// iir_filter_init_sos) для сигнала с несущей f. Огибающая запаздывает на
+// групповую задержку на f, а гетеродин демодулятора, пропустив d отсчетов,
+// поворачивает фазу на 2 pi f d / fs, поэтому из целых d в пределах
+// IIR_DELAY_SEARCH от групповой задержки выбирается то, при котором этот
+// поворот ближе всего к фазе каскада на f. -1 - неверные параметры
+#define IIR_DELAY_SEARCH 2
+int iir_filter_sos_delay(const float* sos, int num_sections, float f, float fs);
+
 int iir_filter_set_section(iir_filter* filter, int section, 
                           float b0, float b1, float b2,
                           float a0, float a1, float a2);
@@ -27,4 +43,17 @@ void iir_filter_free(iir_filter* filter);
 // Обработка одного отсчета
 float iir_filter_process(iir_filter* filter, float input);
 
-#endif
\ No newline at end of file
+// Обработка блока: каждая секция проходит весь блок целиком, пока ее
+// коэффициенты и состояние в регистрах. in и out могут совпадать.
+void iir_filter_process_block(iir_filter* filter, const float* in, float* out, int n);
+
+// Режим нескольких независимых каналов с одинаковыми коэффициентами.
+// Состояние сбрасывается. При channels != 1 process возвращает 0, а
+// process_block не трогает out: состояние разложено по каналам
+int iir_filter_set_channels(iir_filter* filter, int channels);
+
+// Обработка n кадров чередующихся отсчетов (in[t * channels + c]).
+// Рекурсия по времени не векторизуется, поэтому векторизация идет по каналам.
+void iir_filter_process_interleaved(iir_filter* filter, const float* in, float* out, int n);
+
+#endif
@@ -0,0 +1,102 @@
+#include <stdlib.h>
+#include <string.h>
+#include "iir_q15_filter.h"
+#include "dsp_dispatch.h"
+#include "dsp_stats.h"
+
+#define IIR_Q15_B_MAX_FRAC 60
+#define IIR_Q15_CHUNK 256    // отсчетов на проход секций в блочном режиме
+
+int iir_q15_filter_init_sos(iir_q15_filter *filter, const float *sos, int num_sections,
+                            fixed_rounding rounding) {
+    if (!sos || num_sections <= 0) {
+        return -1;
+    }
+    filter->coeffs = calloc(6 * num_sections, sizeof(int32_t));
+    filter->state = calloc(4 * num_sections, sizeof(int32_t));
+    if (!filter->coeffs || !filter->state) {
+        iir_q15_filter_free(filter);
+        return -2;
+    }
+
+    float max_error = 0.0f;
+    for (int i = 0; i < num_sections; i++) {
+        const float *row = &sos[i * 6];
+        if (row[3] == 0.0f) {
+            iir_q15_filter_free(filter);
+            return -1;
+        }
+        // Нормировка на a0, как в iir_filter_set_section
+        float b[3] = {row[0] / row[3], row[1] / row[3], row[2] / row[3]};
+        float a[2] = {row[4] / row[3], row[5] / row[3]};
+        int32_t *c = &filter->coeffs[i * 6];
+        int b_frac = fixed_frac_bits(b, 3, 32, IIR_Q15_B_MAX_FRAC);
+        float err_b, err_a;
+        if (b_frac < IIR_Q15_A_FRAC ||
+            fixed_quantize32(a, c + 3, 2, IIR_Q15_A_FRAC, rounding, &err_a) != 0) {
+            // |b| >= 2 или |a| >= 2: формат секции не подходит
+            iir_q15_filter_free(filter);
+            return -3;
+        }
+        fixed_quantize32(b, c, 3, b_frac, rounding, &err_b);
+        c[5] = b_frac;
+        if (err_b > max_error) max_error = err_b;
+        if (err_a > max_error) max_error = err_a;
+    }
+
+    filter->num_sections = num_sections;
+    filter->rounding = rounding;
+    filter->coeff_error = max_error;
+    filter->saturations = 0;
+    return 0;
+}
+
+void iir_q15_filter_free(iir_q15_filter *filter) {
+    free(filter->coeffs);
+    free(filter->state);
+    filter->coeffs = NULL;
+    filter->state = NULL;
+    filter->num_sections = 0;
+}
+
+int16_t iir_q15_filter_process(iir_q15_filter *filter, int16_t input) {
+    int32_t v = (int32_t)input * (1 << (16 - IIR_Q15_GUARD_BITS));
+    for (int i = 0; i < filter->num_sections; i++) {
+        v = iir_q15_section(&filter->coeffs[i * 6], &filter->state[i * 4], v,
+                            filter->rounding, &filter->saturations);
+    }
+    int64_t y = fixed_round_shift(v, 16 - IIR_Q15_GUARD_BITS, filter->rounding);
+    if (y > INT16_MAX || y < INT16_MIN) {
+        filter->saturations++;
+    }
+    return fixed_sat16(y);
+}
+
+// Блочный режим: как в iir_filter_process_block, каждая секция проходит
+// порцию отсчетов целиком (ядро biquad_q15 активной таблицы dsp_dispatch);
+// результат совпадает с поотсчетной обработкой
+static void iir_q15_filter_run(iir_q15_filter *filter, const int16_t *in, int16_t *out, int n) {
+    const dsp_kernels *k = dsp_dispatch();
+    int32_t work[IIR_Q15_CHUNK];
+    for (int offset = 0; offset < n; offset += IIR_Q15_CHUNK) {
+        int m = (n - offset < IIR_Q15_CHUNK) ? n - offset : IIR_Q15_CHUNK;
+        for (int t = 0; t < m; t++) {
+            work[t] = (int32_t)in[offset + t] * (1 << (16 - IIR_Q15_GUARD_BITS));
+        }
+        filter->saturations += k->biquad_q15(filter->coeffs, filter->state, filter->num_sections,
+                                             work, m, filter->rounding);
+        for (int t = 0; t < m; t++) {
+            int64_t y = fixed_round_shift(work[t], 16 - IIR_Q15_GUARD_BITS, filter->rounding);
+            if (y > INT16_MAX || y < INT16_MIN) {
+                filter->saturations++;
+            }
+            out[offset + t] = fixed_sat16(y);
+        }
+    }
+}
+
+void iir_q15_filter_process_block(iir_q15_filter *filter, const int16_t *in, int16_t *out, int n) {
+    DSP_STATS_BEGIN(probe);
+    iir_q15_filter_run(filter, in, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_IIR, n);
+}
@@ -0,0 +1,58 @@
+#ifndef IIR_Q15_FILTER_H
+#define IIR_Q15_FILTER_H
+
+#include <stdint.h>
+#include "fixed_point.h"
+
+// Запас сверху для промежуточных сигналов каскада: Q15 на входе переводится
+// в Q31 со сдвигом на 16 - IIR_Q15_GUARD_BITS, поэтому секция может усилить
+// сигнал в 2^IIR_Q15_GUARD_BITS раз до насыщения
+#define IIR_Q15_GUARD_BITS 4
+#define IIR_Q15_A_FRAC 30    // a1, a2 в Q30
+
+// Каскад биквадов в фиксированной точке с входом и выходом Q15. Полюса
+// полосовых фильтров coeffs.h лежат на радиусе ~0.97-0.99, и 16-битных
+// коэффициентов и состояния для них мало (предельные циклы, сдвиг полюсов),
+// поэтому внутри используется Q31: прямая форма I, состояние секции -
+// x[n-1], x[n-2], y[n-1], y[n-2] в Q31, коэффициенты a в Q30 (|a1| < 2),
+// коэффициенты b каждой секции - со своим числом дробных бит (у первой
+// секции полосового фильтра они порядка 1e-6). Произведения копятся в
+// int64, выход секции округляется и насыщается до Q31.
+typedef struct {
+    int32_t *coeffs;        // b0, b1, b2, a1, a2, b_frac для каждой секции
+    int32_t *state;         // x1, x2, y1, y2 для каждой секции
+    int num_sections;
+    fixed_rounding rounding;
+    float coeff_error;      // наибольшая ошибка квантования коэффициента
+    long long saturations;  // число насыщений выходов секций и выхода Q15
+} iir_q15_filter;
+
+// Прямая форма I: y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2. Сумма по b
+// приводится к дробным битам a (Q61 = Q31 * Q30) сдвигом вправо на
+// b_frac - 30 бит; при |x|, |y| < 2^27 (защитные биты) сумма по модулю
+// меньше 2^63. Общая для поотсчетного режима и ядра biquad_q15 (dsp_dispatch.h)
+static inline int32_t iir_q15_section(const int32_t *c, int32_t *s, int32_t x,
+                                      fixed_rounding rounding, long long *saturations) {
+    int64_t acc_b = (int64_t)c[0] * x + (int64_t)c[1] * s[0] + (int64_t)c[2] * s[1];
+    int64_t acc = (acc_b >> (c[5] - IIR_Q15_A_FRAC)) -
+                  (int64_t)c[3] * s[2] - (int64_t)c[4] * s[3];
+    int64_t y = fixed_round_shift(acc, IIR_Q15_A_FRAC, rounding);
+    if (y > INT32_MAX || y < INT32_MIN) {
+        (*saturations)++;
+    }
+    int32_t out = fixed_sat32(y);
+    s[1] = s[0];
+    s[0] = x;
+    s[3] = s[2];
+    s[2] = out;
+    return out;
+}
+
+// Матрица SOS в формате iir_filter_init_sos (b0, b1, b2, a0, a1, a2)
+int iir_q15_filter_init_sos(iir_q15_filter *filter, const float *sos, int num_sections,
+                            fixed_rounding rounding);
+void iir_q15_filter_free(iir_q15_filter *filter);
+int16_t iir_q15_filter_process(iir_q15_filter *filter, int16_t input);
+void iir_q15_filter_process_block(iir_q15_filter *filter, const int16_t *in, int16_t *out, int n);
+
+#endif // IIR_Q15_FILTER_H
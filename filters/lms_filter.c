@@ -1,24 +1,41 @@
 #include <stdlib.h>
 #include <string.h>
 #include "lms_filter.h"
+#include "dsp_dispatch.h"
+#include "dsp_stats.h"
 
 int lms_filter_init(lms_filter *filter, int length, float mu) {
-    if (!filter || length <= 0 || mu <= 0.0f) {
+    return lms_filter_init_block(filter, length, mu, 1);
+}
+
+int lms_filter_init_block(lms_filter *filter, int length, float mu, int block_size) {
+    if (!filter || length <= 0 || mu <= 0.0f || block_size <= 0) {
         return -1;
     }
 
+    memset(filter, 0, sizeof(*filter));
     filter->length = length;
     filter->mu = mu;
+    filter->block_size = block_size;
     
     filter->weights = (float*)calloc(length, sizeof(float));
-    filter->buffer = (float*)calloc(length, sizeof(float));
-    
+    filter->buffer = (float*)calloc(2 * length, sizeof(float));
     if (!filter->weights || !filter->buffer) {
         lms_filter_free(filter);
         return -2;
     }
+
+    if (block_size > 1) {
+        filter->history = (float*)calloc(length - 1 + block_size, sizeof(float));
+        filter->errors = (float*)calloc(block_size, sizeof(float));
+        if (!filter->history || !filter->errors) {
+            lms_filter_free(filter);
+            return -2;
+        }
+    }
     
     filter->position = 0;
+    filter->fill = 0;
     return 0;
 }
 
@@ -26,26 +43,68 @@ void lms_filter_free(lms_filter *filter) {
     if (filter) {
         free(filter->weights);
         free(filter->buffer);
+        free(filter->history);
+        free(filter->errors);
+        filter->weights = NULL;
+        filter->buffer = NULL;
+        filter->history = NULL;
+        filter->errors = NULL;
     }
 }
 
 float lms_filter_process(lms_filter *filter, float input, float desired) {
+    const dsp_kernels *kernels = dsp_dispatch();
     filter->buffer[filter->position] = input;
-
-    float output = 0.0f;
-    for (int i = 0; i < filter->length; i++) {
-        int idx = (filter->position - i + filter->length) % filter->length;
-        output += filter->weights[i] * filter->buffer[idx];
+    filter->buffer[filter->position + filter->length] = input;
+    filter->position++;
+    if (filter->position == filter->length) {
+        filter->position = 0;
     }
-    
+    const float *x = filter->buffer + filter->position;
+
+    float output = kernels->dot(filter->weights, x, filter->length);
     float error = desired - output;
+    kernels->axpy(filter->weights, x, filter->length, filter->mu * error);
     
-    for (int i = 0; i < filter->length; i++) {
-        int idx = (filter->position - i + filter->length) % filter->length;
-        filter->weights[i] += filter->mu * error * filter->buffer[idx];
+    return output;
+}
+
+static void lms_filter_run(lms_filter *filter, const float *in, const float *desired,
+                           float *out, int n) {
+    const dsp_kernels *kernels = dsp_dispatch();
+    if (filter->block_size == 1) {
+        for (int i = 0; i < n; i++) {
+            out[i] = lms_filter_process(filter, in[i], desired[i]);
+        }
+        return;
     }
 
-    filter->position = (filter->position + 1) % filter->length;
-    
-    return output;
-} 
\ No newline at end of file
+    int length = filter->length;
+    int block = filter->block_size;
+    float *history = filter->history;
+
+    for (int i = 0; i < n; i++) {
+        int k = filter->fill;
+        history[length - 1 + k] = in[i];
+        out[i] = kernels->dot(filter->weights, history + k, length);
+        filter->errors[k] = desired[i] - out[i];
+        filter->fill++;
+
+        if (filter->fill == block) {
+            // Градиент как взаимная корреляция ошибок и входа:
+            // g[j] = sum_k e[k] * history[k + j]
+            for (int j = 0; j < length; j++) {
+                filter->weights[j] += filter->mu * kernels->dot(filter->errors, history + j, block);
+            }
+            memmove(history, history + block, (length - 1) * sizeof(float));
+            filter->fill = 0;
+        }
+    }
+}
+
+void lms_filter_process_block(lms_filter *filter, const float *in, const float *desired,
+                              float *out, int n) {
+    DSP_STATS_BEGIN(probe);
+    lms_filter_run(filter, in, desired, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_LMS, n);
+}
@@ -5,17 +5,36 @@
 #include <string.h>
 #include <stdio.h>
 
+// Веса хранятся в порядке линии задержки: weights[length - 1] умножается на
+// самый новый отсчет. Линия задержки зеркальная (см. fir_filter), поэтому
+// и выход, и обновление весов - проходы по непрерывной памяти.
+//
+// Блочный режим (block_size > 1): выходы блока считаются с неизменными
+// весами, градиент накапливается за блок и применяется один раз:
+// w += mu * sum(e[k] * x_k). При том же mu постоянная времени в отсчетах и
+// установившаяся ошибка те же, что у поотсчетного LMS, но градиент
+// запаздывает на блок, поэтому граница устойчивости уже - примерно
+// mu < 2 / (block_size * lambda_max). Для сигналов, где поотсчетный LMS
+// отслеживает быстрые изменения (несущая), блочный режим этого не умеет.
 typedef struct {
     float *weights;    // веса фильтра
-    float *buffer;     // буфер входных отсчетов
+    float *buffer;     // зеркальная линия задержки, 2 * length (поотсчетный режим)
     int length;        // длина фильтра
     float mu;          // шаг адаптации
     int position;      // текущая позиция в буфере
+    int block_size;    // размер блока (1 - поотсчетный LMS)
+    float *history;    // length - 1 + block_size отсчетов (блочный режим)
+    float *errors;     // ошибки текущего блока
+    int fill;          // заполнено отсчетов в текущем блоке
 } lms_filter;
 
 int lms_filter_init(lms_filter *filter, int length, float mu);
+int lms_filter_init_block(lms_filter *filter, int length, float mu, int block_size);
 void lms_filter_free(lms_filter *filter);
 float lms_filter_process(lms_filter *filter, float input, float desired);
 
-#endif // LMS_FILTER_H
+// Обработка n отсчетов; при block_size == 1 эквивалентна вызовам lms_filter_process
+void lms_filter_process_block(lms_filter *filter, const float *in, const float *desired,
+                              float *out, int n);
 
+#endif // LMS_FILTER_H
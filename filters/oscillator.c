@@ -0,0 +1,48 @@
+#define _USE_MATH_DEFINES
+#include <stddef.h>
+#include <math.h>
+#include "oscillator.h"
+#include "dsp_dispatch.h"
+
+// 2^32 отсчетов аккумулятора на оборот
+#define OSC_PHASE_SCALE 4294967296.0
+
+int oscillator_init(oscillator* osc, float freq, float fs) {
+    if (!osc || fs <= 0.0f) {
+        return -1;
+    }
+
+    // Отрицательные частоты и частоты выше fs сводятся к шагу по модулю 2^32
+    double turns = fmod((double)freq / fs, 1.0);
+    if (turns < 0.0) turns += 1.0;
+    osc->step = (uint32_t)(int64_t)llround(turns * OSC_PHASE_SCALE);
+    osc->phase = 0;
+    osc->offset = 0;
+
+    for (int k = 0; k < OSC_BLOCK; k++) {
+        uint32_t p = osc->step * (uint32_t)k;
+        double angle = 2 * M_PI * (p / OSC_PHASE_SCALE);
+        osc->rot[k].real = (float)cos(angle);
+        osc->rot[k].imag = (float)sin(angle);
+    }
+    oscillator_reseed(osc);
+    return 0;
+}
+
+void oscillator_reseed(oscillator* osc) {
+    double angle = 2 * M_PI * (osc->phase / OSC_PHASE_SCALE);
+    osc->base.real = (float)cos(angle);
+    osc->base.imag = (float)sin(angle);
+}
+
+void oscillator_generate(oscillator* osc, complex_float* out, int n) {
+    dsp_dispatch()->oscillator(osc, NULL, out, n, 0);
+}
+
+void oscillator_mix(oscillator* osc, const complex_float* in, complex_float* out, int n) {
+    dsp_dispatch()->oscillator(osc, in, out, n, 1);
+}
+
+void oscillator_mix_conj(oscillator* osc, const complex_float* in, complex_float* out, int n) {
+    dsp_dispatch()->oscillator(osc, in, out, n, -1);
+}
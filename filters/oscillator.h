@@ -0,0 +1,61 @@
+#ifndef OSCILLATOR_H
+#define OSCILLATOR_H
+
+#include <stdint.h>
+#include "complex_float.h"
+
+// Генератор комплексной несущей e^{j*phi[n]} без cosf/sinf на каждый отсчет.
+//
+// Фаза ведется 32-битным аккумулятором (2^32 = полный оборот), поэтому на
+// любой длине потока она точна: частота квантуется с шагом fs / 2^32, а
+// фаза отсчета n равна n * step по модулю 2^32 без накопления ошибки.
+// Отсчеты разбиты на блоки по OSC_BLOCK от начала потока; в начале блока
+// фазор вычисляется заново (cos/sin в double), внутри блока
+// e^{j*phi[n]} = base * rot[n - n0], где rot[k] = e^{j*k*w} - таблица.
+// Выход зависит только от номера отсчета, но не от разбиения на вызовы.
+//
+// Точность: base и rot округлены до float (по 2^-24), произведение дает
+// еще одно округление, итого погрешность отсчета не больше ~2^-22 (2.4e-7)
+// по амплитуде и фазе и не накапливается. Ошибка периодична с периодом
+// блока, поэтому паразитные составляющие лежат ниже -120 дБн.
+#define OSC_BLOCK 64
+
+typedef struct {
+    uint32_t phase;                 // фаза начала текущего блока
+    uint32_t step;                  // приращение фазы на отсчет
+    int offset;                     // номер отсчета внутри блока
+    complex_float base;             // e^{j*phase}
+    complex_float rot[OSC_BLOCK];   // e^{j*k*step}
+} oscillator;
+
+// Генератор частоты freq при частоте дискретизации fs, начальная фаза 0
+int oscillator_init(oscillator* osc, float freq, float fs);
+
+// Пересчет фазора начала блока (вызывается из oscillator_next)
+void oscillator_reseed(oscillator* osc);
+
+// n отсчетов несущей e^{j*phi}
+void oscillator_generate(oscillator* osc, complex_float* out, int n);
+
+// Перенос вверх: out = in * e^{j*phi}
+void oscillator_mix(oscillator* osc, const complex_float* in, complex_float* out, int n);
+
+// Перенос вниз: out = in * e^{-j*phi}
+void oscillator_mix_conj(oscillator* osc, const complex_float* in, complex_float* out, int n);
+
+// Очередной отсчет несущей для поотсчетных циклов
+static inline complex_float oscillator_next(oscillator* osc) {
+    if (osc->offset == 0) {
+        oscillator_reseed(osc);
+    }
+    complex_float r = osc->rot[osc->offset];
+    complex_float b = osc->base;
+    complex_float out = {b.real * r.real - b.imag * r.imag, b.real * r.imag + b.imag * r.real};
+    if (++osc->offset == OSC_BLOCK) {
+        osc->offset = 0;
+        osc->phase += osc->step * (uint32_t)OSC_BLOCK;
+    }
+    return out;
+}
+
+#endif // OSCILLATOR_H
@@ -1,30 +1,80 @@
 #include <stdlib.h>
 #include <string.h>
 #include "rls_filter.h"
+#include "dsp_dispatch.h"
+#include "dsp_stats.h"
+
+// Раскладка состояния решетки: массивы по length элементов. Обратные
+// величины предыдущего отсчета хранятся, чтобы деления на B_m(n-1) и
+// gamma_m(n-1) стали умножениями
+enum {
+    LAT_F = 0,      // энергия ошибки прямого предсказания F_m(n-1)
+    LAT_B,          // энергия ошибки обратного предсказания B_m(n-1)
+    LAT_INV_B,      // 1 / B_m(n-1)
+    LAT_BERR,       // апостериорная ошибка обратного предсказания b_m(n-1)
+    LAT_INV_GAMMA,  // 1 / gamma_m(n-1), gamma - коэффициент преобразования
+    LAT_DELTA,      // взаимная корреляция Delta_m
+    LAT_RHO,        // взаимная корреляция совместного оценивания rho_m
+    LAT_ARRAYS
+};
+
+static void rls_lattice_reset(rls_filter *filter) {
+    int N = filter->length;
+    float *lat = filter->lattice;
+    for (int m = 0; m < N; m++) {
+        lat[LAT_F * N + m] = filter->delta;
+        lat[LAT_B * N + m] = filter->delta;
+        lat[LAT_INV_B * N + m] = 1.0f / filter->delta;
+        lat[LAT_BERR * N + m] = 0.0f;
+        lat[LAT_INV_GAMMA * N + m] = 1.0f;
+        lat[LAT_DELTA * N + m] = 0.0f;
+        lat[LAT_RHO * N + m] = 0.0f;
+    }
+}
 
 int rls_filter_init(rls_filter *filter, int length, float lambda, float delta) {
+    return rls_filter_init_mode(filter, length, lambda, delta, RLS_MODE_STANDARD);
+}
+
+int rls_filter_init_mode(rls_filter *filter, int length, float lambda, float delta,
+                         rls_mode mode) {
     if (!filter || length <= 0 || lambda <= 0.0f || lambda > 1.0f || delta <= 0.0f) {
         return -1;
     }
 
+    memset(filter, 0, sizeof(*filter));
     filter->length = length;
     filter->lambda = lambda;
     filter->delta = delta;
+    filter->mode = mode;
     
     filter->weights = (float*)calloc(length, sizeof(float));
-    filter->buffer = (float*)calloc(length, sizeof(float));
-    filter->P = (float*)malloc(length * length * sizeof(float));
-    
-    if (!filter->weights || !filter->buffer || !filter->P) {
+    filter->buffer = (float*)calloc(2 * length, sizeof(float));
+    if (!filter->weights || !filter->buffer) {
+        rls_filter_free(filter);
+        return -2;
+    }
+
+    if (mode == RLS_MODE_LATTICE) {
+        filter->lattice = (float*)malloc(LAT_ARRAYS * length * sizeof(float));
+        if (!filter->lattice) {
+            rls_filter_free(filter);
+            return -2;
+        }
+        rls_lattice_reset(filter);
+        return 0;
+    }
+
+    filter->P = (float*)calloc(length * length, sizeof(float));
+    filter->Px = (float*)calloc(length, sizeof(float));
+    if (!filter->P || !filter->Px) {
         rls_filter_free(filter);
         return -2;
     }
     
     // Инициализация матрицы P
     for (int i = 0; i < length; i++) {
-        for (int j = 0; j < length; j++) {
-            filter->P[i * length + j] = (i == j) ? 1.0f / delta : 0.0f;
-        }
+        filter->P[i * length + i] = 1.0f / delta;
     }
     
     filter->position = 0;
@@ -36,73 +86,154 @@ void rls_filter_free(rls_filter *filter) {
         free(filter->weights);
         free(filter->buffer);
         free(filter->P);
+        free(filter->Px);
+        free(filter->lattice);
+        filter->weights = NULL;
+        filter->buffer = NULL;
+        filter->P = NULL;
+        filter->Px = NULL;
+        filter->lattice = NULL;
     }
 }
 
-float rls_filter_process(rls_filter *filter, float input, float desired) {
+static float rls_standard_process(rls_filter *filter, float input, float desired) {
+    const dsp_kernels *kernels = dsp_dispatch();
+    int N = filter->length;
+    float *P = filter->P;
+    float *Px = filter->Px;
+
     // Обновляем буфер входных отсчетов
     filter->buffer[filter->position] = input;
-    
-    // Вычисляем выходной отсчет
-    float output = 0.0f;
-    for (int i = 0; i < filter->length; i++) {
-        int idx = (filter->position - i + filter->length) % filter->length;
-        output += filter->weights[i] * filter->buffer[idx];
+    filter->buffer[filter->position + N] = input;
+    filter->position++;
+    if (filter->position == N) {
+        filter->position = 0;
     }
+    const float *x = filter->buffer + filter->position;
     
-    // Вычисляем ошибку
+    // Вычисляем выходной отсчет и ошибку
+    float output = kernels->dot(filter->weights, x, N);
     float error = desired - output;
     
-    // Вычисляем вектор k (коэффициент Калмана)
-    float *k = (float*)malloc(filter->length * sizeof(float));
-    if (!k) return output;
-    
-    // P * x
-    for (int i = 0; i < filter->length; i++) {
-        k[i] = 0.0f;
-        for (int j = 0; j < filter->length; j++) {
-            int idx = (filter->position - j + filter->length) % filter->length;
-            k[i] += filter->P[i * filter->length + j] * filter->buffer[idx];
-        }
+    // P * x по верхнему треугольнику: строка i дает диагональную и
+    // наддиагональную часть Px[i], а ее хвост - поддиагональный вклад в Px[j > i]
+    memset(Px, 0, N * sizeof(float));
+    for (int i = 0; i < N; i++) {
+        const float *row = &P[i * N];
+        Px[i] += kernels->dot(row + i, x + i, N - i);
+        kernels->axpy(Px + i + 1, row + i + 1, N - i - 1, x[i]);
     }
     
-    // x^T * P * x
-    float denominator = filter->lambda;
-    for (int i = 0; i < filter->length; i++) {
-        int idx = (filter->position - i + filter->length) % filter->length;
-        denominator += filter->buffer[idx] * k[i];
-    }
-    
-    // k = k / (lambda + x^T * P * x)
-    for (int i = 0; i < filter->length; i++) {
-        k[i] /= denominator;
-    }
+    // lambda + x^T * P * x
+    float denominator = filter->lambda + kernels->dot(x, Px, N);
+    float inv_den = 1.0f / denominator;
     
-    // Обновляем веса
-    for (int i = 0; i < filter->length; i++) {
-        filter->weights[i] += k[i] * error;
-    }
+    // Обновляем веса: w += k * e, k = P x / denominator
+    kernels->axpy(filter->weights, Px, N, error * inv_den);
     
-    // Обновляем матрицу P
-    float *P_new = (float*)malloc(filter->length * filter->length * sizeof(float));
-    if (!P_new) {
-        free(k);
-        return output;
+    // Обновляем верхний треугольник P = (P - k (P x)^T) / lambda
+    float inv_lambda = 1.0f / filter->lambda;
+    for (int i = 0; i < N; i++) {
+        float *row = &P[i * N];
+        float c = Px[i] * inv_den;
+        for (int j = i; j < N; j++) {
+            row[j] = (row[j] - c * Px[j]) * inv_lambda;
+        }
     }
     
-    for (int i = 0; i < filter->length; i++) {
-        for (int j = 0; j < filter->length; j++) {
-            P_new[i * filter->length + j] = (filter->P[i * filter->length + j] - 
-                k[i] * k[j] * denominator) / filter->lambda;
+    return output;
+}
+
+static float rls_lattice_process(rls_filter *filter, float input, float desired) {
+    int N = filter->length;
+    float lambda = filter->lambda;
+    float *lat = filter->lattice;
+    float *F = &lat[LAT_F * N];
+    float *B = &lat[LAT_B * N];
+    float *inv_B = &lat[LAT_INV_B * N];
+    float *berr = &lat[LAT_BERR * N];
+    float *inv_gamma = &lat[LAT_INV_GAMMA * N];
+    float *Delta = &lat[LAT_DELTA * N];
+    float *rho = &lat[LAT_RHO * N];
+
+    // Ступень 0: f_0(n) = b_0(n) = u(n), gamma_0(n) = 1
+    float f = input;
+    float b = input;
+    float g = 1.0f;
+    float Fm = lambda * F[0] + input * input;
+    float Bm = Fm;
+    float e = desired;
+    int stable = 1;
+
+    for (int m = 0; m < N; m++) {
+        // Совместное оценивание на ступени m
+        float inv_Bm = 1.0f / Bm;
+        float inv_g = 1.0f / g;
+        rho[m] = lambda * rho[m] + b * e * inv_g;
+        e -= rho[m] * inv_Bm * b;
+
+        float b_prev = berr[m];
+        float B_prev = B[m];
+        float inv_B_prev = inv_B[m];
+        float inv_g_prev = inv_gamma[m];
+        float g_next = g - b * b * inv_Bm;
+
+        // Сохраняем значения ступени m для следующего шага
+        F[m] = Fm;
+        B[m] = Bm;
+        inv_B[m] = inv_Bm;
+        berr[m] = b;
+        inv_gamma[m] = inv_g;
+        g = g_next;
+
+        if (m == N - 1) {
+            break;
+        }
+
+        // Переход к ступени m + 1
+        float D = lambda * Delta[m] + b_prev * f * inv_g_prev;
+        float kf = D * inv_B_prev;
+        float kb = D / Fm;
+        Delta[m] = D;
+        float f_next = f - kf * b_prev;
+        b = b_prev - kb * f;
+        Bm = B_prev - kb * D;
+        Fm -= kf * D;
+        f = f_next;
+
+        if (!(g > 0.0f && g <= 1.0f + 1e-3f) || !(Fm > 0.0f) || !(Bm > 0.0f)) {
+            stable = 0;
+            break;
         }
     }
-    
-    memcpy(filter->P, P_new, filter->length * filter->length * sizeof(float));
-    free(P_new);
-    free(k);
-    
-    // Обновляем позицию
-    filter->position = (filter->position + 1) % filter->length;
-    
+
+    // Априорная ошибка alpha = e / gamma, выход - априорная оценка d - alpha
+    float output = desired - e / g;
+    if (!stable || !(g > 0.0f) || !isfinite(output)) {
+        rls_lattice_reset(filter);
+        filter->rescues++;
+        return 0.0f;
+    }
     return output;
-} 
\ No newline at end of file
+}
+
+float rls_filter_process(rls_filter *filter, float input, float desired) {
+    if (filter->mode == RLS_MODE_LATTICE) {
+        return rls_lattice_process(filter, input, desired);
+    }
+    return rls_standard_process(filter, input, desired);
+}
+
+static void rls_filter_run(rls_filter *filter, const float *in, const float *desired,
+                           float *out, int n) {
+    for (int i = 0; i < n; i++) {
+        out[i] = rls_filter_process(filter, in[i], desired[i]);
+    }
+}
+
+void rls_filter_process_block(rls_filter *filter, const float *in, const float *desired,
+                              float *out, int n) {
+    DSP_STATS_BEGIN(probe);
+    rls_filter_run(filter, in, desired, out, n);
+    DSP_STATS_END(probe, DSP_STAGE_RLS, n);
+}
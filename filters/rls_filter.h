@@ -6,19 +6,39 @@
 #include <stdio.h>
 #include <math.h>
 
+typedef enum {
+    RLS_MODE_STANDARD = 0,  // классический RLS, O(N^2) на отсчет
+    RLS_MODE_LATTICE        // рекурсивный LSL с апостериорными ошибками, O(N) на отсчет
+} rls_mode;
+
+// Классический режим работает без выделения памяти на отсчет: вектор P x
+// хранится в структуре, а из симметричной матрицы P хранится и обновляется
+// только верхний треугольник (P x считается по нему же).
+//
+// Решетчатый режим дает ту же апостериорную ошибку, что и RLS порядка length,
+// но явные веса не вычисляет (weights остаются нулевыми). При потере
+// численной устойчивости (gamma вне (0, 1], неположительные энергии,
+// NaN/Inf) состояние решетки переинициализируется, счетчик - rescues.
 typedef struct {
-    float *weights;    // веса фильтра
-    float *buffer;     // буфер входных отсчетов
-    float *P;          // матрица P
+    float *weights;    // веса фильтра (в порядке линии задержки)
+    float *buffer;     // зеркальная линия задержки, 2 * length
+    float *P;          // матрица P (действителен верхний треугольник)
+    float *Px;         // рабочий вектор P * x
     int length;        // длина фильтра
     float lambda;      // фактор забывания
     float delta;       // параметр регуляризации
     int position;      // текущая позиция в буфере
+    rls_mode mode;     // алгоритм
+    float *lattice;    // состояние решетки (RLS_MODE_LATTICE), 7 * length
+    int rescues;       // число переинициализаций решетки
 } rls_filter;
 
 int rls_filter_init(rls_filter *filter, int length, float lambda, float delta);
+int rls_filter_init_mode(rls_filter *filter, int length, float lambda, float delta,
+                         rls_mode mode);
 void rls_filter_free(rls_filter *filter);
 float rls_filter_process(rls_filter *filter, float input, float desired);
+void rls_filter_process_block(rls_filter *filter, const float *in, const float *desired,
+                              float *out, int n);
 
 #endif // RLS_FILTER_H
-
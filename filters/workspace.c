@@ -0,0 +1,51 @@
+#include <stdlib.h>
+#include <string.h>
+#include "workspace.h"
+
+int workspace_init(workspace *ws, size_t size) {
+    if (!ws) {
+        return -1;
+    }
+    memset(ws, 0, sizeof(*ws));
+    if (size == 0) {
+        return -1;
+    }
+    void *base = NULL;
+    if (posix_memalign(&base, WORKSPACE_ALIGN, workspace_align(size)) != 0) {
+        return -2;
+    }
+    ws->base = base;
+    ws->size = workspace_align(size);
+    return 0;
+}
+
+void workspace_free(workspace *ws) {
+    if (ws) {
+        free(ws->base);
+        memset(ws, 0, sizeof(*ws));
+    }
+}
+
+void *workspace_alloc(workspace *ws, size_t bytes) {
+    size_t aligned = workspace_align(bytes);
+    if (aligned > ws->size - ws->used) {
+        return NULL;
+    }
+    void *p = ws->base + ws->used;
+    ws->used += aligned;
+    if (ws->used > ws->peak) {
+        ws->peak = ws->used;
+    }
+    return p;
+}
+
+void *workspace_calloc(workspace *ws, size_t count, size_t size) {
+    if (!ws) {
+        return calloc(count, size);
+    }
+    void *p = workspace_alloc(ws, count * size);
+    if (p) {
+        memset(p, 0, count * size);
+    }
+    return p;
+}
@@ -0,0 +1,57 @@
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <stddef.h>
+
+// Рабочая область (арена): память выделяется один раз при создании, а
+// буферы модулей выдаются из нее сдвигом указателя с выравниванием
+// WORKSPACE_ALIGN (достаточно для загрузок AVX-512 и строки кэша).
+// Освобождение - откат к метке (workspace_mark / workspace_release) или
+// сброс целиком, поэтому обработка в установившемся режиме не обращается
+// к malloc. Размер области задается суммой *_workspace_size модулей,
+// буферы которых живут одновременно.
+//
+// Модули, принимающие workspace в *_init_ws, при ws == NULL выделяют
+// память из кучи как обычный *_init; *_free освобождает только память
+// из кучи, память области возвращается откатом.
+
+#define WORKSPACE_ALIGN 64
+
+typedef struct {
+    unsigned char *base;  // начало области (выровнено)
+    size_t size;
+    size_t used;          // занято от начала
+    size_t peak;          // наибольшее used за время жизни
+} workspace;
+
+// Размер буфера в области с учетом выравнивания
+static inline size_t workspace_align(size_t bytes) {
+    return (bytes + WORKSPACE_ALIGN - 1) / WORKSPACE_ALIGN * WORKSPACE_ALIGN;
+}
+
+// 0 - успех, -1 - неверный размер, -2 - нет памяти
+int workspace_init(workspace *ws, size_t size);
+void workspace_free(workspace *ws);
+
+// Выровненный буфер из области (NULL, если места нет); содержимое не задано
+void *workspace_alloc(workspace *ws, size_t bytes);
+
+// count * size обнуленных байт: из области, а при ws == NULL - calloc
+void *workspace_calloc(workspace *ws, size_t count, size_t size);
+
+static inline size_t workspace_mark(const workspace *ws) {
+    return ws->used;
+}
+
+// Возврат всех буферов, выданных после метки mark
+static inline void workspace_release(workspace *ws, size_t mark) {
+    if (mark < ws->used) {
+        ws->used = mark;
+    }
+}
+
+static inline void workspace_reset(workspace *ws) {
+    ws->used = 0;
+}
+
+#endif // WORKSPACE_H
@@ -4,6 +4,8 @@ from scipy import signal
 from scipy.signal import firwin, lfilter, butter, iirfilter, tf2zpk
 from tqdm import tqdm
 import os
+import struct
+import zlib
 
 # ================== Параметры системы ==================
 fs = 5e9           # Частота дискретизации 5 ГГц
@@ -125,6 +127,12 @@ if not iir_stable:
     print(f"    Стабильность: {'УСТОЙЧИВ' if iir_stable else 'НЕУСТОЙЧИВ'}")
     print(f"    Максимальный модуль полюса: {max_pole:.6f}")
 
+# Каскад биквадратных секций для C-реализации (iir_filter_init_sos)
+sos = butter(order, [f_low, f_high], 
+             btype='bandpass', 
+             fs=fs, 
+             output='sos')
+
 iir_filtered = lfilter(b, a, rx_signal)
 print(f"  Порядок фильтра: {order}")
 print(f"  Задержка: {order*10} отсчетов")
@@ -465,24 +473,20 @@ with open('coeffs.h', 'w') as f:
     f.write(" */\n\n")
     f.write("#ifndef COEFFS_H\n")
     f.write("#define COEFFS_H\n\n")
-    f.write("#include <stdint.h>\n\n")
-    
-    # Определение структуры для комплексных чисел
-    f.write("// Структура для хранения комплексных чисел\n")
-    f.write("typedef struct {\n")
-    f.write("    float real;\n")
-    f.write("    float imag;\n")
-    f.write("} complex_float;\n\n")
+    f.write("#include <stdint.h>\n")
+    # Тип комплексных чисел - общий заголовок, а не определение здесь
+    f.write("#include \"filters/complex_float.h\"\n\n")
     
     # Размеры фильтров
     f.write(f"#define FIR_NUMTAPS {numtaps}\n")
     f.write(f"#define IIR_ORDER {order*2}\n")
+    f.write(f"#define IIR_SECTIONS {sos.shape[0]}\n")
     f.write(f"#define LMS_NTAPS {ntaps}\n")
     f.write(f"#define RLS_NTAPS {ntaps}\n\n")
     
     # FIR коэффициенты
     f.write("// FIR filter coefficients\n")
-    f.write("const float fir_coeff[FIR_NUMTAPS] = {\n")
+    f.write("static const float fir_coeff[FIR_NUMTAPS] = {\n")
     for i in range(numtaps):
         f.write(f"    {fir_coeff[i]:.8f}f")
         if i < numtaps - 1:
@@ -493,7 +497,7 @@ with open('coeffs.h', 'w') as f:
     
     # IIR коэффициенты (b)
     f.write("// IIR filter numerator coefficients (b)\n")
-    f.write("const float iir_b[IIR_ORDER + 1] = {\n")
+    f.write("static const float iir_b[IIR_ORDER + 1] = {\n")
     for i in range(len(b)):
         f.write(f"    {b[i]:.8f}f")
         if i < len(b) - 1:
@@ -504,7 +508,7 @@ with open('coeffs.h', 'w') as f:
     
     # IIR коэффициенты (a)
     f.write("// IIR filter denominator coefficients (a)\n")
-    f.write("const float iir_a[IIR_ORDER + 1] = {\n")
+    f.write("static const float iir_a[IIR_ORDER + 1] = {\n")
     for i in range(len(a)):
         f.write(f"    {a[i]:.8f}f")
         if i < len(a) - 1:
@@ -513,9 +517,20 @@ with open('coeffs.h', 'w') as f:
             f.write("\n")
     f.write("\n};\n\n")
     
+    # IIR коэффициенты в виде секций второго порядка (b0, b1, b2, a0, a1, a2)
+    f.write("// IIR filter second-order sections (b0, b1, b2, a0, a1, a2)\n")
+    f.write("static const float iir_sos[IIR_SECTIONS * 6] = {\n")
+    for i in range(sos.shape[0]):
+        row = ", ".join(f"{v:.10e}f" for v in sos[i])
+        f.write(f"    {row}")
+        if i < sos.shape[0] - 1:
+            f.write(",")
+        f.write("\n")
+    f.write("};\n\n")
+    
     # LMS комплексные коэффициенты
     f.write("// LMS filter complex coefficients\n")
-    f.write("const complex_float lms_weights[LMS_NTAPS] = {\n")
+    f.write("static const complex_float lms_weights[LMS_NTAPS] = {\n")
     for i in range(ntaps):
         real = lms_weights[i].real
         imag = lms_weights[i].imag
@@ -528,7 +543,7 @@ with open('coeffs.h', 'w') as f:
     
     # RLS комплексные коэффициенты
     f.write("// RLS filter complex coefficients\n")
-    f.write("const complex_float rls_weights[RLS_NTAPS] = {\n")
+    f.write("static const complex_float rls_weights[RLS_NTAPS] = {\n")
     for i in range(ntaps):
         real = rls_weights[i].real
         imag = rls_weights[i].imag
@@ -542,8 +557,51 @@ with open('coeffs.h', 'w') as f:
     # Завершение файла
     f.write("#endif // COEFFS_H\n")
 
+# ================== Сохранение коэффициентов в двоичный файл ==================
+# Формат описан в filters/coeff_file.h: заголовок 32 байта, таблица секций
+# по 32 байта, данные float32 с выравниванием 16 байт, CRC-32 по всему, что
+# после заголовка. Файл читается программой при запуске, так что смена
+# коэффициентов не требует пересборки.
+COEFF_FILE_VERSION = 1
+COEFF_REAL, COEFF_COMPLEX = 0, 1
+
+def save_coeff_file(path, sections):
+    header_size, entry_size, align = 32, 32, 16
+    table = b""
+    data = b""
+    offset = header_size + entry_size * len(sections)
+    for name, kind, values in sections:
+        values = np.asarray(values)
+        if kind == COEFF_COMPLEX:
+            flat = np.column_stack([values.real, values.imag]).ravel()
+            count = len(values)
+        else:
+            flat = values.ravel()
+            count = len(flat)
+        pad = (-offset) % align
+        data += b"\0" * pad
+        offset += pad
+        table += struct.pack("<20sIII", name.encode(), kind, count, offset)
+        payload = flat.astype("<f4").tobytes()
+        data += payload
+        offset += len(payload)
+    body = table + data
+    header = struct.pack("<4sIIII12x", b"DSPC", COEFF_FILE_VERSION, len(sections),
+                         header_size + len(body), zlib.crc32(body) & 0xffffffff)
+    with open(path, "wb") as f:
+        f.write(header + body)
+
+save_coeff_file("coeffs.bin", [
+    ("fir", COEFF_REAL, fir_coeff),
+    ("iir_b", COEFF_REAL, b),
+    ("iir_a", COEFF_REAL, a),
+    ("iir_sos", COEFF_REAL, sos),
+    ("lms_weights", COEFF_COMPLEX, lms_weights),
+    ("rls_weights", COEFF_COMPLEX, rls_weights),
+])
+
 print("\n" + "="*50)
-print("Коэффициенты фильтров успешно сохранены в coeffs.h")
+print("Коэффициенты фильтров успешно сохранены в coeffs.h и coeffs.bin")
 print("="*50)
 
 print("\nСкрипт успешно завершен!")
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "pipeline.h"
+#include "ring_buffer.h"
+#include "../signal_generator/signal_generator.h"
+
+typedef struct {
+    const pipeline_config* config;
+    uint64_t* pattern;                      // config->pattern в упакованном виде
+    int chunk;                              // размер блока в отсчетах
+    ring_buffer rings[PIPELINE_STAGES - 1]; // источник->канал->фильтр->демодулятор
+    pipeline_stats stats;
+    atomic_int error;                       // код ошибки любой из стадий
+} pipeline_context;
+
+static void* pipeline_source(void* arg) {
+    pipeline_context* ctx = arg;
+    const pipeline_config* cfg = ctx->config;
+    ring_buffer* out = &ctx->rings[0];
+    int sps = cfg->params.samples_per_sym;
+    int chunk_symbols = ctx->chunk / sps;
+    long long total_symbols = cfg->num_samples / sps;
+    long long bit_pos = 0;
+    qpsk_modulator mod;
+    int ok = qpsk_modulator_init(&mod, &cfg->params) == 0;
+
+    for (long long sym = 0; ok && sym < total_symbols; ) {
+        int symbols = (total_symbols - sym < chunk_symbols) ? (int)(total_symbols - sym)
+                                                            : chunk_symbols;
+        complex_float* slot = ring_buffer_write(out);
+        // Биты берутся прямо из упакованной последовательности, на конце
+        // которой блок делится на части
+        for (int done = 0; done < symbols; ) {
+            int part = symbols - done;
+            if (bit_pos + 2LL * part > cfg->pattern_bits) {
+                part = (int)((cfg->pattern_bits - bit_pos) / 2);
+            }
+            qpsk_modulator_process_packed(&mod, ctx->pattern, bit_pos, 2 * part,
+                                          &slot[(size_t)done * sps]);
+            bit_pos += 2LL * part;
+            if (bit_pos == cfg->pattern_bits) bit_pos = 0;
+            done += part;
+        }
+        ring_buffer_commit(out, (size_t)symbols * sps * sizeof(complex_float));
+        sym += symbols;
+    }
+    if (ok) {
+        qpsk_modulator_free(&mod);
+    } else {
+        atomic_store(&ctx->error, -2);
+    }
+
+    ring_buffer_close(out);
+    return NULL;
+}
+
+static void* pipeline_channel(void* arg) {
+    pipeline_context* ctx = arg;
+    const pipeline_config* cfg = ctx->config;
+    ring_buffer* in = &ctx->rings[0];
+    ring_buffer* out = &ctx->rings[1];
+    oscillator interference;
+    rng_state rng;
+    const complex_float* src;
+    size_t used;
+
+    rng_init(&rng, cfg->seed);
+    int ok = oscillator_init(&interference, cfg->interference_freq, cfg->params.fs) == 0;
+    if (!ok) {
+        atomic_store(&ctx->error, -1);
+    }
+    while ((src = ring_buffer_read(in, &used))) {
+        complex_float* dst = ring_buffer_write(out);
+        int n = (int)(used / sizeof(complex_float));
+        memcpy(dst, src, used);
+        ring_buffer_release(in);
+        if (ok) {
+            add_noise_and_interference_block(dst, n, cfg->noise_power, cfg->interference_power,
+                                             &interference, &rng);
+        }
+        ring_buffer_commit(out, used);
+    }
+
+    ring_buffer_close(out);
+    return NULL;
+}
+
+static void* pipeline_filter(void* arg) {
+    pipeline_context* ctx = arg;
+    const pipeline_config* cfg = ctx->config;
+    ring_buffer* in = &ctx->rings[1];
+    ring_buffer* out = &ctx->rings[2];
+    const complex_float* src;
+    size_t used;
+
+    while ((src = ring_buffer_read(in, &used))) {
+        complex_float* dst = ring_buffer_write(out);
+        int n = (int)(used / sizeof(complex_float));
+        if (cfg->filter) {
+            cfg->filter(cfg->filter_state, src, dst, n);
+        } else {
+            memcpy(dst, src, used);
+        }
+        ring_buffer_release(in);
+        ring_buffer_commit(out, used);
+        ctx->stats.samples += n;
+    }
+
+    ring_buffer_close(out);
+    return NULL;
+}
+
+// Сравнение решений демодулятора с передаваемой последовательностью
+static void pipeline_count_errors(pipeline_context* ctx, const uint64_t* bits, int num_bits,
+                                  long long* bit_pos) {
+    const pipeline_config* cfg = ctx->config;
+    for (int done = 0; done < num_bits; ) {
+        int part = num_bits - done;
+        if (*bit_pos + part > cfg->pattern_bits) {
+            part = (int)(cfg->pattern_bits - *bit_pos);
+        }
+        ctx->stats.bit_errors += packed_count_errors(bits, done, ctx->pattern, *bit_pos, part);
+        *bit_pos += part;
+        if (*bit_pos == cfg->pattern_bits) *bit_pos = 0;
+        done += part;
+    }
+    ctx->stats.bits += num_bits;
+}
+
+// Потоковый демодулятор сохраняет фазу генератора и пропуск задержки
+// фильтра между блоками, поэтому блоки не нужно выравнивать по символам
+static void* pipeline_demod(void* arg) {
+    pipeline_context* ctx = arg;
+    const pipeline_config* cfg = ctx->config;
+    ring_buffer* in = &ctx->rings[2];
+    int max_symbols = ctx->chunk / cfg->params.samples_per_sym + 1;
+    if (max_symbols < QPSK_DEMOD_FLUSH_MAX) max_symbols = QPSK_DEMOD_FLUSH_MAX;
+    uint64_t* bits = malloc(packed_words(2LL * max_symbols) * sizeof(uint64_t));
+    complex_float* constellation = malloc(max_symbols * sizeof(complex_float));
+    qpsk_demodulator dem;
+    long long bit_pos = 0;
+    const complex_float* src;
+    size_t used;
+
+    int ok = bits && constellation &&
+             qpsk_demodulator_init(&dem, &cfg->params, cfg->filter_delay) == 0;
+    if (!ok) {
+        atomic_store(&ctx->error, -2);
+    }
+    while ((src = ring_buffer_read(in, &used))) {
+        if (ok) {
+            int symbols = qpsk_demodulator_push_packed(&dem, src,
+                                                       (int)(used / sizeof(complex_float)),
+                                                       bits, 0, constellation);
+            pipeline_count_errors(ctx, bits, 2 * symbols, &bit_pos);
+        }
+        ring_buffer_release(in);
+    }
+    if (ok) {
+        int symbols = qpsk_demodulator_flush_packed(&dem, bits, 0, constellation);
+        pipeline_count_errors(ctx, bits, 2 * symbols, &bit_pos);
+        qpsk_demodulator_free(&dem);
+    }
+
+    free(bits);
+    free(constellation);
+    return NULL;
+}
+
+int pipeline_run(const pipeline_config* config, pipeline_stats* stats) {
+    if (!config || !stats || !config->pattern || config->pattern_bits < 2 ||
+        config->pattern_bits % 2 != 0 || config->params.samples_per_sym <= 0 ||
+        config->chunk_samples < config->params.samples_per_sym || config->num_samples <= 0) {
+        return -1;
+    }
+
+    pipeline_context ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.config = config;
+    ctx.pattern = malloc(packed_words(config->pattern_bits) * sizeof(uint64_t));
+    if (!ctx.pattern) {
+        return -2;
+    }
+    packed_pack(config->pattern, config->pattern_bits, ctx.pattern);
+    ctx.chunk = config->chunk_samples / config->params.samples_per_sym *
+                config->params.samples_per_sym;
+
+    int status = 0;
+    int rings = 0;
+    for (; rings < PIPELINE_STAGES - 1; rings++) {
+        status = ring_buffer_init(&ctx.rings[rings], config->ring_slots,
+                                  ctx.chunk * sizeof(complex_float));
+        if (status != 0) break;
+    }
+
+    void* (*stages[PIPELINE_STAGES])(void*) = {
+        pipeline_source, pipeline_channel, pipeline_filter, pipeline_demod
+    };
+    pthread_t threads[PIPELINE_STAGES];
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    // Стадии запускаются с конца: если поток не создался, достаточно закрыть
+    // выход несозданной стадии, и уже работающие потребители завершатся
+    int first = PIPELINE_STAGES;
+    while (status == 0 && first > 0) {
+        if (pthread_create(&threads[first - 1], NULL, stages[first - 1], &ctx) != 0) {
+            status = -3;
+            if (first - 1 < PIPELINE_STAGES - 1) {
+                ring_buffer_close(&ctx.rings[first - 1]);
+            }
+            break;
+        }
+        first--;
+    }
+    for (int i = first; i < PIPELINE_STAGES; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ctx.stats.seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+    for (int i = 0; i < rings; i++) {
+        ctx.stats.stalls[i] += ctx.rings[i].write_stalls;
+        ctx.stats.stalls[i + 1] += ctx.rings[i].read_stalls;
+        ring_buffer_free(&ctx.rings[i]);
+    }
+
+    free(ctx.pattern);
+    *stats = ctx.stats;
+    if (status == 0) {
+        status = atomic_load(&ctx.error);
+    }
+    return status;
+}
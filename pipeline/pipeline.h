@@ -0,0 +1,46 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdint.h>
+#include "../qpsk/qpsk_modem.h"
+
+// Потоковый конвейер: источник (qpsk_modulator) -> канал
+// (add_noise_and_interference_block) -> фильтр -> демодулятор.
+// Каждая стадия работает в своем потоке, стадии обмениваются блоками по
+// chunk_samples отсчетов через кольцевые буферы SPSC. Полный буфер
+// останавливает предыдущую стадию (противодавление), поэтому память
+// ограничена (число стадий - 1) * ring_slots блоками при любой длине потока.
+#define PIPELINE_STAGES 4
+
+// Фильтр стадии обработки: n отсчетов из in в out, состояние в state
+typedef void (*pipeline_filter_fn)(void* state, const complex_float* in,
+                                   complex_float* out, int n);
+
+typedef struct {
+    qpsk_params params;
+    const uint8_t* pattern;     // циклически передаваемая битовая последовательность
+    int pattern_bits;           // ее длина (четная)
+    long long num_samples;      // длина потока (округляется вниз до целых символов)
+    int chunk_samples;          // размер блока (округляется вниз до целых символов)
+    int ring_slots;             // слотов в каждом кольцевом буфере (степень двойки)
+    float noise_power;
+    uint64_t seed;              // seed генератора шума канала
+    float interference_freq;
+    float interference_power;
+    pipeline_filter_fn filter;  // NULL - стадия фильтра передает блоки без изменений
+    void* filter_state;
+    int filter_delay;           // задержка фильтра в отсчетах
+} pipeline_config;
+
+typedef struct {
+    long long samples;                   // отсчетов прошло через фильтр
+    long long bits;                      // демодулировано бит
+    long long bit_errors;                // ошибок относительно pattern
+    double seconds;                      // время работы конвейера
+    long long stalls[PIPELINE_STAGES];   // ожидания стадий на полных/пустых буферах
+} pipeline_stats;
+
+// Запуск конвейера до конца потока; возвращает 0 или отрицательный код ошибки
+int pipeline_run(const pipeline_config* config, pipeline_stats* stats);
+
+#endif // PIPELINE_H
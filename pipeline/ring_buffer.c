@@ -0,0 +1,104 @@
+#include <stdlib.h>
+#include <sched.h>
+#include "ring_buffer.h"
+
+// Число пустых проверок перед уступкой процессора
+#define RING_BUFFER_SPIN 64
+
+int ring_buffer_init(ring_buffer* rb, size_t slots, size_t slot_size) {
+    if (!rb || slots < 2 || (slots & (slots - 1)) != 0 || slot_size == 0) {
+        return -1;
+    }
+
+    rb->data = malloc(slots * slot_size);
+    rb->used = calloc(slots, sizeof(size_t));
+    if (!rb->data || !rb->used) {
+        free(rb->data);
+        free(rb->used);
+        rb->data = NULL;
+        rb->used = NULL;
+        return -2;
+    }
+    rb->slot_size = slot_size;
+    rb->mask = slots - 1;
+    atomic_init(&rb->head, 0);
+    atomic_init(&rb->tail, 0);
+    atomic_init(&rb->closed, 0);
+    rb->write_stalls = 0;
+    rb->read_stalls = 0;
+    return 0;
+}
+
+void ring_buffer_free(ring_buffer* rb) {
+    if (rb) {
+        free(rb->data);
+        free(rb->used);
+        rb->data = NULL;
+        rb->used = NULL;
+    }
+}
+
+void* ring_buffer_try_write(ring_buffer* rb) {
+    size_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&rb->tail, memory_order_acquire);
+    if (head - tail > rb->mask) {
+        return NULL;
+    }
+    return rb->data + (head & rb->mask) * rb->slot_size;
+}
+
+void ring_buffer_commit(ring_buffer* rb, size_t used) {
+    size_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+    rb->used[head & rb->mask] = used;
+    atomic_store_explicit(&rb->head, head + 1, memory_order_release);
+}
+
+const void* ring_buffer_try_read(ring_buffer* rb, size_t* used) {
+    size_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&rb->head, memory_order_acquire);
+    if (head == tail) {
+        return NULL;
+    }
+    *used = rb->used[tail & rb->mask];
+    return rb->data + (tail & rb->mask) * rb->slot_size;
+}
+
+void ring_buffer_release(ring_buffer* rb) {
+    size_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+    atomic_store_explicit(&rb->tail, tail + 1, memory_order_release);
+}
+
+void* ring_buffer_write(ring_buffer* rb) {
+    void* slot;
+    for (int spin = 0; !(slot = ring_buffer_try_write(rb)); spin++) {
+        if (spin == 0) {
+            rb->write_stalls++;
+        }
+        if (spin >= RING_BUFFER_SPIN) {
+            sched_yield();
+        }
+    }
+    return slot;
+}
+
+const void* ring_buffer_read(ring_buffer* rb, size_t* used) {
+    const void* slot;
+    for (int spin = 0; !(slot = ring_buffer_try_read(rb, used)); spin++) {
+        // closed публикуется после последнего commit: если поток закрыт,
+        // повторная проверка увидит все слоты
+        if (atomic_load_explicit(&rb->closed, memory_order_acquire)) {
+            return ring_buffer_try_read(rb, used);
+        }
+        if (spin == 0) {
+            rb->read_stalls++;
+        }
+        if (spin >= RING_BUFFER_SPIN) {
+            sched_yield();
+        }
+    }
+    return slot;
+}
+
+void ring_buffer_close(ring_buffer* rb) {
+    atomic_store_explicit(&rb->closed, 1, memory_order_release);
+}
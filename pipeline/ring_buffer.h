@@ -0,0 +1,47 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+// Кольцевой буфер из фиксированных слотов для одного производителя и одного
+// потребителя (SPSC) без блокировок. Производитель заполняет слот на месте
+// и публикует его, потребитель читает слот на месте и освобождает, поэтому
+// данные между стадиями не копируются. Поля производителя и потребителя
+// разнесены по разным строкам кэша, чтобы потоки не делили одну строку.
+#define RING_BUFFER_CACHE_LINE 64
+
+typedef struct {
+    unsigned char* data;     // slots * slot_size байт
+    size_t* used;            // заполнено байт в каждом слоте
+    size_t slot_size;        // размер слота в байтах
+    size_t mask;             // slots - 1 (число слотов - степень двойки)
+    // Поля производителя
+    _Alignas(RING_BUFFER_CACHE_LINE) atomic_size_t head;   // следующий слот записи
+    atomic_int closed;       // производитель завершил поток
+    long long write_stalls;  // ожидания свободного слота (противодавление)
+    // Поля потребителя
+    _Alignas(RING_BUFFER_CACHE_LINE) atomic_size_t tail;   // следующий слот чтения
+    long long read_stalls;   // ожидания данных
+} ring_buffer;
+
+int ring_buffer_init(ring_buffer* rb, size_t slots, size_t slot_size);
+void ring_buffer_free(ring_buffer* rb);
+
+// Неблокирующий доступ: NULL, если буфер полон (пуст)
+void* ring_buffer_try_write(ring_buffer* rb);
+const void* ring_buffer_try_read(ring_buffer* rb, size_t* used);
+
+// Публикация заполненного слота (used байт) и освобождение прочитанного
+void ring_buffer_commit(ring_buffer* rb, size_t used);
+void ring_buffer_release(ring_buffer* rb);
+
+// Блокирующий доступ с ожиданием (активное, затем sched_yield).
+// ring_buffer_read возвращает NULL только после close и опустошения буфера.
+void* ring_buffer_write(ring_buffer* rb);
+const void* ring_buffer_read(ring_buffer* rb, size_t* used);
+
+// Конец потока: вызывается производителем после последнего commit
+void ring_buffer_close(ring_buffer* rb);
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,142 @@
+#include <stdlib.h>
+#include <string.h>
+#include "stage_chain.h"
+#include "../filters/ciir_filter.h"
+#include "../filters/cfir_filter.h"
+
+// Параметры сигнала на входе демодулятора (после DDC - пониженная частота)
+static int stage_chain_demod_params(const stage_chain_config* config, qpsk_params* params) {
+    if (config->ddc) {
+        if (ddc_filter_demod_params(config->ddc, &config->params, params) != 0) {
+            return -1;
+        }
+    } else {
+        *params = config->params;
+    }
+    return params->samples_per_sym > 0 ? 0 : -1;
+}
+
+// Символов в тайле: n / sps отсчетов и незавершенный символ
+static size_t stage_chain_symbols(int tile, const qpsk_params* params) {
+    return (size_t)tile / params->samples_per_sym + 2;
+}
+
+size_t stage_chain_workspace_size(const stage_chain_config* config) {
+    qpsk_params params;
+    if (!config || config->tile <= 0 || stage_chain_demod_params(config, &params) != 0) {
+        return 0;
+    }
+    return 2 * workspace_align((size_t)config->tile * sizeof(complex_float)) +
+           workspace_align(stage_chain_symbols(config->tile, &params) * sizeof(complex_float)) +
+           qpsk_demodulator_workspace_size(&params);
+}
+
+int stage_chain_init(stage_chain* chain, const stage_chain_config* config) {
+    return stage_chain_init_ws(chain, config, NULL);
+}
+
+int stage_chain_init_ws(stage_chain* chain, const stage_chain_config* config, workspace* ws) {
+    if (!chain || !config || config->tile <= 0 || config->num_filters < 0 ||
+        config->num_filters > STAGE_CHAIN_MAX_FILTERS) {
+        return -1;
+    }
+    memset(chain, 0, sizeof(*chain));
+    for (int k = 0; k < config->num_filters; k++) {
+        if (!config->filters[k]) {
+            return -1;
+        }
+    }
+    qpsk_params params;
+    if (stage_chain_demod_params(config, &params) != 0) {
+        return -1;
+    }
+    chain->config = *config;
+
+    int status = qpsk_demodulator_init_ws(&chain->demod, &params, config->delay, ws);
+    if (status != 0) {
+        return status;
+    }
+    chain->external = (ws != NULL);
+    chain->buffers[0] = workspace_calloc(ws, config->tile, sizeof(complex_float));
+    chain->buffers[1] = workspace_calloc(ws, config->tile, sizeof(complex_float));
+    chain->constellation = workspace_calloc(ws, stage_chain_symbols(config->tile, &params),
+                                            sizeof(complex_float));
+    if (!chain->buffers[0] || !chain->buffers[1] || !chain->constellation) {
+        stage_chain_free(chain);
+        return -2;
+    }
+    return 0;
+}
+
+void stage_chain_free(stage_chain* chain) {
+    if (!chain->external) {
+        free(chain->buffers[0]);
+        free(chain->buffers[1]);
+        free(chain->constellation);
+    }
+    chain->buffers[0] = NULL;
+    chain->buffers[1] = NULL;
+    chain->constellation = NULL;
+    qpsk_demodulator_free(&chain->demod);
+}
+
+int stage_chain_process(stage_chain* chain, const complex_float* in, int n, uint8_t* bits) {
+    const stage_chain_config* config = &chain->config;
+    int symbols = 0;
+
+    for (int offset = 0; offset < n; offset += config->tile) {
+        int m = (n - offset < config->tile) ? n - offset : config->tile;
+        // Каждая стадия пишет в свободный буфер тайла и читает из занятого
+        const complex_float* src = &in[offset];
+        int next = 0;
+        for (int k = 0; k < config->num_filters; k++) {
+            config->filters[k](config->filter_states[k], src, chain->buffers[next], m);
+            src = chain->buffers[next];
+            next ^= 1;
+        }
+        if (config->ddc) {
+            m = ddc_filter_process_block(config->ddc, src, m, chain->buffers[next]);
+            src = chain->buffers[next];
+        }
+        symbols += qpsk_demodulator_push(&chain->demod, src, m, &bits[2 * symbols],
+                                         chain->constellation);
+    }
+    return symbols;
+}
+
+int stage_chain_flush(stage_chain* chain, uint8_t* bits) {
+    return qpsk_demodulator_flush(&chain->demod, bits, chain->constellation);
+}
+
+void stage_chain_ciir(void* state, const complex_float* in, complex_float* out, int n) {
+    ciir_filter_process_block((ciir_filter*)state, in, out, n);
+}
+
+void stage_chain_cfir(void* state, const complex_float* in, complex_float* out, int n) {
+    cfir_filter_process_block((cfir_filter*)state, in, out, n);
+}
+
+void stage_chain_fir(void* state, const complex_float* in, complex_float* out, int n) {
+    stage_chain_fir_pair* pair = state;
+    float in_i[STAGE_CHAIN_SPLIT], in_q[STAGE_CHAIN_SPLIT];
+    float out_i[STAGE_CHAIN_SPLIT], out_q[STAGE_CHAIN_SPLIT];
+    for (int offset = 0; offset < n; offset += STAGE_CHAIN_SPLIT) {
+        int m = (n - offset < STAGE_CHAIN_SPLIT) ? n - offset : STAGE_CHAIN_SPLIT;
+        for (int i = 0; i < m; i++) {
+            in_i[i] = in[offset + i].real;
+            in_q[i] = in[offset + i].imag;
+        }
+        fft_fir_filter_process_block(pair->i, in_i, out_i, m);
+        fft_fir_filter_process_block(pair->q, in_q, out_q, m);
+        for (int i = 0; i < m; i++) {
+            out[offset + i].real = out_i[i];
+            out[offset + i].imag = out_q[i];
+        }
+    }
+}
+
+void stage_chain_clms(void* state, const complex_float* in, complex_float* out, int n) {
+    stage_chain_lms* lms = state;
+    clms_filter_process_block(lms->filter, in, &lms->desired[lms->position], out, n);
+    lms->position += n;
+}
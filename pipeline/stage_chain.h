@@ -0,0 +1,81 @@
+#ifndef STAGE_CHAIN_H
+#define STAGE_CHAIN_H
+
+#include <stdint.h>
+#include "pipeline.h"
+#include "../filters/ddc_filter.h"
+#include "../filters/fft_fir_filter.h"
+#include "../filters/clms_filter.h"
+
+// Цепочка стадий в одном потоке: фильтры -> DDC (перенос, ФНЧ, децимация)
+// -> демодулятор (перенос в базовую полосу, согласованный фильтр, решения).
+// Вход проходит всю цепочку тайлами по tile отсчетов: промежуточные
+// результаты живут в двух буферах размера тайла, которые остаются в кэше,
+// вместо полноразмерного массива на выходе каждой стадии. Стадии и DDC
+// принадлежат вызывающему (как filter_state конвейера) и хранят свое
+// состояние между тайлами, поэтому результат не зависит от размера тайла.
+// Выигрыш по времени заметен, только когда полноразмерный промежуточный
+// массив не помещается в последний уровень кэша: при 16 МБ на процессоре с
+// L3 105 МБ цепочка идет вровень с буфером на стадию (0.97-1.09 по
+// run_chain_benchmark).
+// Фильтры на БПФ (fft_fir_filter) без буферизации считают БПФ на каждый
+// вызов, даже если блок заполнен не до конца, поэтому в цепочке их стоит
+// переводить в режим fft_fir_filter_set_buffered и добавлять
+// fft_fir_filter_latency к задержке демодулятора.
+#define STAGE_CHAIN_MAX_FILTERS 4
+#define STAGE_CHAIN_DEFAULT_TILE 2048  // 2 x 16 КБ буферов: в L1/L2
+#define STAGE_CHAIN_SPLIT 2048         // участок разделения на I и Q (стек)
+
+typedef struct {
+    qpsk_params params;         // параметры сигнала на входе цепочки
+    int tile;                   // отсчетов входа на тайл
+    int num_filters;
+    pipeline_filter_fn filters[STAGE_CHAIN_MAX_FILTERS];
+    void* filter_states[STAGE_CHAIN_MAX_FILTERS];
+    ddc_filter* ddc;            // NULL - без децимации
+    int delay;                  // задержка в отсчетах на входе демодулятора
+} stage_chain_config;
+
+typedef struct {
+    stage_chain_config config;
+    qpsk_demodulator demod;
+    complex_float* buffers[2];  // тайлы между стадиями
+    complex_float* constellation;
+    int external;               // буферы в рабочей области
+} stage_chain;
+
+// 0 - успех; -1 - неверные параметры, -2 - нет памяти
+int stage_chain_init(stage_chain* chain, const stage_chain_config* config);
+int stage_chain_init_ws(stage_chain* chain, const stage_chain_config* config, workspace* ws);
+size_t stage_chain_workspace_size(const stage_chain_config* config);
+void stage_chain_free(stage_chain* chain);
+
+// n отсчетов входа через всю цепочку; биты готовых символов записываются в
+// bits (по 2 на символ), возвращается число символов. Буфер должен
+// вмещать n / samples_per_sym + 2 символов.
+int stage_chain_process(stage_chain* chain, const complex_float* in, int n, uint8_t* bits);
+
+// Завершение потока (qpsk_demodulator_flush)
+int stage_chain_flush(stage_chain* chain, uint8_t* bits);
+
+// Готовые стадии: state - ciir_filter / cfir_filter
+void stage_chain_ciir(void* state, const complex_float* in, complex_float* out, int n);
+void stage_chain_cfir(void* state, const complex_float* in, complex_float* out, int n);
+
+// Вещественный FIR (fft_fir_filter) по составляющим I и Q
+typedef struct {
+    fft_fir_filter* i;
+    fft_fir_filter* q;
+} stage_chain_fir_pair;
+void stage_chain_fir(void* state, const complex_float* in, complex_float* out, int n);
+
+// LMS с опорным сигналом: desired читается с позиции position, которая
+// сдвигается на n за вызов
+typedef struct {
+    clms_filter* filter;
+    const complex_float* desired;
+    long long position;
+} stage_chain_lms;
+void stage_chain_clms(void* state, const complex_float* in, complex_float* out, int n);
+
+#endif // STAGE_CHAIN_H
@@ -0,0 +1,55 @@
+import sys
+import csv
+import json
+import math
+import matplotlib.pyplot as plt
+
+# ================== Чтение результатов dsp_benchmark sweep ==================
+def load_points(path):
+    """Точки кривых BER из CSV или JSON, сгруппированные по фильтру"""
+    if path.endswith('.json'):
+        with open(path) as f:
+            rows = json.load(f)['points']
+    else:
+        with open(path, newline='') as f:
+            rows = list(csv.DictReader(f))
+
+    curves = {}
+    for row in rows:
+        curve = curves.setdefault(row['filter'], {'ebn0': [], 'ber': [], 'low': [], 'high': []})
+        curve['ebn0'].append(float(row['ebn0_db']))
+        curve['ber'].append(float(row['ber']))
+        curve['low'].append(float(row['ci_low']))
+        curve['high'].append(float(row['ci_high']))
+    return curves
+
+path = sys.argv[1] if len(sys.argv) > 1 else 'ber_sweep.csv'
+output = sys.argv[2] if len(sys.argv) > 2 else 'ber_curves.png'
+curves = load_points(path)
+
+# ================== Кривые BER(Eb/N0) ==================
+plt.figure(figsize=(10, 7))
+ebn0_max = 0.0
+for name, curve in curves.items():
+    # Точки без ошибок на логарифмической шкале не отображаются
+    points = [(e, b, l, h) for e, b, l, h in zip(curve['ebn0'], curve['ber'], curve['low'], curve['high']) if b > 0]
+    if not points:
+        continue
+    ebn0, ber, low, high = zip(*points)
+    errors = [[b - l for b, l in zip(ber, low)], [h - b for b, h in zip(ber, high)]]
+    plt.errorbar(ebn0, ber, yerr=errors, marker='o', capsize=3, label=name.upper())
+    ebn0_max = max(ebn0_max, max(curve['ebn0']))
+
+# Теоретическая BER QPSK в АБГШ
+theory_x = [x / 10 for x in range(0, int(ebn0_max * 10) + 1)]
+theory_y = [0.5 * math.erfc(math.sqrt(10 ** (x / 10))) for x in theory_x]
+plt.semilogy(theory_x, theory_y, 'k--', label='QPSK, теория')
+
+plt.title('Зависимость BER от Eb/N0')
+plt.xlabel('Eb/N0, дБ')
+plt.ylabel('BER')
+plt.grid(True, which='both', alpha=0.3)
+plt.legend()
+plt.tight_layout()
+plt.savefig(output)
+print(f"График сохранен в {output}")
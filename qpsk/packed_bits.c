@@ -0,0 +1,56 @@
+#include "packed_bits.h"
+
+void packed_pack(const uint8_t* bits, long long num_bits, uint64_t* words) {
+    for (long long i = 0; i < num_bits; i += PACKED_WORD_BITS) {
+        int m = (num_bits - i < PACKED_WORD_BITS) ? (int)(num_bits - i) : PACKED_WORD_BITS;
+        uint64_t word = 0;
+        for (int b = 0; b < m; b++) {
+            word |= (uint64_t)(bits[i + b] & 1) << b;
+        }
+        words[i / PACKED_WORD_BITS] = word;
+    }
+}
+
+void packed_unpack(const uint64_t* words, long long num_bits, uint8_t* bits) {
+    for (long long i = 0; i < num_bits; i += PACKED_WORD_BITS) {
+        int m = (num_bits - i < PACKED_WORD_BITS) ? (int)(num_bits - i) : PACKED_WORD_BITS;
+        uint64_t word = words[i / PACKED_WORD_BITS];
+        for (int b = 0; b < m; b++) {
+            bits[i + b] = (word >> b) & 1;
+        }
+    }
+}
+
+// len (1..64) бит с позиции pos; следующее слово читается, только если
+// окно на него заходит
+static inline uint64_t packed_window(const uint64_t* words, long long pos, int len) {
+    const uint64_t* w = &words[pos / PACKED_WORD_BITS];
+    int shift = (int)(pos % PACKED_WORD_BITS);
+    uint64_t v = w[0] >> shift;
+    if (shift != 0 && shift + len > PACKED_WORD_BITS) {
+        v |= w[1] << (PACKED_WORD_BITS - shift);
+    }
+    return len < PACKED_WORD_BITS ? v & (((uint64_t)1 << len) - 1) : v;
+}
+
+long long packed_count_errors(const uint64_t* a, long long a_pos,
+                              const uint64_t* b, long long b_pos, long long num_bits) {
+    long long errors = 0;
+    long long i = 0;
+    // Обе последовательности выровнены по словам: сравнение целыми словами
+    if (a_pos % PACKED_WORD_BITS == 0 && b_pos % PACKED_WORD_BITS == 0) {
+        const uint64_t* wa = &a[a_pos / PACKED_WORD_BITS];
+        const uint64_t* wb = &b[b_pos / PACKED_WORD_BITS];
+        long long full = num_bits / PACKED_WORD_BITS;
+        for (long long k = 0; k < full; k++) {
+            errors += __builtin_popcountll(wa[k] ^ wb[k]);
+        }
+        i = full * PACKED_WORD_BITS;
+    }
+    for (; i < num_bits; i += PACKED_WORD_BITS) {
+        int len = (num_bits - i < PACKED_WORD_BITS) ? (int)(num_bits - i) : PACKED_WORD_BITS;
+        errors += __builtin_popcountll(packed_window(a, a_pos + i, len) ^
+                                       packed_window(b, b_pos + i, len));
+    }
+    return errors;
+}
@@ -0,0 +1,42 @@
+#ifndef PACKED_BITS_H
+#define PACKED_BITS_H
+
+#include <stdint.h>
+
+// Упакованная битовая последовательность: бит k хранится в words[k / 64],
+// разряд k % 64 (первый бит - младший разряд). Порядок совпадает с
+// rng_bits, поэтому rng_bits_packed и rng_bits из одного состояния дают
+// одни и те же биты. Неиспользуемые разряды последнего слова - нули.
+// Биты символа QPSK занимают разряды 2k и 2k + 1 одного слова.
+
+#define PACKED_WORD_BITS 64
+
+static inline long long packed_words(long long num_bits) {
+    return (num_bits + PACKED_WORD_BITS - 1) / PACKED_WORD_BITS;
+}
+
+static inline int packed_get(const uint64_t* words, long long k) {
+    return (int)((words[k / PACKED_WORD_BITS] >> (k % PACKED_WORD_BITS)) & 1);
+}
+
+// Два бита с четной позиции k (оба в одном слове), младший - первый
+static inline unsigned packed_get2(const uint64_t* words, long long k) {
+    return (unsigned)((words[k / PACKED_WORD_BITS] >> (k % PACKED_WORD_BITS)) & 3);
+}
+
+static inline void packed_set2(uint64_t* words, long long k, unsigned pair) {
+    int shift = (int)(k % PACKED_WORD_BITS);
+    uint64_t* w = &words[k / PACKED_WORD_BITS];
+    *w = (*w & ~((uint64_t)3 << shift)) | ((uint64_t)pair << shift);
+}
+
+// Перевод из побайтового представления (0/1 в байте) и обратно
+void packed_pack(const uint8_t* bits, long long num_bits, uint64_t* words);
+void packed_unpack(const uint64_t* words, long long num_bits, uint8_t* bits);
+
+// Число несовпадающих бит между num_bits битами a с позиции a_pos и b с
+// позиции b_pos: XOR слов и popcount, хвост отсекается маской
+long long packed_count_errors(const uint64_t* a, long long a_pos,
+                              const uint64_t* b, long long b_pos, long long num_bits);
+
+#endif // PACKED_BITS_H
@@ -0,0 +1,79 @@
+#include "qpsk_demapper.h"
+#include "packed_bits.h"
+#include "../filters/dsp_stats.h"
+#include "../filters/dsp_dispatch.h"
+
+// Слово решений - 32 символа (ядро demap_word активной таблицы)
+#define QPSK_DEMAPPER_WORD_SYMBOLS (PACKED_WORD_BITS / 2)
+
+void qpsk_demapper_hard(const complex_float* symbols, int n, uint8_t* bits) {
+    DSP_STATS_BEGIN(probe);
+    uint64_t (*demap_word)(const complex_float*) = dsp_dispatch()->demap_word;
+    int i = 0;
+    for (; i + QPSK_DEMAPPER_WORD_SYMBOLS <= n; i += QPSK_DEMAPPER_WORD_SYMBOLS) {
+        uint64_t word = demap_word(&symbols[i]);
+        for (int b = 0; b < PACKED_WORD_BITS; b++) {
+            bits[2 * i + b] = (word >> b) & 1;
+        }
+    }
+    for (; i < n; i++) {
+        unsigned pair = qpsk_demapper_pair(symbols[i]);
+        bits[2 * i] = pair & 1;
+        bits[2 * i + 1] = pair >> 1;
+    }
+    DSP_STATS_END(probe, DSP_STAGE_SLICE, n);
+}
+
+void qpsk_demapper_hard_packed(const complex_float* symbols, int n, uint64_t* words,
+                               long long first_bit) {
+    DSP_STATS_BEGIN(probe);
+    uint64_t (*demap_word)(const complex_float*) = dsp_dispatch()->demap_word;
+    int i = 0;
+    // До границы слова - по полю, далее целыми словами
+    for (; i < n && (first_bit + 2LL * i) % PACKED_WORD_BITS != 0; i++) {
+        packed_set2(words, first_bit + 2LL * i, qpsk_demapper_pair(symbols[i]));
+    }
+    for (; i + QPSK_DEMAPPER_WORD_SYMBOLS <= n; i += QPSK_DEMAPPER_WORD_SYMBOLS) {
+        words[(first_bit + 2LL * i) / PACKED_WORD_BITS] = demap_word(&symbols[i]);
+    }
+    for (; i < n; i++) {
+        packed_set2(words, first_bit + 2LL * i, qpsk_demapper_pair(symbols[i]));
+    }
+    DSP_STATS_END(probe, DSP_STAGE_SLICE, n);
+}
+
+int qpsk_demapper_estimate(const complex_float* symbols, int n, qpsk_channel_estimate* est) {
+    if (n <= 0 || !est) {
+        return -1;
+    }
+    double m2 = 0.0, m4 = 0.0;
+    for (int i = 0; i < n; i++) {
+        double p = (double)symbols[i].real * symbols[i].real +
+                   (double)symbols[i].imag * symbols[i].imag;
+        m2 += p;
+        m4 += p * p;
+    }
+    m2 /= n;
+    m4 /= n;
+
+    double d = 2.0 * m2 * m2 - m4;
+    double signal = d > 0.0 ? sqrt(d) : 0.0;
+    if (signal > m2) {
+        signal = m2;
+    }
+    double noise = m2 - signal;
+    if (noise < QPSK_DEMAPPER_MIN_NOISE * m2) {
+        noise = QPSK_DEMAPPER_MIN_NOISE * m2;
+    }
+    est->amplitude = (float)sqrt(signal / 2.0);
+    est->noise_var = (float)noise;
+    return 0;
+}
+
+void qpsk_demapper_llr(const complex_float* symbols, int n, const qpsk_channel_estimate* est,
+                       float* llr) {
+    DSP_STATS_BEGIN(probe);
+    float scale = 4.0f * est->amplitude / est->noise_var;
+    dsp_dispatch()->demap_llr(symbols, n, scale, llr);
+    DSP_STATS_END(probe, DSP_STAGE_SLICE, n);
+}
@@ -0,0 +1,52 @@
+#ifndef QPSK_DEMAPPER_H
+#define QPSK_DEMAPPER_H
+
+#include <stdint.h>
+#include <math.h>
+#include "../filters/complex_float.h"
+
+// Демаппер QPSK с кодом Грея (таблица qpsk_symbols в qpsk_modem.c):
+// первый бит символа задает знак Q, второй - знак I, значение бита 1 -
+// отрицательная составляющая. Поэтому жесткое решение - проверка знаковых
+// разрядов без atan2f, а мягкие решения (LLR) двух бит независимы и
+// пропорциональны соответствующей составляющей:
+//   LLR = ln P(b = 0) / P(b = 1) = 4 * amplitude * y / noise_var,
+// где amplitude - амплитуда составляющей символа, noise_var - дисперсия
+// комплексного шума (по noise_var / 2 на составляющую). Положительный LLR
+// соответствует биту 0. Блоки символов обрабатываются SSE (два символа на
+// регистр), остаток и сборки без SSE - скалярно с тем же результатом.
+
+// Оценка канала по принятым символам
+typedef struct {
+    float amplitude;   // амплитуда составляющей I/Q символа
+    float noise_var;   // дисперсия комплексного шума
+} qpsk_channel_estimate;
+
+// Биты символа в виде упакованного поля (младший разряд - первый бит).
+// Знак определяется знаковым разрядом: -0.0 считается отрицательным, как
+// в блочных функциях.
+static inline unsigned qpsk_demapper_pair(complex_float symbol) {
+    return (signbit(symbol.imag) ? 1u : 0u) | (signbit(symbol.real) ? 2u : 0u);
+}
+
+// Жесткие решения n символов: по 2 байта 0/1 на символ
+void qpsk_demapper_hard(const complex_float* symbols, int n, uint8_t* bits);
+
+// То же в упакованные слова с четной позиции first_bit; остальные разряды
+// слов не меняются
+void qpsk_demapper_hard_packed(const complex_float* symbols, int n, uint64_t* words,
+                               long long first_bit);
+
+// Оценка амплитуды и шума по моментам M2 = E|y|^2, M4 = E|y|^4 (M2M4):
+// мощность сигнала S = sqrt(2 * M2^2 - M4), шум N = M2 - S. Не требует
+// решений, поэтому не смещается при высоком уровне шума. Шум ограничен
+// снизу долей QPSK_DEMAPPER_MIN_NOISE от мощности сигнала, чтобы LLR
+// оставались конечными. 0 или -1 при n <= 0.
+#define QPSK_DEMAPPER_MIN_NOISE 1e-6f
+int qpsk_demapper_estimate(const complex_float* symbols, int n, qpsk_channel_estimate* est);
+
+// LLR двух бит каждого символа: llr[2 * i] - первый бит, llr[2 * i + 1] - второй
+void qpsk_demapper_llr(const complex_float* symbols, int n, const qpsk_channel_estimate* est,
+                       float* llr);
+
+#endif // QPSK_DEMAPPER_H
@@ -4,149 +4,597 @@
 #include <string.h>
 
 #include "qpsk_modem.h"
+#include "../filters/dsp_dispatch.h"
+#include "../filters/dsp_stats.h"
 
 
 
+// Длина сигнала qpsk_modulate вместе с хвостом импульса
+static int qpsk_modulate_length(int num_bits, const qpsk_params* params) {
+    return (num_bits / 2 + qpsk_pulse_delay(params)) * params->samples_per_sym;
+}
+
 complex_float* qpsk_modulate(const uint8_t* bits, int num_bits, 
                             const qpsk_params* params, int* out_length) {
-    int num_symbols = num_bits / 2;
-    *out_length = num_symbols * params->samples_per_sym;
+    qpsk_modulator mod;
+    if (qpsk_modulator_init(&mod, params) != 0) return NULL;
+    *out_length = qpsk_modulate_length(num_bits, params);
     
     // Выделяем память под выходной сигнал
     complex_float* tx_signal = malloc(*out_length * sizeof(complex_float));
+    if (!tx_signal) {
+        qpsk_modulator_free(&mod);
+        return NULL;
+    }
+    
+    qpsk_modulator_process(&mod, bits, num_bits, tx_signal);
+    qpsk_modulator_flush(&mod, &tx_signal[num_bits / 2 * params->samples_per_sym]);
+    qpsk_modulator_free(&mod);
+    return tx_signal;
+}
+
+size_t qpsk_modulate_workspace_size(int num_bits, const qpsk_params* params) {
+    return workspace_align((size_t)qpsk_modulate_length(num_bits, params) *
+                           sizeof(complex_float)) +
+           qpsk_modulator_workspace_size(params);
+}
+
+complex_float* qpsk_modulate_ws(const uint8_t* bits, int num_bits, const qpsk_params* params,
+                                workspace* ws, int* out_length) {
+    *out_length = qpsk_modulate_length(num_bits, params);
+    size_t mark = workspace_mark(ws);
+    complex_float* tx_signal = workspace_alloc(ws, *out_length * sizeof(complex_float));
     if (!tx_signal) return NULL;
     
-    // Генерируем несущую
-    float* carrier_real = malloc(*out_length * sizeof(float));
-    float* carrier_imag = malloc(*out_length * sizeof(float));
-    if (!carrier_real || !carrier_imag) {
-        free(tx_signal);
-        free(carrier_real);
-        free(carrier_imag);
+    // Модулятор живет только на время вызова
+    size_t mod_mark = workspace_mark(ws);
+    qpsk_modulator mod;
+    if (qpsk_modulator_init_ws(&mod, params, ws) != 0) {
+        workspace_release(ws, mark);
         return NULL;
     }
+    qpsk_modulator_process(&mod, bits, num_bits, tx_signal);
+    qpsk_modulator_flush(&mod, &tx_signal[num_bits / 2 * params->samples_per_sym]);
+    workspace_release(ws, mod_mark);
+    return tx_signal;
+}
+
+// Символы Gray по полю из двух упакованных бит (младший разряд - первый
+// бит): 00 -> (+,+), 01 -> (-,+), 10 -> (+,-), 11 -> (-,-)
+#define QPSK_A (float)(1.0 / M_SQRT2)
+static const complex_float qpsk_symbols[4] = {
+    { QPSK_A,  QPSK_A},   // 00
+    { QPSK_A, -QPSK_A},   // 10
+    {-QPSK_A,  QPSK_A},   // 01
+    {-QPSK_A, -QPSK_A}    // 11
+};
+
+// Импульс символа на несущей
+static inline void qpsk_modulate_symbol(complex_float symbol, int sps, oscillator* carrier,
+                                        complex_float* pulse) {
+    oscillator_generate(carrier, pulse, sps);
+    for (int j = 0; j < sps; j++) {
+        float carrier_real = pulse[j].real;
+        float carrier_imag = pulse[j].imag;
+        pulse[j].real = symbol.real * carrier_real - symbol.imag * carrier_imag;
+        pulse[j].imag = symbol.real * carrier_imag + symbol.imag * carrier_real;
+    }
+}
+
+void qpsk_modulate_block(const uint8_t* bits, int num_bits, const qpsk_params* params,
+                         oscillator* carrier, complex_float* out) {
+    DSP_STATS_BEGIN(probe);
+    int num_symbols = num_bits / 2;
+    int sps = params->samples_per_sym;
     
-    float phase_inc = 2 * M_PI * params->f_center / params->fs;
-    float phase = 0.0f;
-    for (int i = 0; i < *out_length; i++) {
-        carrier_real[i] = cosf(phase);
-        carrier_imag[i] = sinf(phase);
-        phase += phase_inc;
-        if (phase > 2 * M_PI) phase -= 2 * M_PI;
+    for (int i = 0; i < num_symbols; i++) {
+        // Два бита символа в порядке упакованного поля
+        unsigned pair = (bits[2*i] & 1) | ((bits[2*i+1] & 1) << 1);
+        qpsk_modulate_symbol(qpsk_symbols[pair], sps, carrier, &out[i * sps]);
     }
+    DSP_STATS_END(probe, DSP_STAGE_MODULATE, (long long)num_symbols * sps);
+}
+
+void qpsk_modulate_packed_block(const uint64_t* words, long long first_bit, int num_bits,
+                                const qpsk_params* params, oscillator* carrier,
+                                complex_float* out) {
+    DSP_STATS_BEGIN(probe);
+    int num_symbols = num_bits / 2;
+    int sps = params->samples_per_sym;
+    const uint64_t* w = &words[first_bit / PACKED_WORD_BITS];
+    int shift = (int)(first_bit % PACKED_WORD_BITS);
+    uint64_t word = *w >> shift;
     
-    // Модуляция
+    // Слово сдвигается на 2 бита за символ; 32 символа на слово
     for (int i = 0; i < num_symbols; i++) {
-        // Чтение двух битов
-        uint8_t dibit = (bits[2*i] << 1) | bits[2*i+1];
-        complex_float symbol;
+        qpsk_modulate_symbol(qpsk_symbols[word & 3], sps, carrier, &out[i * sps]);
+        word >>= 2;
+        shift += 2;
+        if (shift == PACKED_WORD_BITS && i + 1 < num_symbols) {
+            word = *++w;
+            shift = 0;
+        }
+    }
+    DSP_STATS_END(probe, DSP_STAGE_MODULATE, (long long)num_symbols * sps);
+}
+
+int qpsk_modulator_init(qpsk_modulator* mod, const qpsk_params* params) {
+    return qpsk_modulator_init_ws(mod, params, NULL);
+}
+
+size_t qpsk_modulator_workspace_size(const qpsk_params* params) {
+    if (params->pulse != QPSK_PULSE_RRC) {
+        return 0;
+    }
+    int length = rrc_pulse_length(params->samples_per_sym, params->span, params->rolloff);
+    if (length < 0) {
+        return 0;
+    }
+    size_t taps_per_phase = params->span + 1;
+    // Фазы, линия задержки и временный буфер импульса на время init
+    return workspace_align(taps_per_phase * params->samples_per_sym * sizeof(float)) +
+           workspace_align(2 * taps_per_phase * sizeof(complex_float)) +
+           workspace_align((size_t)length * sizeof(float));
+}
+
+int qpsk_modulator_init_ws(qpsk_modulator* mod, const qpsk_params* params, workspace* ws) {
+    if (!mod || !params || params->samples_per_sym <= 0) {
+        return -1;
+    }
+    memset(mod, 0, sizeof(*mod));
+    mod->params = *params;
+    if (oscillator_init(&mod->carrier, params->f_center, params->fs) != 0) {
+        return -1;
+    }
+    if (params->pulse != QPSK_PULSE_RRC) {
+        return 0;
+    }
+    
+    int sps = params->samples_per_sym;
+    int length = rrc_pulse_length(sps, params->span, params->rolloff);
+    if (length < 0) {
+        return -1;
+    }
+    int taps_per_phase = params->span + 1;
+    mod->taps_per_phase = taps_per_phase;
+    mod->external = (ws != NULL);
+    mod->phases = workspace_calloc(ws, (size_t)taps_per_phase * sps, sizeof(float));
+    mod->history = workspace_calloc(ws, 2 * taps_per_phase, sizeof(complex_float));
+    size_t mark = ws ? workspace_mark(ws) : 0;
+    float* taps = workspace_calloc(ws, length, sizeof(float));
+    if (!mod->phases || !mod->history || !taps) {
+        if (!ws) {
+            free(taps);
+        }
+        qpsk_modulator_free(mod);
+        return -2;
+    }
+    
+    // Фаза p: отсчеты импульса p, p + sps, p + 2 * sps, ...; коэффициент
+    // i фазы умножается на символ, пришедший i символов назад. Хранение по
+    // строкам i, чтобы вклад одного символа считался по непрерывной строке
+    rrc_pulse_design(taps, sps, params->span, params->rolloff);
+    for (int i = 0; i < taps_per_phase; i++) {
+        for (int p = 0; p < sps; p++) {
+            int k = p + i * sps;
+            mod->phases[i * sps + p] = (k < length) ? taps[k] : 0.0f;
+        }
+    }
+    if (ws) {
+        workspace_release(ws, mark);
+    } else {
+        free(taps);
+    }
+    return 0;
+}
+
+void qpsk_modulator_free(qpsk_modulator* mod) {
+    if (!mod->external) {
+        free(mod->phases);
+        free(mod->history);
+    }
+    mod->phases = NULL;
+    mod->history = NULL;
+}
+
+// Символьный интервал RRC: вклад taps_per_phase последних символов
+// (нулевые символы пропускаются), затем перенос на несущую
+static void qpsk_modulator_rrc_symbol(qpsk_modulator* mod, complex_float symbol,
+                                      complex_float* out) {
+    int sps = mod->params.samples_per_sym;
+    int taps_per_phase = mod->taps_per_phase;
+    
+    // Зеркальная линия задержки: history[position + i] - символ i интервалов назад
+    mod->position = (mod->position == 0) ? taps_per_phase - 1 : mod->position - 1;
+    mod->history[mod->position] = symbol;
+    mod->history[mod->position + taps_per_phase] = symbol;
+    const complex_float* x = &mod->history[mod->position];
+    
+    memset(out, 0, sps * sizeof(complex_float));
+    for (int i = 0; i < taps_per_phase; i++) {
+        if (x[i].real == 0.0f && x[i].imag == 0.0f) {
+            continue;
+        }
+        const float* c = &mod->phases[i * sps];
+        float xr = x[i].real;
+        float xi = x[i].imag;
+        for (int p = 0; p < sps; p++) {
+            out[p].real += c[p] * xr;
+            out[p].imag += c[p] * xi;
+        }
+    }
+    oscillator_mix(&mod->carrier, out, out, sps);
+}
+
+void qpsk_modulator_process(qpsk_modulator* mod, const uint8_t* bits, int num_bits,
+                            complex_float* out) {
+    if (!mod->phases) {
+        qpsk_modulate_block(bits, num_bits, &mod->params, &mod->carrier, out);
+        return;
+    }
+    DSP_STATS_BEGIN(probe);
+    int sps = mod->params.samples_per_sym;
+    for (int i = 0; i < num_bits / 2; i++) {
+        unsigned pair = (bits[2*i] & 1) | ((bits[2*i+1] & 1) << 1);
+        qpsk_modulator_rrc_symbol(mod, qpsk_symbols[pair], &out[i * sps]);
+    }
+    DSP_STATS_END(probe, DSP_STAGE_MODULATE, (long long)(num_bits / 2) * sps);
+}
+
+void qpsk_modulator_process_packed(qpsk_modulator* mod, const uint64_t* words,
+                                   long long first_bit, int num_bits, complex_float* out) {
+    if (!mod->phases) {
+        qpsk_modulate_packed_block(words, first_bit, num_bits, &mod->params, &mod->carrier, out);
+        return;
+    }
+    DSP_STATS_BEGIN(probe);
+    int sps = mod->params.samples_per_sym;
+    for (int i = 0; i < num_bits / 2; i++) {
+        unsigned pair = packed_get2(words, first_bit + 2 * (long long)i);
+        qpsk_modulator_rrc_symbol(mod, qpsk_symbols[pair], &out[i * sps]);
+    }
+    DSP_STATS_END(probe, DSP_STAGE_MODULATE, (long long)(num_bits / 2) * sps);
+}
+
+int qpsk_modulator_flush(qpsk_modulator* mod, complex_float* out) {
+    if (!mod->phases) {
+        return 0;
+    }
+    DSP_STATS_BEGIN(probe);
+    int sps = mod->params.samples_per_sym;
+    const complex_float zero = {0.0f, 0.0f};
+    for (int i = 0; i < mod->params.span; i++) {
+        qpsk_modulator_rrc_symbol(mod, zero, &out[i * sps]);
+    }
+    DSP_STATS_END(probe, DSP_STAGE_MODULATE, (long long)mod->params.span * sps);
+    return mod->params.span * sps;
+}
+
+int qpsk_demodulator_init(qpsk_demodulator* dem, const qpsk_params* params, int delay) {
+    return qpsk_demodulator_init_ws(dem, params, delay, NULL);
+}
+
+size_t qpsk_demodulator_workspace_size(const qpsk_params* params) {
+    if (params->pulse != QPSK_PULSE_RRC) {
+        return 0;
+    }
+    int length = rrc_pulse_length(params->samples_per_sym, params->span, params->rolloff);
+    if (length < 0) {
+        return 0;
+    }
+    return workspace_align((size_t)length * sizeof(float)) +
+           workspace_align(4 * (size_t)length * sizeof(float));
+}
+
+int qpsk_demodulator_init_ws(qpsk_demodulator* dem, const qpsk_params* params, int delay,
+                             workspace* ws) {
+    if (!dem || !params || params->samples_per_sym <= 0 || delay < 0) {
+        return -1;
+    }
+    memset(dem, 0, sizeof(*dem));
+    dem->params = *params;
+    if (oscillator_init(&dem->nco, params->f_center, params->fs) != 0) {
+        return -1;
+    }
+    dem->delay = delay;
+    if (params->pulse != QPSK_PULSE_RRC) {
+        return 0;
+    }
+    
+    int length = rrc_pulse_length(params->samples_per_sym, params->span, params->rolloff);
+    if (length < 0) {
+        return -1;
+    }
+    dem->length = length;
+    dem->external = (ws != NULL);
+    dem->taps = workspace_calloc(ws, length, sizeof(float));
+    dem->history = workspace_calloc(ws, 4 * (size_t)length, sizeof(float));
+    if (!dem->taps || !dem->history) {
+        qpsk_demodulator_free(dem);
+        return -2;
+    }
+    // Импульс симметричен, поэтому согласованный фильтр совпадает с ним
+    rrc_pulse_design(dem->taps, params->samples_per_sym, params->span, params->rolloff);
+    return 0;
+}
+
+void qpsk_demodulator_free(qpsk_demodulator* dem) {
+    if (!dem->external) {
+        free(dem->taps);
+        free(dem->history);
+    }
+    dem->taps = NULL;
+    dem->history = NULL;
+}
+
+// Отсчет символа в созвездие; решения по блоку отсчетов принимает
+// демаппер после обработки всего блока
+static void qpsk_demodulator_store(qpsk_demodulator* dem, int emitted,
+                                   complex_float* constellation, complex_float avg) {
+    constellation[emitted] = avg;
+    dem->symbol++;
+}
+
+// Выдача накопленного символа: среднее значение в середине символа
+static void qpsk_demodulator_emit(qpsk_demodulator* dem, int emitted,
+                                  complex_float* constellation) {
+    complex_float avg = dem->acc;
+    avg.real /= dem->count;
+    avg.imag /= dem->count;
+    qpsk_demodulator_store(dem, emitted, constellation, avg);
+    
+    dem->acc.real = 0.0f;
+    dem->acc.imag = 0.0f;
+    dem->count = 0;
+}
+
+// Согласованный фильтр с прореживанием: отсчеты проходят через линии
+// задержки, а свертка считается только в моменты отсчета символов
+static int qpsk_demodulator_matched(qpsk_demodulator* dem, const complex_float* baseband, int m,
+                                    int emitted, complex_float* constellation) {
+    const dsp_kernels *kernels = dsp_dispatch();
+    int sps = dem->params.samples_per_sym;
+    int length = dem->length;
+    float* re = dem->history;
+    float* im = &dem->history[2 * length];
+    float scale = 1.0f / sps;
+    int count = 0;
+    
+    for (int k = 0; k < m; k++) {
+        // Зеркальные линии: history[position + i] - отсчет i тактов назад
+        dem->position = (dem->position == 0) ? length - 1 : dem->position - 1;
+        re[dem->position] = re[dem->position + length] = baseband[k].real;
+        im[dem->position] = im[dem->position + length] = baseband[k].imag;
+        long long j = dem->index++;
         
-        // Сопоставление бит с символом (Gray coding)
-        switch (dibit) {
-            case 0: // 00
-                symbol.real =  1.0f / M_SQRT2;
-                symbol.imag =  1.0f / M_SQRT2;
-                break;
-            case 1: // 01
-                symbol.real = -1.0f / M_SQRT2;
-                symbol.imag =  1.0f / M_SQRT2;
-                break;
-            case 2: // 10
-                symbol.real =  1.0f / M_SQRT2;
-                symbol.imag = -1.0f / M_SQRT2;
-                break;
-            case 3: // 11
-                symbol.real = -1.0f / M_SQRT2;
-                symbol.imag = -1.0f / M_SQRT2;
-                break;
+        if (j == dem->symbol * sps + length - 1) {
+            complex_float avg = {kernels->dot(dem->taps, &re[dem->position], length) * scale,
+                                 kernels->dot(dem->taps, &im[dem->position], length) * scale};
+            qpsk_demodulator_store(dem, emitted + count, constellation, avg);
+            count++;
         }
+    }
+    return count;
+}
+
+static int qpsk_demodulator_run(qpsk_demodulator* dem, const complex_float* in, int n,
+                                complex_float* constellation) {
+    int sps = dem->params.samples_per_sym;
+    int emitted = 0;
+    complex_float baseband[QPSK_DEMOD_CHUNK];
+    
+    int i = 0;
+    // Пропуск задержки
+    if (dem->received < dem->delay) {
+        long long skip = dem->delay - dem->received;
+        i = (skip < n) ? (int)skip : n;
+        dem->received += i;
+    }
+    
+    while (i < n) {
+        // Перенос в базовую полосу участками по QPSK_DEMOD_CHUNK отсчетов
+        int m = (n - i < QPSK_DEMOD_CHUNK) ? n - i : QPSK_DEMOD_CHUNK;
+        DSP_STATS_BEGIN(mix_probe);
+        oscillator_mix_conj(&dem->nco, &in[i], baseband, m);
+        DSP_STATS_END(mix_probe, DSP_STAGE_MIX, m);
+        dem->received += m;
+        i += m;
         
-        // Формируем импульс
-        int start = i * params->samples_per_sym;
-        for (int j = 0; j < params->samples_per_sym; j++) {
-            int idx = start + j;
-            tx_signal[idx].real = symbol.real * carrier_real[idx] - symbol.imag * carrier_imag[idx];
-            tx_signal[idx].imag = symbol.real * carrier_imag[idx] + symbol.imag * carrier_real[idx];
+        DSP_STATS_BEGIN(matched_probe);
+        if (dem->taps) {
+            emitted += qpsk_demodulator_matched(dem, baseband, m, emitted, constellation);
+            DSP_STATS_END(matched_probe, DSP_STAGE_MATCHED, m);
+            continue;
         }
+        for (int k = 0; k < m; k++) {
+            // Придержанный отсчет index - 1 уже точно не последний в сигнале
+            long long j = dem->index;
+            if (j > 0) {
+                long long start = dem->symbol * sps + sps / 4;
+                if (j - 1 >= start && j - 1 < start + sps / 2) {
+                    dem->acc.real += dem->held.real;
+                    dem->acc.imag += dem->held.imag;
+                    dem->count++;
+                }
+            }
+            dem->held = baseband[k];
+            dem->index++;
+            
+            // Окно символа заполнено, если отсчет j - его правая граница
+            while (j == dem->symbol * sps + sps / 4 + sps / 2) {
+                qpsk_demodulator_emit(dem, emitted, constellation);
+                emitted++;
+            }
+        }
+        DSP_STATS_END(matched_probe, DSP_STAGE_MATCHED, m);
+    }
+    return emitted;
+}
+
+static int qpsk_demodulator_finish(qpsk_demodulator* dem, complex_float* constellation) {
+    // Символы без полного окна согласованного фильтра не выдаются
+    if (dem->taps) {
+        return 0;
+    }
+    int sps = dem->params.samples_per_sym;
+    long long processed_length = dem->index;
+    // Сигнал не длиннее задержки: как и qpsk_demodulate, берем только
+    // последний отсчет
+    if (processed_length == 0 && dem->received > 0) {
+        processed_length = 1;
     }
     
-    free(carrier_real);
-    free(carrier_imag);
-    return tx_signal;
+    // Окна оставшихся символов обрезаны по последнему отсчету сигнала
+    long long num_symbols = (processed_length + sps - 1) / sps;
+    int emitted = 0;
+    while (dem->symbol < num_symbols) {
+        qpsk_demodulator_emit(dem, emitted, constellation);
+        emitted++;
+    }
+    return emitted;
 }
 
-uint8_t* qpsk_demodulate(const complex_float* signal, int signal_length,
-                        const qpsk_params* params, int delay, 
-                        int* out_num_bits, complex_float** out_constellation) {
+int qpsk_demodulator_push(qpsk_demodulator* dem, const complex_float* in, int n,
+                          uint8_t* bits, complex_float* constellation) {
+    int symbols = qpsk_demodulator_run(dem, in, n, constellation);
+    qpsk_demapper_hard(constellation, symbols, bits);
+    return symbols;
+}
+
+int qpsk_demodulator_flush(qpsk_demodulator* dem, uint8_t* bits, complex_float* constellation) {
+    int symbols = qpsk_demodulator_finish(dem, constellation);
+    qpsk_demapper_hard(constellation, symbols, bits);
+    return symbols;
+}
+
+int qpsk_demodulator_push_packed(qpsk_demodulator* dem, const complex_float* in, int n,
+                                 uint64_t* words, long long first_bit,
+                                 complex_float* constellation) {
+    int symbols = qpsk_demodulator_run(dem, in, n, constellation);
+    qpsk_demapper_hard_packed(constellation, symbols, words, first_bit);
+    return symbols;
+}
+
+int qpsk_demodulator_flush_packed(qpsk_demodulator* dem, uint64_t* words, long long first_bit,
+                                  complex_float* constellation) {
+    int symbols = qpsk_demodulator_finish(dem, constellation);
+    qpsk_demapper_hard_packed(constellation, symbols, words, first_bit);
+    return symbols;
+}
+
+// Число символов qpsk_demodulate для сигнала длины signal_length
+static int qpsk_demodulate_symbols(int signal_length, const qpsk_params* params, int delay) {
     // Применяем задержку
     if (delay >= signal_length) delay = signal_length - 1;
     int processed_length = signal_length - delay;
-    const complex_float* processed = &signal[delay];
-    
-    // Перенос в базовую полосу
-    complex_float* baseband = malloc(processed_length * sizeof(complex_float));
-    if (!baseband) return NULL;
-    
-    float phase_inc = 2 * M_PI * params->f_center / params->fs;
-    float phase = 0.0f;
-    for (int i = 0; i < processed_length; i++) {
-        float cos_val = cosf(phase);
-        float sin_val = sinf(phase);
-        baseband[i].real = processed[i].real * cos_val + processed[i].imag * sin_val;
-        baseband[i].imag = processed[i].imag * cos_val - processed[i].real * sin_val;
-        phase += phase_inc;
-        if (phase > 2 * M_PI) phase -= 2 * M_PI;
+    if (params->pulse == QPSK_PULSE_RRC) {
+        int length = rrc_pulse_length(params->samples_per_sym, params->span, params->rolloff);
+        if (length < 0 || processed_length < length) return 0;
+        return (processed_length - length) / params->samples_per_sym + 1;
     }
+    return (processed_length + params->samples_per_sym - 1) / params->samples_per_sym;
+}
+
+// Отсчеты символов всего сигнала, решения принимает вызывающий
+static int qpsk_demodulate_points(const complex_float* signal, int signal_length,
+                                  qpsk_demodulator* dem, complex_float* constellation) {
+    int symbols = qpsk_demodulator_run(dem, signal, signal_length, constellation);
+    return symbols + qpsk_demodulator_finish(dem, &constellation[symbols]);
+}
+
+static void qpsk_demodulate_into(const complex_float* signal, int signal_length,
+                                 qpsk_demodulator* dem, uint8_t* bits,
+                                 complex_float* constellation) {
+    int symbols = qpsk_demodulate_points(signal, signal_length, dem, constellation);
+    qpsk_demapper_hard(constellation, symbols, bits);
+}
+
+uint8_t* qpsk_demodulate(const complex_float* signal, int signal_length,
+                        const qpsk_params* params, int delay, 
+                        int* out_num_bits, complex_float** out_constellation) {
+    qpsk_demodulator dem;
+    if (delay >= signal_length) delay = signal_length - 1;
+    if (qpsk_demodulator_init(&dem, params, delay) != 0) return NULL;
     
-    // Выборка символов
-    int num_symbols = (processed_length + params->samples_per_sym - 1) / params->samples_per_sym;
+    int num_symbols = qpsk_demodulate_symbols(signal_length, params, delay);
     *out_num_bits = num_symbols * 2;
     uint8_t* decoded_bits = malloc(*out_num_bits * sizeof(uint8_t));
     *out_constellation = malloc(num_symbols * sizeof(complex_float));
     
     if (!decoded_bits || !*out_constellation) {
-        free(baseband);
         free(decoded_bits);
         free(*out_constellation);
+        qpsk_demodulator_free(&dem);
         return NULL;
     }
     
-    for (int i = 0; i < num_symbols; i++) {
-        // Среднее значение в середине символа
-        int start = i * params->samples_per_sym + params->samples_per_sym / 4;
-        int end = start + params->samples_per_sym / 2;
-        if (end >= processed_length) end = processed_length - 1;
-        
-        complex_float avg = {0, 0};
-        int count = 0;
-        for (int j = start; j < end; j++) {
-            avg.real += baseband[j].real;
-            avg.imag += baseband[j].imag;
-            count++;
-        }
-        avg.real /= count;
-        avg.imag /= count;
-        
-        (*out_constellation)[i] = avg;
-        
-        // Решающее устройство
-        float angle = atan2f(avg.imag, avg.real);
-        uint8_t symbol;
-        
-        if (angle >= -M_PI_4 && angle < M_PI_4) {
-            symbol = 0; // 00
-        } else if (angle >= M_PI_4 && angle < 3*M_PI_4) {
-            symbol = 1; // 01
-        } else if (angle >= -3*M_PI_4 && angle < -M_PI_4) {
-            symbol = 2; // 10
-        } else {
-            symbol = 3; // 11
+    qpsk_demodulate_into(signal, signal_length, &dem, decoded_bits, *out_constellation);
+    qpsk_demodulator_free(&dem);
+    return decoded_bits;
+}
+
+float* qpsk_demodulate_llr(const complex_float* signal, int signal_length,
+                           const qpsk_params* params, int delay,
+                           const qpsk_channel_estimate* channel,
+                           int* out_num_bits, complex_float** out_constellation) {
+    qpsk_demodulator dem;
+    if (delay >= signal_length) delay = signal_length - 1;
+    if (qpsk_demodulator_init(&dem, params, delay) != 0) return NULL;
+    
+    int num_symbols = qpsk_demodulate_symbols(signal_length, params, delay);
+    *out_num_bits = num_symbols * 2;
+    float* llr = malloc(*out_num_bits * sizeof(float));
+    *out_constellation = malloc(num_symbols * sizeof(complex_float));
+    
+    if (!llr || !*out_constellation) {
+        free(llr);
+        free(*out_constellation);
+        qpsk_demodulator_free(&dem);
+        return NULL;
+    }
+    
+    int symbols = qpsk_demodulate_points(signal, signal_length, &dem, *out_constellation);
+    qpsk_demodulator_free(&dem);
+    qpsk_channel_estimate estimate;
+    if (!channel) {
+        // Оценка по созвездию самого сигнала
+        if (qpsk_demapper_estimate(*out_constellation, symbols, &estimate) != 0) {
+            estimate.amplitude = (float)(1.0 / M_SQRT2);
+            estimate.noise_var = 1.0f;
         }
-        
-        decoded_bits[2*i] = (symbol >> 1) & 1;
-        decoded_bits[2*i+1] = symbol & 1;
+        channel = &estimate;
     }
+    qpsk_demapper_llr(*out_constellation, symbols, channel, llr);
+    return llr;
+}
+
+size_t qpsk_demodulate_workspace_size(int signal_length, const qpsk_params* params, int delay) {
+    size_t num_symbols = qpsk_demodulate_symbols(signal_length, params, delay);
+    return workspace_align(2 * num_symbols) + workspace_align(num_symbols * sizeof(complex_float)) +
+           qpsk_demodulator_workspace_size(params);
+}
+
+uint8_t* qpsk_demodulate_ws(const complex_float* signal, int signal_length,
+                            const qpsk_params* params, int delay, workspace* ws,
+                            int* out_num_bits, complex_float** out_constellation) {
+    qpsk_demodulator dem;
+    if (delay >= signal_length) delay = signal_length - 1;
+    
+    int num_symbols = qpsk_demodulate_symbols(signal_length, params, delay);
+    *out_num_bits = num_symbols * 2;
+    size_t mark = workspace_mark(ws);
+    uint8_t* decoded_bits = workspace_alloc(ws, *out_num_bits);
+    *out_constellation = workspace_alloc(ws, num_symbols * sizeof(complex_float));
     
-    free(baseband);
+    // Линии задержки демодулятора возвращаются в область после вызова
+    size_t dem_mark = workspace_mark(ws);
+    if (!decoded_bits || !*out_constellation ||
+        qpsk_demodulator_init_ws(&dem, params, delay, ws) != 0) {
+        workspace_release(ws, mark);
+        return NULL;
+    }
+    
+    qpsk_demodulate_into(signal, signal_length, &dem, decoded_bits, *out_constellation);
+    workspace_release(ws, dem_mark);
     return decoded_bits;
-}
\ No newline at end of file
+}
@@ -2,22 +2,163 @@
 #define QPSK_MODEM_H
 
 #include <stdint.h>
-#include "../coeffs.h"
+#include "../filters/complex_float.h"
+#include "../filters/oscillator.h"
+#include "../filters/workspace.h"
+#include "packed_bits.h"
+#include "rrc_pulse.h"
+#include "qpsk_demapper.h"
 
-// Параметры модуляции
+typedef enum {
+    QPSK_PULSE_RECT = 0,  // прямоугольный импульс, прием - среднее по середине символа
+    QPSK_PULSE_RRC        // RRC (rrc_pulse.h), прием - согласованный фильтр
+} qpsk_pulse;
+
+// Параметры модуляции. Поля формы импульса можно не задавать: нулевые
+// значения дают прямоугольный импульс.
 typedef struct {
     float f_center;       // Центральная частота (Гц)
     float fs;             // Частота дискретизации (Гц)
     int samples_per_sym;  // Отсчетов на символ
+    qpsk_pulse pulse;     // форма импульса
+    float rolloff;        // коэффициент скругления RRC, (0, 1]
+    int span;             // длина импульса RRC в символах
 } qpsk_params;
 
-// QPSK модуляция
+// Задержка сигнала в символах от модулятора до выхода согласованного
+// фильтра: span для RRC (по span / 2 на передаче и приеме), 0 для
+// прямоугольного импульса
+static inline int qpsk_pulse_delay(const qpsk_params* params) {
+    return params->pulse == QPSK_PULSE_RRC ? params->span : 0;
+}
+
+// QPSK модуляция. Для RRC сигнал дополняется хвостом импульса:
+// (num_bits / 2 + span) * samples_per_sym отсчетов.
 complex_float* qpsk_modulate(const uint8_t* bits, int num_bits, 
                             const qpsk_params* params, int* out_length);
 
+// То же с выходным сигналом из рабочей области ws (без malloc); размер
+// нужной области - qpsk_modulate_workspace_size
+complex_float* qpsk_modulate_ws(const uint8_t* bits, int num_bits, const qpsk_params* params,
+                                workspace* ws, int* out_length);
+size_t qpsk_modulate_workspace_size(int num_bits, const qpsk_params* params);
+
+// Модуляция блока прямоугольными импульсами в буфер вызывающего
+// (num_bits / 2 * samples_per_sym отсчетов). carrier - генератор несущей
+// f_center (oscillator_init), его фаза продолжается между вызовами.
+// Форму импульса из params учитывает qpsk_modulator.
+void qpsk_modulate_block(const uint8_t* bits, int num_bits, const qpsk_params* params,
+                         oscillator* carrier, complex_float* out);
+
+// То же для упакованных бит (packed_bits.h) с четной позиции first_bit:
+// символ выбирается по таблице из двух соседних разрядов слова
+void qpsk_modulate_packed_block(const uint64_t* words, long long first_bit, int num_bits,
+                                const qpsk_params* params, oscillator* carrier,
+                                complex_float* out);
+
+// Потоковый модулятор с формой импульса из params. RRC формируется
+// полифазным интерполятором: отсчет p символьного интервала равен сумме
+// span + 1 последних символов с коэффициентами фазы p, так что на отсчет
+// приходится span + 1 умножений вместо span * samples_per_sym + 1 у свертки
+// с нулями между символами.
+typedef struct {
+    qpsk_params params;
+    oscillator carrier;
+    float* phases;            // RRC: коэффициенты фаз, taps_per_phase x samples_per_sym
+    complex_float* history;   // RRC: зеркальная линия задержки символов, 2 * taps_per_phase
+    int taps_per_phase;       // span + 1
+    int position;
+    int external;             // массивы в рабочей области (qpsk_modulator_free их не освобождает)
+} qpsk_modulator;
+
+int qpsk_modulator_init(qpsk_modulator* mod, const qpsk_params* params);
+// Массивы из рабочей области ws (NULL - из кучи)
+int qpsk_modulator_init_ws(qpsk_modulator* mod, const qpsk_params* params, workspace* ws);
+size_t qpsk_modulator_workspace_size(const qpsk_params* params);
+void qpsk_modulator_free(qpsk_modulator* mod);
+
+// num_bits / 2 * samples_per_sym отсчетов в out
+void qpsk_modulator_process(qpsk_modulator* mod, const uint8_t* bits, int num_bits,
+                            complex_float* out);
+void qpsk_modulator_process_packed(qpsk_modulator* mod, const uint64_t* words,
+                                   long long first_bit, int num_bits, complex_float* out);
+
+// Хвост импульса последних символов: span * samples_per_sym отсчетов для
+// RRC, 0 для прямоугольного импульса; возвращает число отсчетов
+int qpsk_modulator_flush(qpsk_modulator* mod, complex_float* out);
+
+// Потоковый демодулятор: сигнал подается блоками произвольной длины,
+// фаза генератора, накопители текущего символа и пропуск задержки
+// сохраняются между вызовами. Результат совпадает с qpsk_demodulate для
+// всего сигнала целиком. Последний принятый отсчет придерживается до
+// следующего вызова, так как qpsk_demodulate исключает последний отсчет
+// сигнала из окна усреднения.
+// Для RRC вместо окна усреднения работает согласованный фильтр с
+// прореживанием: его выход считается только в моменты отсчета символов
+// (отсчет span * samples_per_sym после начала символа), один раз на
+// samples_per_sym входных отсчетов. Символы без полного окна фильтра в
+// конце потока не выдаются.
+#define QPSK_DEMOD_FLUSH_MAX 2  // не более символов выдает flush
+#define QPSK_DEMOD_CHUNK 256    // участок переноса в базовую полосу (буфер на стеке)
+
+typedef struct {
+    qpsk_params params;
+    oscillator nco;           // генератор переноса в базовую полосу
+    int delay;                // пропускаемых отсчетов в начале
+    long long received;       // принято отсчетов всего (включая задержку)
+    long long index;          // принято отсчетов после задержки
+    complex_float held;       // придержанный отсчет baseband (index - 1)
+    long long symbol;         // номер накапливаемого символа
+    complex_float acc;        // сумма отсчетов в окне символа
+    int count;                // число отсчетов в сумме
+    float* taps;              // RRC: импульс согласованного фильтра, length отсчетов
+    float* history;           // RRC: зеркальные линии задержки I и Q, по 2 * length
+    int length;
+    int position;
+    int external;             // массивы в рабочей области
+} qpsk_demodulator;
+
+int qpsk_demodulator_init(qpsk_demodulator* dem, const qpsk_params* params, int delay);
+// Массивы согласованного фильтра из рабочей области ws (NULL - из кучи)
+int qpsk_demodulator_init_ws(qpsk_demodulator* dem, const qpsk_params* params, int delay,
+                             workspace* ws);
+size_t qpsk_demodulator_workspace_size(const qpsk_params* params);
+void qpsk_demodulator_free(qpsk_demodulator* dem);
+
+// Обработка n отсчетов. Готовые символы записываются в constellation,
+// их биты - в bits (по 2 на символ); возвращается число символов.
+// Буферы должны вмещать n / samples_per_sym + 1 символов.
+int qpsk_demodulator_push(qpsk_demodulator* dem, const complex_float* in, int n,
+                          uint8_t* bits, complex_float* constellation);
+
+// Завершение потока: выдает оставшиеся символы (не более QPSK_DEMOD_FLUSH_MAX)
+int qpsk_demodulator_flush(qpsk_demodulator* dem, uint8_t* bits, complex_float* constellation);
+
+// Варианты с упакованными решениями: биты записываются в words с четной
+// позиции first_bit (остальные разряды слов не меняются)
+int qpsk_demodulator_push_packed(qpsk_demodulator* dem, const complex_float* in, int n,
+                                 uint64_t* words, long long first_bit,
+                                 complex_float* constellation);
+int qpsk_demodulator_flush_packed(qpsk_demodulator* dem, uint64_t* words, long long first_bit,
+                                  complex_float* constellation);
+
 // QPSK демодуляция
 uint8_t* qpsk_demodulate(const complex_float* signal, int signal_length,
                         const qpsk_params* params, int delay, 
                         int* out_num_bits, complex_float** out_constellation);
 
+// Демодуляция с мягкими решениями: вместо байтов 0/1 возвращаются LLR
+// двух бит каждого символа (qpsk_demapper.h), *out_num_bits - их число.
+// channel - известные амплитуда и шум; NULL - оценка по созвездию сигнала
+float* qpsk_demodulate_llr(const complex_float* signal, int signal_length,
+                           const qpsk_params* params, int delay,
+                           const qpsk_channel_estimate* channel,
+                           int* out_num_bits, complex_float** out_constellation);
+
+// То же с битами и созвездием из рабочей области ws (без malloc)
+uint8_t* qpsk_demodulate_ws(const complex_float* signal, int signal_length,
+                            const qpsk_params* params, int delay, workspace* ws,
+                            int* out_num_bits, complex_float** out_constellation);
+size_t qpsk_demodulate_workspace_size(int signal_length, const qpsk_params* params, int delay);
+
 #endif // QPSK_MODEM_H
\ No newline at end of file
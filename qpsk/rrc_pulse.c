@@ -0,0 +1,45 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include "rrc_pulse.h"
+
+int rrc_pulse_length(int samples_per_sym, int span, float rolloff) {
+    if (samples_per_sym <= 0 || span <= 0 || (samples_per_sym * span) % 2 != 0 ||
+        !(rolloff > 0.0f && rolloff <= 1.0f)) {
+        return -1;
+    }
+    return span * samples_per_sym + 1;
+}
+
+// Значение импульса в момент t (в символах), единичный символьный интервал
+static double rrc_value(double t, double beta) {
+    if (fabs(t) < 1e-9) {
+        return 1.0 - beta + 4.0 * beta / M_PI;
+    }
+    // Устранимая особенность при |t| = 1 / (4 beta)
+    if (fabs(fabs(t) - 1.0 / (4.0 * beta)) < 1e-9) {
+        return beta / M_SQRT2 * ((1.0 + 2.0 / M_PI) * sin(M_PI / (4.0 * beta)) +
+                                 (1.0 - 2.0 / M_PI) * cos(M_PI / (4.0 * beta)));
+    }
+    double x = 4.0 * beta * t;
+    return (sin(M_PI * t * (1.0 - beta)) + x * cos(M_PI * t * (1.0 + beta))) /
+           (M_PI * t * (1.0 - x * x));
+}
+
+int rrc_pulse_design(float *taps, int samples_per_sym, int span, float rolloff) {
+    int length = rrc_pulse_length(samples_per_sym, span, rolloff);
+    if (length < 0 || !taps) {
+        return -1;
+    }
+    int center = (length - 1) / 2;
+    double energy = 0.0;
+    for (int i = 0; i < length; i++) {
+        double h = rrc_value((double)(i - center) / samples_per_sym, rolloff);
+        taps[i] = (float)h;
+        energy += h * h;
+    }
+    float scale = (float)sqrt(samples_per_sym / energy);
+    for (int i = 0; i < length; i++) {
+        taps[i] *= scale;
+    }
+    return 0;
+}
@@ -0,0 +1,20 @@
+#ifndef RRC_PULSE_H
+#define RRC_PULSE_H
+
+// Импульс "корень из приподнятого косинуса" (RRC) длиной span символов:
+// span * samples_per_sym + 1 отсчетов, центр - отсчет span * samples_per_sym / 2
+// (произведение должно быть четным). Энергия нормирована на samples_per_sym,
+// как у прямоугольного импульса единичной амплитуды, поэтому средняя
+// мощность сигнала на отсчет остается около 1, а согласованный фильтр с
+// делением на samples_per_sym возвращает символ в исходном масштабе.
+
+#define RRC_DEFAULT_ROLLOFF 0.35f
+#define RRC_DEFAULT_SPAN 8
+
+// Число отсчетов импульса или -1 при неверных параметрах
+int rrc_pulse_length(int samples_per_sym, int span, float rolloff);
+
+// Расчет отсчетов в taps (rrc_pulse_length значений); 0 или -1
+int rrc_pulse_design(float *taps, int samples_per_sym, int span, float rolloff);
+
+#endif // RRC_PULSE_H
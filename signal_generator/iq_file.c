@@ -0,0 +1,228 @@
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "iq_file.h"
+#include "../filters/fixed_point.h"
+
+static const char* iq_format_names[2] = {"cf32", "ci16"};
+
+static int iq_parse_format(const char* name, iq_format* format) {
+    for (int f = 0; f < 2; f++) {
+        if (strcmp(name, iq_format_names[f]) == 0) {
+            *format = (iq_format)f;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Путь файла параметров: <path>.hdr (NULL, если не помещается)
+static const char* iq_header_path(const char* path, char* buffer, size_t size) {
+    if (strlen(path) + strlen(IQ_HEADER_SUFFIX) + 1 > size) {
+        return NULL;
+    }
+    strcpy(buffer, path);
+    strcat(buffer, IQ_HEADER_SUFFIX);
+    return buffer;
+}
+
+int iq_info_read(const char* path, iq_info* info) {
+    memset(info, 0, sizeof(*info));
+    info->scale = IQ_CI16_SCALE;
+    char header[4096];
+    FILE* f = iq_header_path(path, header, sizeof(header)) ? fopen(header, "r") : NULL;
+    if (!f) {
+        // Без .hdr - формат по расширению
+        const char* ext = strrchr(path, '.');
+        return (ext && iq_parse_format(ext + 1, &info->format) == 0) ? 0 : -1;
+    }
+
+    int status = 0, has_format = 0;
+    char line[256], key[64], value[128];
+    while (status == 0 && fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || sscanf(line, "%63s %127s", key, value) != 2) {
+            continue;
+        }
+        if (strcmp(key, "format") == 0) {
+            status = iq_parse_format(value, &info->format) == 0 ? 0 : -2;
+            has_format = 1;
+        } else if (strcmp(key, "fs") == 0) {
+            info->fs = atof(value);
+        } else if (strcmp(key, "f_center") == 0) {
+            info->f_center = atof(value);
+        } else if (strcmp(key, "scale") == 0) {
+            info->scale = (float)atof(value);
+        }
+    }
+    fclose(f);
+    if (status == 0 && (!has_format || info->fs < 0.0 || !(info->scale > 0.0f))) {
+        status = -2;
+    }
+    return status;
+}
+
+int iq_info_write(const char* path, const iq_info* info) {
+    char header[4096];
+    FILE* f = iq_header_path(path, header, sizeof(header)) ? fopen(header, "w") : NULL;
+    if (!f) {
+        return -3;
+    }
+    fprintf(f, "format %s\nfs %.17g\nf_center %.17g\n", iq_format_names[info->format],
+            info->fs, info->f_center);
+    if (info->format == IQ_CI16) {
+        fprintf(f, "scale %.9g\n", info->scale);
+    }
+    int status = ferror(f) ? -4 : 0;
+    if (fclose(f) != 0) {
+        status = -4;
+    }
+    return status;
+}
+
+int iq_reader_open(iq_reader* reader, const char* path) {
+    memset(reader, 0, sizeof(*reader));
+    int status = iq_info_read(path, &reader->info);
+    if (status != 0) {
+        return status == -1 ? -2 : status;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t)st.st_size;
+    int sample_size = iq_sample_size(reader->info.format);
+    if (size % sample_size != 0) {
+        close(fd);
+        return -3;
+    }
+    // Пустой файл не отображается
+    void* map = NULL;
+    if (size > 0) {
+        map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            return -1;
+        }
+        madvise(map, size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    reader->map = map;
+    reader->size = size;
+    reader->samples = (long long)(size / sample_size);
+    return 0;
+}
+
+void iq_reader_close(iq_reader* reader) {
+    if (reader->map) {
+        munmap(reader->map, reader->size);
+    }
+    memset(reader, 0, sizeof(*reader));
+}
+
+// Возврат страниц до текущей позиции: отображение только для чтения,
+// поэтому при повторном обращении они снова прочитаются из файла
+static void iq_reader_release(iq_reader* reader) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t offset = (size_t)reader->position * iq_sample_size(reader->info.format);
+    size_t end = offset / page * page;
+    if (end >= reader->released + IQ_RELEASE_BYTES) {
+        madvise((unsigned char*)reader->map + reader->released, end - reader->released,
+                MADV_DONTNEED);
+        reader->released = end;
+    }
+}
+
+int iq_reader_read(iq_reader* reader, complex_float* out, int max) {
+    long long left = reader->samples - reader->position;
+    int n = (left < max) ? (int)left : max;
+    if (n <= 0) {
+        return 0;
+    }
+    const unsigned char* base = reader->map;
+    if (reader->info.format == IQ_CF32) {
+        memcpy(out, base + reader->position * sizeof(complex_float), n * sizeof(complex_float));
+    } else {
+        const int16_t* in = (const int16_t*)base + 2 * reader->position;
+        fixed_q15_to_float(in, (float*)out, 2 * n, reader->info.scale);
+    }
+    reader->position += n;
+    iq_reader_release(reader);
+    return n;
+}
+
+int iq_reader_seek(iq_reader* reader, long long position) {
+    if (position < 0 || position > reader->samples) {
+        return -1;
+    }
+    reader->position = position;
+    size_t offset = (size_t)position * iq_sample_size(reader->info.format);
+    if (offset < reader->released) {
+        reader->released = 0;
+    }
+    return 0;
+}
+
+int iq_writer_open(iq_writer* writer, const char* path, const iq_info* info) {
+    memset(writer, 0, sizeof(*writer));
+    if (!path || !info || (info->format != IQ_CF32 && info->format != IQ_CI16) ||
+        (info->format == IQ_CI16 && !(info->scale > 0.0f))) {
+        return -1;
+    }
+    writer->info = *info;
+    writer->buffer = malloc(IQ_WRITE_BUFFER);
+    if (!writer->buffer) {
+        return -2;
+    }
+    writer->file = fopen(path, "wb");
+    if (!writer->file || iq_info_write(path, info) != 0) {
+        if (writer->file) {
+            fclose(writer->file);
+        }
+        free(writer->buffer);
+        writer->file = NULL;
+        writer->buffer = NULL;
+        return -3;
+    }
+    setvbuf(writer->file, writer->buffer, _IOFBF, IQ_WRITE_BUFFER);
+    return 0;
+}
+
+int iq_writer_write(iq_writer* writer, const complex_float* in, int n) {
+    if (writer->info.format == IQ_CF32) {
+        if (fwrite(in, sizeof(complex_float), n, writer->file) != (size_t)n) {
+            return -4;
+        }
+    } else {
+        int16_t out[2 * IQ_CONVERT_CHUNK];
+        for (int offset = 0; offset < n; offset += IQ_CONVERT_CHUNK) {
+            int m = (n - offset < IQ_CONVERT_CHUNK) ? n - offset : IQ_CONVERT_CHUNK;
+            writer->saturated += fixed_float_to_q15((const float*)&in[offset], out, 2 * m,
+                                                    writer->info.scale, FIXED_ROUND_NEAREST);
+            if (fwrite(out, 2 * sizeof(int16_t), m, writer->file) != (size_t)m) {
+                return -4;
+            }
+        }
+    }
+    writer->samples += n;
+    return 0;
+}
+
+int iq_writer_close(iq_writer* writer) {
+    int status = 0;
+    if (writer->file && fclose(writer->file) != 0) {
+        status = -4;
+    }
+    free(writer->buffer);
+    writer->file = NULL;
+    writer->buffer = NULL;
+    return status;
+}
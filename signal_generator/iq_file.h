@@ -0,0 +1,90 @@
+#ifndef IQ_FILE_H
+#define IQ_FILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../filters/complex_float.h"
+
+// Файлы записей IQ без заголовка внутри: чередующиеся отсчеты (I, Q)
+// little-endian в формате cf32 (float32) или ci16 (int16, значение
+// q / 32768 / scale). Параметры записи лежат рядом в текстовом файле
+// <путь>.hdr, по строке "ключ значение":
+//   format cf32|ci16
+//   fs 5e9
+//   f_center 2.14e9
+//   scale 0.25        (только ci16)
+// Строки с # и неизвестные ключи пропускаются. Без .hdr формат берется по
+// расширению (.cf32, .ci16), а fs и f_center равны 0.
+//
+// Чтение идет из отображения файла в память блоками; длины и позиции
+// 64-битные, поэтому размер записи ограничен только адресным пространством.
+// Прочитанные страницы возвращаются системе каждые IQ_RELEASE_BYTES, так
+// что память процесса не растет с длиной записи. Запись буферизована.
+
+#define IQ_HEADER_SUFFIX ".hdr"
+#define IQ_RELEASE_BYTES (64 << 20)    // шаг возврата прочитанных страниц
+#define IQ_WRITE_BUFFER (4 << 20)      // буфер записи
+#define IQ_CONVERT_CHUNK 4096          // отсчетов за шаг преобразования ci16
+#define IQ_CI16_SCALE 0.25f            // scale по умолчанию: запас 12 дБ до насыщения
+
+typedef enum {
+    IQ_CF32 = 0,
+    IQ_CI16
+} iq_format;
+
+typedef struct {
+    iq_format format;
+    double fs;          // частота дискретизации, Гц
+    double f_center;    // центральная частота, Гц
+    float scale;        // ci16: q / 32768 = x * scale
+} iq_info;
+
+typedef struct {
+    iq_info info;
+    void* map;                  // отображение файла (только чтение)
+    size_t size;
+    long long samples;          // число комплексных отсчетов
+    long long position;         // следующий отсчет
+    size_t released;            // байт от начала, возвращенных системе
+} iq_reader;
+
+typedef struct {
+    iq_info info;
+    FILE* file;
+    char* buffer;
+    long long samples;          // записано отсчетов
+    long long saturated;        // насыщенных составляющих (ci16)
+} iq_writer;
+
+// Размер отсчета в файле, байт
+static inline int iq_sample_size(iq_format format) {
+    return format == IQ_CI16 ? 2 * (int)sizeof(int16_t) : 2 * (int)sizeof(float);
+}
+
+// Параметры из <path>.hdr или по расширению: 0 - успех; -1 - формат не
+// определен, -2 - ошибка в .hdr
+int iq_info_read(const char* path, iq_info* info);
+int iq_info_write(const char* path, const iq_info* info);
+
+// Открытие записи: 0 - успех; -1 - файл не открыт, -2 - формат (см.
+// iq_info_read), -3 - размер не кратен отсчету
+int iq_reader_open(iq_reader* reader, const char* path);
+void iq_reader_close(iq_reader* reader);
+
+// До max отсчетов с текущей позиции в out; возвращает число (0 - конец)
+int iq_reader_read(iq_reader* reader, complex_float* out, int max);
+
+// Переход к отсчету position (0 .. samples): 0 или -1
+int iq_reader_seek(iq_reader* reader, long long position);
+
+// Запись с параметрами info (пишется и .hdr): 0 - успех; -1 - неверные
+// параметры, -2 - нет памяти, -3 - файл не создан
+int iq_writer_open(iq_writer* writer, const char* path, const iq_info* info);
+
+// n отсчетов в конец записи: 0 или -4 при ошибке записи
+int iq_writer_write(iq_writer* writer, const complex_float* in, int n);
+
+// Сброс буфера и закрытие: 0 или -4
+int iq_writer_close(iq_writer* writer);
+
+#endif // IQ_FILE_H
@@ -0,0 +1,96 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include "rng.h"
+
+// Размер буфера равномерных чисел для блочного Бокса - Мюллера (в парах)
+#define RNG_NORMAL_CHUNK 128
+
+static uint64_t splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+void rng_init(rng_state* rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&seed);
+    }
+}
+
+void rng_jump(rng_state* rng) {
+    static const uint64_t jump[] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+    uint64_t s[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (jump[i] & (1ULL << b)) {
+                for (int k = 0; k < 4; k++) {
+                    s[k] ^= rng->s[k];
+                }
+            }
+            rng_next(rng);
+        }
+    }
+    for (int k = 0; k < 4; k++) {
+        rng->s[k] = s[k];
+    }
+}
+
+void rng_split(rng_state* parent, rng_state* child) {
+    *child = *parent;
+    rng_jump(parent);
+}
+
+void rng_bits(rng_state* rng, uint8_t* bits, int n) {
+    for (int i = 0; i < n; i += 64) {
+        uint64_t word = rng_next(rng);
+        int m = (n - i < 64) ? n - i : 64;
+        for (int b = 0; b < m; b++) {
+            bits[i + b] = (word >> b) & 1;
+        }
+    }
+}
+
+void rng_bits_packed(rng_state* rng, uint64_t* words, long long n) {
+    for (long long i = 0; i < n; i += 64) {
+        uint64_t word = rng_next(rng);
+        if (n - i < 64) {
+            word &= ((uint64_t)1 << (n - i)) - 1;
+        }
+        words[i / 64] = word;
+    }
+}
+
+void rng_normal_block(rng_state* rng, float* out, int n, float stddev) {
+    float u1[RNG_NORMAL_CHUNK], u2[RNG_NORMAL_CHUNK];
+
+    for (int i = 0; i < n; i += 2 * RNG_NORMAL_CHUNK) {
+        int pairs = (n - i + 1) / 2;
+        if (pairs > RNG_NORMAL_CHUNK) pairs = RNG_NORMAL_CHUNK;
+
+        // Одно 64-битное число на пару: старшие 32 бита - u1 из (0, 1],
+        // младшие 24 бита - u2 из [0, 1)
+        for (int k = 0; k < pairs; k++) {
+            uint64_t x = rng_next(rng);
+            u1[k] = ((float)(x >> 32) + 1.0f) * (1.0f / 4294967296.0f);
+            u2[k] = (float)(x & 0xffffff) * (1.0f / 16777216.0f);
+        }
+
+        float* dst = out + i;
+        int full = (n - i >= 2 * pairs) ? pairs : pairs - 1;
+        for (int k = 0; k < full; k++) {
+            float r = stddev * sqrtf(-2.0f * logf(u1[k]));
+            float angle = 2.0f * (float)M_PI * u2[k];
+            dst[2 * k] = r * cosf(angle);
+            dst[2 * k + 1] = r * sinf(angle);
+        }
+        // Нечетный хвост: вторая половина пары отбрасывается
+        if (full < pairs) {
+            dst[2 * full] = stddev * sqrtf(-2.0f * logf(u1[full])) *
+                            cosf(2.0f * (float)M_PI * u2[full]);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Генератор xoshiro256** (Blackman, Vigna): период 2^256 - 1, состояние
+// задается явно, поэтому генератор повторяем по seed и безопасен для потоков
+// (у каждого потока свое состояние). Независимые потоки получаются
+// rng_split: каждый следующий поток начинается на 2^128 шагов дальше
+// предыдущего, так что последовательности не пересекаются.
+typedef struct {
+    uint64_t s[4];
+} rng_state;
+
+// Инициализация по seed через splitmix64 (любой seed, включая 0, допустим)
+void rng_init(rng_state* rng, uint64_t seed);
+
+// Сдвиг на 2^128 шагов
+void rng_jump(rng_state* rng);
+
+// Отделение независимого потока: child получает текущую позицию,
+// parent сдвигается на 2^128 шагов
+void rng_split(rng_state* parent, rng_state* child);
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t rng_next(rng_state* rng) {
+    uint64_t* s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+// Равномерное распределение на [0, 1)
+static inline float rng_uniform(rng_state* rng) {
+    return (rng_next(rng) >> 40) * (1.0f / 16777216.0f);
+}
+
+// n равновероятных бит (0/1), по 64 бита на вызов генератора
+void rng_bits(rng_state* rng, uint8_t* bits, int n);
+
+// Те же n бит в упакованном виде (packed_bits.h): слово генератора
+// записывается целиком, в последнем слове лишние разряды обнуляются
+void rng_bits_packed(rng_state* rng, uint64_t* words, long long n);
+
+// n нормальных отсчетов N(0, stddev^2) блочным методом Бокса - Мюллера:
+// равномерные числа сначала набираются в буфер, затем преобразование идет
+// циклом без зависимостей между парами. Хвост обрезан на 6.66 stddev
+// (u1 >= 2^-32).
+void rng_normal_block(rng_state* rng, float* out, int n, float stddev);
+
+#endif // RNG_H
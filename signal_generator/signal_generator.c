@@ -2,48 +2,86 @@
 
 #include <stdlib.h>
 #include <math.h>
-#include <time.h>
 #include "signal_generator.h"
+#include "../filters/dsp_stats.h"
 
 
-uint8_t* generate_random_bits(int num_bits) {
+uint8_t* generate_random_bits(int num_bits, rng_state* rng) {
     uint8_t* bits = malloc(num_bits * sizeof(uint8_t));
     if (!bits) return NULL;
     
-    srand(time(NULL));
-    for (int i = 0; i < num_bits; i++) {
-        bits[i] = rand() % 2;
-    }
+    rng_bits(rng, bits, num_bits);
     return bits;
 }
 
+uint64_t* generate_random_bits_packed(long long num_bits, rng_state* rng) {
+    uint64_t* words = malloc(packed_words(num_bits) * sizeof(uint64_t));
+    if (!words) return NULL;
+    
+    rng_bits_packed(rng, words, num_bits);
+    return words;
+}
+
 void add_noise_and_interference(complex_float* signal, int length, float noise_power, 
                                float interference_freq, float interference_power, 
-                               float fs) {
+                               float fs, rng_state* rng) {
+    oscillator interference;
+    if (oscillator_init(&interference, interference_freq, fs) != 0) {
+        return;
+    }
+    add_noise_and_interference_block(signal, length, noise_power, interference_power,
+                                     &interference, rng);
+}
+
+// Гауссов шум на участке не длиннее SIGNAL_NOISE_CHUNK
+static void awgn_chunk(complex_float* x, int m, float noise_std, rng_state* rng) {
+    float noise[2 * SIGNAL_NOISE_CHUNK];
+    rng_normal_block(rng, noise, 2 * m, noise_std);
+    for (int i = 0; i < m; i++) {
+        x[i].real += noise[2 * i];
+        x[i].imag += noise[2 * i + 1];
+    }
+}
+
+void add_noise_and_interference_block(complex_float* signal, int length, float noise_power,
+                                      float interference_power, oscillator* interference,
+                                      rng_state* rng) {
+    DSP_STATS_BEGIN(probe);
     float noise_std = sqrtf(noise_power);
     float interf_std = sqrtf(interference_power);
-    float phase_inc = 2 * M_PI * interference_freq / fs;
-    float phase = 0.0f;
+    complex_float tone[SIGNAL_NOISE_CHUNK];
     
-    for (int i = 0; i < length; i++) {
+    for (int offset = 0; offset < length; offset += SIGNAL_NOISE_CHUNK) {
+        int m = (length - offset < SIGNAL_NOISE_CHUNK) ? length - offset : SIGNAL_NOISE_CHUNK;
+        complex_float* x = &signal[offset];
+        
         // Гауссов шум
-        float noise_real = 0;
-        float noise_imag = 0;
-        for (int j = 0; j < 12; j++) {
-            noise_real += (float)rand() / RAND_MAX - 0.5f;
-            noise_imag += (float)rand() / RAND_MAX - 0.5f;
-        }
-        noise_real *= noise_std;
-        noise_imag *= noise_std;
+        awgn_chunk(x, m, noise_std, rng);
         
         // Узкополосная помеха
-        float interf_real = cosf(phase) * interf_std;
-        float interf_imag = sinf(phase) * interf_std;
-        phase += phase_inc;
-        if (phase > 2 * M_PI) phase -= 2 * M_PI;
-        
-        // Добавляем шум и помеху к сигналу
-        signal[i].real += noise_real + interf_real;
-        signal[i].imag += noise_imag + interf_imag;
+        oscillator_generate(interference, tone, m);
+        for (int i = 0; i < m; i++) {
+            x[i].real += tone[i].real * interf_std;
+            x[i].imag += tone[i].imag * interf_std;
+        }
     }
-}
\ No newline at end of file
+    DSP_STATS_END(probe, DSP_STAGE_NOISE, length);
+}
+
+void add_awgn(complex_float* signal, int length, float noise_power, rng_state* rng) {
+    DSP_STATS_BEGIN(probe);
+    float noise_std = sqrtf(noise_power);
+    
+    for (int offset = 0; offset < length; offset += SIGNAL_NOISE_CHUNK) {
+        int m = (length - offset < SIGNAL_NOISE_CHUNK) ? length - offset : SIGNAL_NOISE_CHUNK;
+        awgn_chunk(&signal[offset], m, noise_std, rng);
+    }
+    DSP_STATS_END(probe, DSP_STAGE_NOISE, length);
+}
+
+float awgn_noise_power(float ebn0_db, float signal_power, int samples_per_sym,
+                       int bits_per_symbol) {
+    float eb = signal_power * samples_per_sym / bits_per_symbol;
+    float n0 = eb / powf(10.0f, ebn0_db / 10.0f);
+    return n0 / 2.0f;
+}
@@ -2,13 +2,37 @@
 #define SIGNAL_GENERATOR_H
 
 #include "../qpsk/qpsk_modem.h"
+#include "rng.h"
 
-// Генерация случайных битов
-uint8_t* generate_random_bits(int num_bits);
+// Шум формируется блоками по SIGNAL_NOISE_CHUNK комплексных отсчетов (буфер на стеке)
+#define SIGNAL_NOISE_CHUNK 256
 
-// Добавление шума и помех к сигналу
+// Генерация случайных битов из генератора rng (rng_init с нужным seed)
+uint8_t* generate_random_bits(int num_bits, rng_state* rng);
+
+// То же в упакованном виде: packed_words(num_bits) слов
+uint64_t* generate_random_bits_packed(long long num_bits, rng_state* rng);
+
+// Добавление шума и помех к сигналу. noise_power - дисперсия шума в каждой
+// из составляющих (I и Q)
 void add_noise_and_interference(complex_float* signal, int length, float noise_power, 
                                float interference_freq, float interference_power, 
-                               float fs);
+                               float fs, rng_state* rng);
+
+// То же для очередного блока потока: interference - генератор помехи
+// (oscillator_init с частотой помехи), его фаза продолжается между вызовами
+void add_noise_and_interference_block(complex_float* signal, int length, float noise_power,
+                                      float interference_power, oscillator* interference,
+                                      rng_state* rng);
+
+// Белый гауссов шум с дисперсией noise_power в каждой составляющей
+void add_awgn(complex_float* signal, int length, float noise_power, rng_state* rng);
+
+// Дисперсия шума на составляющую для заданного Eb/N0 (дБ): сигнал мощности
+// signal_power на отсчет, samples_per_sym отсчетов и bits_per_symbol бит на
+// символ. Es = signal_power * samples_per_sym, Eb = Es / bits_per_symbol,
+// дисперсия комплексного шума на отсчет равна N0, на составляющую - N0 / 2.
+float awgn_noise_power(float ebn0_db, float signal_power, int samples_per_sym,
+                       int bits_per_symbol);
 
-#endif // SIGNAL_GENERATOR_H
\ No newline at end of file
+#endif // SIGNAL_GENERATOR_H